@@ -56,6 +56,36 @@ extern "C"
 *     null
 *****************************************************************/
 uint32_t bsp_getClockCount(void);
+/*****************************************************************
+* FUNCTION: bsp_getCycleCount
+*
+* DESCRIPTION:
+*     Get cycle count, it provide high resolution time for ZMOS 
+*     statistics.
+* INPUTS:
+*     null
+* RETURNS:
+*     Cycle count.
+* NOTE:
+*     The count is free running and wraps around, the unit is 
+*     depends on the bsp.
+*****************************************************************/
+uint32_t bsp_getCycleCount(void);
+/*****************************************************************
+* FUNCTION: bsp_getUsCount
+*
+* DESCRIPTION:
+*     Get microsecond count, it provide the microsecond time for
+*     ZMOS(zmos_timeNowUs).
+* INPUTS:
+*     null
+* RETURNS:
+*     Microsecond count.
+* NOTE:
+*     The count is free running and wraps around at 32 bits. It
+*     is needed by ZMOS_USE_TIME_US only.
+*****************************************************************/
+uint32_t bsp_getUsCount(void);
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,91 @@
+/*****************************************************************
+* Copyright (C) 2026 zm. All rights reserved.                    *
+******************************************************************
+* bsp_thread.h
+*
+* DESCRIPTION:
+*     Bsp thread context switch.
+* AUTHOR:
+*     zm
+* CREATED DATE:
+*     2026/10/17
+* REVISION:
+*     v0.1
+*
+* MODIFICATION HISTORY
+* --------------------
+* $Log:$
+*
+*****************************************************************/
+#ifndef __BSP_THREAD_H__
+#define __BSP_THREAD_H__
+ 
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+/*************************************************************************************************************************
+ *                                                        MACROS                                                         *
+ *************************************************************************************************************************/
+ 
+/*************************************************************************************************************************
+ *                                                      CONSTANTS                                                        *
+ *************************************************************************************************************************/
+ 
+/*************************************************************************************************************************
+ *                                                       TYPEDEFS                                                        *
+ *************************************************************************************************************************/
+ 
+/*************************************************************************************************************************
+ *                                                   PUBLIC FUNCTIONS                                                    *
+ *************************************************************************************************************************/
+/*****************************************************************
+* FUNCTION: bsp_threadInit
+*
+* DESCRIPTION:
+*     This function to initialize the context switch, the caller
+*     becomes the lowest priority context.
+* INPUTS:
+*     null
+* RETURNS:
+*     null
+* NOTE:
+*     null
+*****************************************************************/
+void bsp_threadInit(void);
+/*****************************************************************
+* FUNCTION: bsp_threadStackInit
+*
+* DESCRIPTION:
+*     This function to build the first context of a thread.
+* INPUTS:
+*     stack : The stack of the thread.
+*     stackSize : The stack size in bytes.
+*     entry : The function the thread starts from.
+* RETURNS:
+*     The context(stack pointer) of the thread.
+* NOTE:
+*     null
+*****************************************************************/
+void *bsp_threadStackInit(void *stack, uint32_t stackSize, void (*entry)(void));
+/*****************************************************************
+* FUNCTION: bsp_threadSwitch
+*
+* DESCRIPTION:
+*     This function to request a context switch, the switch saves
+*     the current context and gets the next context by
+*     zmos_threadSwitchContext.
+* INPUTS:
+*     null
+* RETURNS:
+*     null
+* NOTE:
+*     It's called out of the critical, in the interrupt the
+*     switch is done after the interrupt return.
+*****************************************************************/
+void bsp_threadSwitch(void);
+
+#ifdef __cplusplus
+}
+#endif
+#endif /* bsp_thread.h */
@@ -27,7 +27,8 @@
 /*************************************************************************************************************************
  *                                                        MACROS                                                         *
  *************************************************************************************************************************/
- 
+/* The TC0 overflow is pending, the tick isn't updated */
+#define BSP_TC0_OVF_PENDING()       (TC0_REGS->COUNT32.TC_INTFLAG & TC_INTFLAG_OVF_Msk)
 /*************************************************************************************************************************
  *                                                      CONSTANTS                                                        *
  *************************************************************************************************************************/
@@ -39,7 +40,7 @@
 /*************************************************************************************************************************
  *                                                   GLOBAL VARIABLES                                                    *
  *************************************************************************************************************************/
-static uint32_t clockTick = 0;
+static volatile uint32_t clockTick = 0;
 /*************************************************************************************************************************
  *                                                  EXTERNAL VARIABLES                                                   *
  *************************************************************************************************************************/
@@ -160,6 +161,84 @@ uint32_t bsp_getClockCount(void)
     return clockTick;
 }
 /*****************************************************************
+* FUNCTION: bsp_getCycleCount
+*
+* DESCRIPTION:
+*     Get cycle count, it provide high resolution time for ZMOS 
+*     statistics.
+* INPUTS:
+*     null
+* RETURNS:
+*     Cycle count.
+* NOTE:
+*     Count of the TC0 clock. The overflow pending in the critical
+*     is counted.
+*****************************************************************/
+uint32_t bsp_getCycleCount(void)
+{
+    uint32_t ticks;
+    uint32_t count;
+    uint32_t pending;
+    
+    //Read again if the tick is updated while reading.
+    do
+    {
+        ticks = clockTick;
+        count = TC0_Timer32bitCounterGet();
+        pending = BSP_TC0_OVF_PENDING();
+        if(pending)
+        {
+            //The timer overflows, read the count after it.
+            count = TC0_Timer32bitCounterGet();
+        }
+    }while(ticks != clockTick);
+    if(pending)
+    {
+        ticks++;
+    }
+    
+    return ticks * (TC0_Timer32bitPeriodGet() + 1) + count;
+}
+/*****************************************************************
+* FUNCTION: bsp_getUsCount
+*
+* DESCRIPTION:
+*     Get microsecond count, it provide the microsecond time for
+*     ZMOS(zmos_timeNowUs).
+* INPUTS:
+*     null
+* RETURNS:
+*     Microsecond count.
+* NOTE:
+*     The tick(1 ms) and the count of the TC0. The overflow
+*     pending in the critical is counted.
+*****************************************************************/
+uint32_t bsp_getUsCount(void)
+{
+    uint32_t ticks;
+    uint32_t count;
+    uint32_t pending;
+    
+    //Read again if the tick is updated while reading.
+    do
+    {
+        ticks = clockTick;
+        count = TC0_Timer32bitCounterGet();
+        pending = BSP_TC0_OVF_PENDING();
+        if(pending)
+        {
+            //The timer overflows, read the count after it.
+            count = TC0_Timer32bitCounterGet();
+        }
+    }while(ticks != clockTick);
+    if(pending)
+    {
+        ticks++;
+    }
+    
+    return ticks * 1000 + count * 1000 / (TC0_Timer32bitPeriodGet() + 1);
+}
+/*****************************************************************
 * FUNCTION: bsp_compensateClockCount
 *
 * DESCRIPTION:
@@ -38,7 +38,7 @@
 /*************************************************************************************************************************
  *                                                   GLOBAL VARIABLES                                                    *
  *************************************************************************************************************************/
-static uint32_t clockTicks = 0;
+static volatile uint32_t clockTicks = 0;
 /*************************************************************************************************************************
  *                                                  EXTERNAL VARIABLES                                                   *
  *************************************************************************************************************************/
@@ -116,6 +116,84 @@ uint32_t bsp_getClockCount(void)
 {
     return clockTicks;
 }
+/*****************************************************************
+* FUNCTION: bsp_getCycleCount
+*
+* DESCRIPTION:
+*     Get cycle count, it provide high resolution time for ZMOS 
+*     statistics.
+* INPUTS:
+*     null
+* RETURNS:
+*     Cycle count.
+* NOTE:
+*     Count of the Timer_A0 clock(SMCLK/8). The overflow pending
+*     in the critical is counted.
+*****************************************************************/
+uint32_t bsp_getCycleCount(void)
+{
+    uint32_t ticks;
+    uint16_t count;
+    uint16_t pending;
+    
+    //Read again if the tick is updated while reading.
+    do
+    {
+        ticks = clockTicks;
+        count = TA0R;
+        pending = TA0CTL & TAIFG;
+        if(pending)
+        {
+            //The timer overflows, read the count after it.
+            count = TA0R;
+        }
+    }while(ticks != clockTicks);
+    if(pending)
+    {
+        ticks++;
+    }
+    
+    return ticks * ((uint32_t)TA0CCR0 + 1) + count;
+}
+/*****************************************************************
+* FUNCTION: bsp_getUsCount
+*
+* DESCRIPTION:
+*     Get microsecond count, it provide the microsecond time for
+*     ZMOS(zmos_timeNowUs).
+* INPUTS:
+*     null
+* RETURNS:
+*     Microsecond count.
+* NOTE:
+*     The tick(1 ms) and the count of the Timer_A0. The overflow
+*     pending in the critical is counted.
+*****************************************************************/
+uint32_t bsp_getUsCount(void)
+{
+    uint32_t ticks;
+    uint16_t count;
+    uint16_t pending;
+    
+    //Read again if the tick is updated while reading.
+    do
+    {
+        ticks = clockTicks;
+        count = TA0R;
+        pending = TA0CTL & TAIFG;
+        if(pending)
+        {
+            //The timer overflows, read the count after it.
+            count = TA0R;
+        }
+    }while(ticks != clockTicks);
+    if(pending)
+    {
+        ticks++;
+    }
+    
+    return ticks * 1000 + (uint32_t)count * 1000 / ((uint32_t)TA0CCR0 + 1);
+}
 
 
 //******************************************************************************
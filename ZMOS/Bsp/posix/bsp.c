@@ -0,0 +1,151 @@
+/*****************************************************************
+* Copyright (C) 2026 zm. All rights reserved.                    *
+******************************************************************
+* bsp.c
+*
+* DESCRIPTION:
+*     Bsp of the posix host(Linux), used to simulate ZMOS nodes.
+* AUTHOR:
+*     zm
+* CREATED DATE:
+*     2026/10/17
+* REVISION:
+*     v0.1
+*
+* MODIFICATION HISTORY
+* --------------------
+* $Log:$
+*
+*****************************************************************/
+ 
+/*************************************************************************************************************************
+ *                                                       INCLUDES                                                        *
+ *************************************************************************************************************************/
+#include <pthread.h>
+#include <stdlib.h>
+#include "ZMOS.h"
+#include "bsp.h"
+/*************************************************************************************************************************
+ *                                                        MACROS                                                         *
+ *************************************************************************************************************************/
+ 
+/*************************************************************************************************************************
+ *                                                      CONSTANTS                                                        *
+ *************************************************************************************************************************/
+ 
+/*************************************************************************************************************************
+ *                                                       TYPEDEFS                                                        *
+ *************************************************************************************************************************/
+/**
+ * Interrupt lock of a kernel, the threads set events to the kernel
+ * are the interrupts of it.
+ */
+typedef struct
+{
+    pthread_mutex_t lock;
+    pthread_t owner;
+    bool locked;
+}bspIntLock_t;
+/*************************************************************************************************************************
+ *                                                   GLOBAL VARIABLES                                                    *
+ *************************************************************************************************************************/
+ 
+/*************************************************************************************************************************
+ *                                                  EXTERNAL VARIABLES                                                   *
+ *************************************************************************************************************************/
+ 
+/*************************************************************************************************************************
+ *                                                    LOCAL VARIABLES                                                    *
+ *************************************************************************************************************************/
+ 
+/*************************************************************************************************************************
+ *                                                 FUNCTION DECLARATIONS                                                 *
+ *************************************************************************************************************************/
+ 
+/*************************************************************************************************************************
+ *                                                   PUBLIC FUNCTIONS                                                    *
+ *************************************************************************************************************************/
+ 
+/*************************************************************************************************************************
+ *                                                    LOCAL FUNCTIONS                                                    *
+ *************************************************************************************************************************/
+/*****************************************************************
+* FUNCTION: bsp_init
+*
+* DESCRIPTION:
+*     Bsp initiale.
+* INPUTS:
+*     null
+* RETURNS:
+*     null
+* NOTE:
+*     Create the interrupt lock of the selected kernel.
+*****************************************************************/
+void bsp_init(void)
+{
+    zmos_kernel_t *pKernel = zmos_getKernel();
+    
+    if(!pKernel->bspData)
+    {
+        bspIntLock_t *pLock = (bspIntLock_t *)calloc(1, sizeof(bspIntLock_t));
+        
+        if(pLock)
+        {
+            pthread_mutex_init(&pLock->lock, NULL);
+            pKernel->bspData = pLock;
+        }
+    }
+}
+/*****************************************************************
+* FUNCTION: bsp_mcuDisableInterrupt
+*
+* DESCRIPTION:
+*     Disable mcu interrupt.
+* INPUTS:
+*     null
+* RETURNS:
+*     null
+* NOTE:
+*     Lock the selected kernel, it's called again by the owner
+*     when the critical is nested.
+*****************************************************************/
+void bsp_mcuDisableInterrupt(void)
+{
+    bspIntLock_t *pLock = (bspIntLock_t *)zmos_getKernel()->bspData;
+    
+    if(pLock)
+    {
+        if(__atomic_load_n(&pLock->locked, __ATOMIC_ACQUIRE) && 
+           pthread_equal(pLock->owner, pthread_self()))
+        {
+            return;
+        }
+        pthread_mutex_lock(&pLock->lock);
+        pLock->owner = pthread_self();
+        __atomic_store_n(&pLock->locked, true, __ATOMIC_RELEASE);
+    }
+}
+/*****************************************************************
+* FUNCTION: bsp_mcuEnableInterrupt
+*
+* DESCRIPTION:
+*     Enable mcu interrupt.
+* INPUTS:
+*     null
+* RETURNS:
+*     null
+* NOTE:
+*     null
+*****************************************************************/
+void bsp_mcuEnableInterrupt(void)
+{
+    bspIntLock_t *pLock = (bspIntLock_t *)zmos_getKernel()->bspData;
+    
+    if(pLock && __atomic_load_n(&pLock->locked, __ATOMIC_ACQUIRE) && 
+       pthread_equal(pLock->owner, pthread_self()))
+    {
+        __atomic_store_n(&pLock->locked, false, __ATOMIC_RELEASE);
+        pthread_mutex_unlock(&pLock->lock);
+    }
+}
+/****************************************************** END OF FILE ******************************************************/
@@ -0,0 +1,120 @@
+/*****************************************************************
+* Copyright (C) 2026 zm. All rights reserved.                    *
+******************************************************************
+* bsp_clock.c
+*
+* DESCRIPTION:
+*     Provide clock tick for ZMOS.
+* AUTHOR:
+*     zm
+* CREATED DATE:
+*     2026/10/17
+* REVISION:
+*     v0.1
+*
+* MODIFICATION HISTORY
+* --------------------
+* $Log:$
+*
+*****************************************************************/
+ 
+/*************************************************************************************************************************
+ *                                                       INCLUDES                                                        *
+ *************************************************************************************************************************/
+#include <time.h>
+#include "bsp_clock.h"
+/*************************************************************************************************************************
+ *                                                        MACROS                                                         *
+ *************************************************************************************************************************/
+ 
+/*************************************************************************************************************************
+ *                                                      CONSTANTS                                                        *
+ *************************************************************************************************************************/
+ 
+/*************************************************************************************************************************
+ *                                                       TYPEDEFS                                                        *
+ *************************************************************************************************************************/
+ 
+/*************************************************************************************************************************
+ *                                                   GLOBAL VARIABLES                                                    *
+ *************************************************************************************************************************/
+ 
+/*************************************************************************************************************************
+ *                                                  EXTERNAL VARIABLES                                                   *
+ *************************************************************************************************************************/
+ 
+/*************************************************************************************************************************
+ *                                                    LOCAL VARIABLES                                                    *
+ *************************************************************************************************************************/
+ 
+/*************************************************************************************************************************
+ *                                                 FUNCTION DECLARATIONS                                                 *
+ *************************************************************************************************************************/
+ 
+/*************************************************************************************************************************
+ *                                                   PUBLIC FUNCTIONS                                                    *
+ *************************************************************************************************************************/
+ 
+/*************************************************************************************************************************
+ *                                                    LOCAL FUNCTIONS                                                    *
+ *************************************************************************************************************************/
+/*****************************************************************
+* FUNCTION: bsp_getClockCount
+*
+* DESCRIPTION:
+*     Get clock count, it provide system clock for ZMOS.
+* INPUTS:
+*     null
+* RETURNS:
+*     Clock count.
+* NOTE:
+*     Milliseconds of the monotonic clock.
+*****************************************************************/
+uint32_t bsp_getClockCount(void)
+{
+    struct timespec ts;
+    
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint32_t)((uint64_t)ts.tv_sec * 1000 + ts.tv_nsec / 1000000);
+}
+/*****************************************************************
+* FUNCTION: bsp_getCycleCount
+*
+* DESCRIPTION:
+*     Get cycle count, it provide high resolution time for ZMOS 
+*     statistics.
+* INPUTS:
+*     null
+* RETURNS:
+*     Cycle count.
+* NOTE:
+*     Nanoseconds of the monotonic clock.
+*****************************************************************/
+uint32_t bsp_getCycleCount(void)
+{
+    struct timespec ts;
+    
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint32_t)((uint64_t)ts.tv_sec * 1000000000 + ts.tv_nsec);
+}
+/*****************************************************************
+* FUNCTION: bsp_getUsCount
+*
+* DESCRIPTION:
+*     Get microsecond count, it provide the microsecond time for
+*     ZMOS(zmos_timeNowUs).
+* INPUTS:
+*     null
+* RETURNS:
+*     Microsecond count.
+* NOTE:
+*     Microseconds of the monotonic clock.
+*****************************************************************/
+uint32_t bsp_getUsCount(void)
+{
+    struct timespec ts;
+    
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint32_t)((uint64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000);
+}
+/****************************************************** END OF FILE ******************************************************/
@@ -0,0 +1,113 @@
+/*****************************************************************
+* Copyright (C) 2026 zm. All rights reserved.                    *
+******************************************************************
+* bsp_lpm.c
+*
+* DESCRIPTION:
+*     Low power management bsp.
+* AUTHOR:
+*     zm
+* CREATED DATE:
+*     2026/10/17
+* REVISION:
+*     v0.1
+*
+* MODIFICATION HISTORY
+* --------------------
+* $Log:$
+*
+*****************************************************************/
+ 
+/*************************************************************************************************************************
+ *                                                       INCLUDES                                                        *
+ *************************************************************************************************************************/
+#include <sched.h>
+#include "ZMOS_Types.h"
+#include "bsp_lpm.h"
+/*************************************************************************************************************************
+ *                                                        MACROS                                                         *
+ *************************************************************************************************************************/
+ 
+/*************************************************************************************************************************
+ *                                                      CONSTANTS                                                        *
+ *************************************************************************************************************************/
+ 
+/*************************************************************************************************************************
+ *                                                       TYPEDEFS                                                        *
+ *************************************************************************************************************************/
+ 
+/*************************************************************************************************************************
+ *                                                   GLOBAL VARIABLES                                                    *
+ *************************************************************************************************************************/
+ 
+/*************************************************************************************************************************
+ *                                                  EXTERNAL VARIABLES                                                   *
+ *************************************************************************************************************************/
+ 
+/*************************************************************************************************************************
+ *                                                    LOCAL VARIABLES                                                    *
+ *************************************************************************************************************************/
+ 
+/*************************************************************************************************************************
+ *                                                 FUNCTION DECLARATIONS                                                 *
+ *************************************************************************************************************************/
+ 
+/*************************************************************************************************************************
+ *                                                   PUBLIC FUNCTIONS                                                    *
+ *************************************************************************************************************************/
+ 
+/*************************************************************************************************************************
+ *                                                    LOCAL FUNCTIONS                                                    *
+ *************************************************************************************************************************/
+/*****************************************************************
+* FUNCTION: bsp_lowPwrEnterBefore
+*
+* DESCRIPTION:
+*     This function is called before entering low power.
+* INPUTS:
+*     timeout : zmos timer next timeout.
+*               A value of 0xFFFFFFFF indicates 
+*               that no timer is running.
+* RETURNS:
+*     null
+* NOTE:
+*     null
+*****************************************************************/
+void bsp_lowPwrEnterBefore(uint32_t timeout)
+{
+    
+}
+/*****************************************************************
+* FUNCTION: bsp_systemEnterLpm
+*
+* DESCRIPTION:
+*     This function put the cpu enter low power mode.
+* INPUTS:
+*     null
+* RETURNS:
+*     null
+* NOTE:
+*     The host has no low power mode, the thread gives way to the
+*     other nodes.
+*****************************************************************/
+void bsp_systemEnterLpm(void)
+{
+    sched_yield();
+}
+/*****************************************************************
+* FUNCTION: bsp_lowPwrExitAfter
+*
+* DESCRIPTION:
+*     This function is called after exiting low power.
+* INPUTS:
+*     null
+* RETURNS:
+*     null
+* NOTE:
+*     null
+*****************************************************************/
+void bsp_lowPwrExitAfter(void)
+{
+    
+}
+/****************************************************** END OF FILE ******************************************************/
@@ -0,0 +1,146 @@
+/*****************************************************************
+* Copyright (C) 2026 zm. All rights reserved.                    *
+******************************************************************
+* bsp_thread.c
+*
+* DESCRIPTION:
+*     Bsp thread context switch of the posix host, the threads are
+*     ucontext in the thread of the kernel.
+* AUTHOR:
+*     zm
+* CREATED DATE:
+*     2026/10/17
+* REVISION:
+*     v0.1
+*
+* MODIFICATION HISTORY
+* --------------------
+* $Log:$
+*
+*****************************************************************/
+ 
+/*************************************************************************************************************************
+ *                                                       INCLUDES                                                        *
+ *************************************************************************************************************************/
+#include <ucontext.h>
+#include "ZMOS.h"
+#include "bsp_thread.h"
+/*************************************************************************************************************************
+ *                                                        MACROS                                                         *
+ *************************************************************************************************************************/
+ 
+/*************************************************************************************************************************
+ *                                                      CONSTANTS                                                        *
+ *************************************************************************************************************************/
+ 
+/*************************************************************************************************************************
+ *                                                       TYPEDEFS                                                        *
+ *************************************************************************************************************************/
+ 
+/*************************************************************************************************************************
+ *                                                   GLOBAL VARIABLES                                                    *
+ *************************************************************************************************************************/
+ 
+/*************************************************************************************************************************
+ *                                                  EXTERNAL VARIABLES                                                   *
+ *************************************************************************************************************************/
+ 
+/*************************************************************************************************************************
+ *                                                    LOCAL VARIABLES                                                    *
+ *************************************************************************************************************************/
+/* Context of the main loop, one kernel with threads of each posix thread */
+static __thread ucontext_t bspThreadMain;
+static __thread ucontext_t *bspThreadCurrent;
+/* The posix thread runs the kernel, others are the interrupts */
+static __thread bool bspThreadOwner;
+/*************************************************************************************************************************
+ *                                                 FUNCTION DECLARATIONS                                                 *
+ *************************************************************************************************************************/
+ 
+/*************************************************************************************************************************
+ *                                                   PUBLIC FUNCTIONS                                                    *
+ *************************************************************************************************************************/
+ 
+/*************************************************************************************************************************
+ *                                                    LOCAL FUNCTIONS                                                    *
+ *************************************************************************************************************************/
+/*****************************************************************
+* FUNCTION: bsp_threadInit
+*
+* DESCRIPTION:
+*     This function to initialize the context switch, the caller
+*     becomes the lowest priority context.
+* INPUTS:
+*     null
+* RETURNS:
+*     null
+* NOTE:
+*     null
+*****************************************************************/
+void bsp_threadInit(void)
+{
+    bspThreadCurrent = &bspThreadMain;
+    bspThreadOwner = true;
+}
+/*****************************************************************
+* FUNCTION: bsp_threadStackInit
+*
+* DESCRIPTION:
+*     This function to build the first context of a thread.
+* INPUTS:
+*     stack : The stack of the thread.
+*     stackSize : The stack size in bytes.
+*     entry : The function the thread starts from.
+* RETURNS:
+*     The context(ucontext_t) of the thread.
+* NOTE:
+*     The ucontext_t is placed at the bottom of the stack.
+*****************************************************************/
+void *bsp_threadStackInit(void *stack, uint32_t stackSize, void (*entry)(void))
+{
+    ucontext_t *pContext = (ucontext_t *)(((zm_uintptr_t)stack + 15) & ~(zm_uintptr_t)15);
+    uint8_t *pStack = (uint8_t *)(pContext + 1);
+    uint32_t used = (uint32_t)(pStack - (uint8_t *)stack);
+    
+    if(stackSize <= used) return NULL;
+    
+    getcontext(pContext);
+    pContext->uc_stack.ss_sp = pStack;
+    pContext->uc_stack.ss_size = stackSize - used;
+    pContext->uc_link = NULL;
+    makecontext(pContext, entry, 0);
+    
+    return pContext;
+}
+/*****************************************************************
+* FUNCTION: bsp_threadSwitch
+*
+* DESCRIPTION:
+*     This function to switch to the highest ready context.
+* INPUTS:
+*     null
+* RETURNS:
+*     null
+* NOTE:
+*     The switch is synchronous in the kernel thread. Called by
+*     the others(interrupts) the switch is deferred to the main
+*     loop(zmos_threadProcess).
+*****************************************************************/
+void bsp_threadSwitch(void)
+{
+    ucontext_t *pPrev = bspThreadCurrent;
+    ucontext_t *pNext;
+    
+    if(!bspThreadOwner) return;
+    
+    ZMOS_ENTER_CRITICAL();
+    pNext = (ucontext_t *)zmos_threadSwitchContext(pPrev);
+    ZMOS_EXIT_CRITICAL();
+    
+    if(pNext && pNext != pPrev)
+    {
+        bspThreadCurrent = pNext;
+        swapcontext(pPrev, pNext);
+    }
+}
+/****************************************************** END OF FILE ******************************************************/
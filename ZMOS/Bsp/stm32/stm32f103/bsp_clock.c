@@ -74,4 +74,66 @@ uint32_t bsp_getClockCount(void)
 {
     return HAL_GetTick();
 }
+/*****************************************************************
+* FUNCTION: bsp_getCycleCount
+*
+* DESCRIPTION:
+*     Get cycle count, it provide high resolution time for ZMOS 
+*     statistics.
+* INPUTS:
+*     null
+* RETURNS:
+*     Cycle count.
+* NOTE:
+*     Count of the core clock by DWT.
+*****************************************************************/
+uint32_t bsp_getCycleCount(void)
+{
+    if(!(DWT->CTRL & DWT_CTRL_CYCCNTENA_Msk))
+    {
+        CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+        DWT->CYCCNT = 0;
+        DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+    }
+    return DWT->CYCCNT;
+}
+/*****************************************************************
+* FUNCTION: bsp_getUsCount
+*
+* DESCRIPTION:
+*     Get microsecond count, it provide the microsecond time for
+*     ZMOS(zmos_timeNowUs).
+* INPUTS:
+*     null
+* RETURNS:
+*     Microsecond count.
+* NOTE:
+*     The HAL tick(1 ms) and the count of the SysTick. The tick
+*     pending in the critical is counted.
+*****************************************************************/
+uint32_t bsp_getUsCount(void)
+{
+    uint32_t ticks;
+    uint32_t count;
+    uint32_t pending;
+    
+    //Read again if the tick is updated while reading.
+    do
+    {
+        ticks = HAL_GetTick();
+        count = SysTick->VAL;
+        pending = SCB->ICSR & SCB_ICSR_PENDSTSET_Msk;
+        if(pending)
+        {
+            //The SysTick wraps around, read the count after it.
+            count = SysTick->VAL;
+        }
+    }while(ticks != HAL_GetTick());
+    if(pending)
+    {
+        ticks++;
+    }
+    
+    return ticks * 1000 + (SysTick->LOAD - count) * 1000 / (SysTick->LOAD + 1);
+}
 /****************************************************** END OF FILE ******************************************************/
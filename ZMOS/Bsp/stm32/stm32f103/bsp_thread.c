@@ -0,0 +1,192 @@
+/*****************************************************************
+* Copyright (C) 2026 zm. All rights reserved.                    *
+******************************************************************
+* bsp_thread.c
+*
+* DESCRIPTION:
+*     Bsp thread context switch of the Cortex-M3/M4, the switch
+*     is done in the PendSV. The main loop runs on the MSP and the
+*     threads run on the PSP.
+* AUTHOR:
+*     zm
+* CREATED DATE:
+*     2026/10/17
+* REVISION:
+*     v0.1
+*
+* MODIFICATION HISTORY
+* --------------------
+* $Log:$
+*
+*****************************************************************/
+ 
+/*************************************************************************************************************************
+ *                                                       INCLUDES                                                        *
+ *************************************************************************************************************************/
+#include "stm32f1xx_hal.h"
+#include "ZMOS.h"
+#include "bsp_thread.h"
+/*************************************************************************************************************************
+ *                                                        MACROS                                                         *
+ *************************************************************************************************************************/
+#if !defined(__GNUC__)
+#error "The PendSV handler supports the GCC only!"
+#endif
+#if defined(__VFP_FP__) && !defined(__SOFTFP__)
+#define BSP_THREAD_USE_FPU          1
+#else
+#define BSP_THREAD_USE_FPU          0
+#endif
+/*************************************************************************************************************************
+ *                                                      CONSTANTS                                                        *
+ *************************************************************************************************************************/
+/* Return to the thread mode with the PSP */
+#define BSP_THREAD_EXC_RETURN       0xFFFFFFFDUL
+/* Thumb state */
+#define BSP_THREAD_XPSR             0x01000000UL
+/*************************************************************************************************************************
+ *                                                       TYPEDEFS                                                        *
+ *************************************************************************************************************************/
+ 
+/*************************************************************************************************************************
+ *                                                   GLOBAL VARIABLES                                                    *
+ *************************************************************************************************************************/
+ 
+/*************************************************************************************************************************
+ *                                                  EXTERNAL VARIABLES                                                   *
+ *************************************************************************************************************************/
+ 
+/*************************************************************************************************************************
+ *                                                    LOCAL VARIABLES                                                    *
+ *************************************************************************************************************************/
+ 
+/*************************************************************************************************************************
+ *                                                 FUNCTION DECLARATIONS                                                 *
+ *************************************************************************************************************************/
+void PendSV_Handler(void) __attribute__((naked));
+/*************************************************************************************************************************
+ *                                                   PUBLIC FUNCTIONS                                                    *
+ *************************************************************************************************************************/
+/*****************************************************************
+* FUNCTION: PendSV_Handler
+*
+* DESCRIPTION:
+*     Save the context to the stack of the current thread and
+*     restore the next from its stack.
+* INPUTS:
+*     null
+* RETURNS:
+*     null
+* NOTE:
+*     Remove the PendSV_Handler generated by the CubeMX. The
+*     context is {r3-r11, EXC_RETURN} and the s16-s31 of the FPU.
+*****************************************************************/
+void PendSV_Handler(void)
+{
+    __asm volatile
+    (
+        "    cpsid   i                          \n"
+        "    tst     lr, #4                     \n"
+        "    ite     eq                         \n"
+        "    mrseq   r0, msp                    \n"
+        "    mrsne   r0, psp                    \n"
+#if BSP_THREAD_USE_FPU
+        "    tst     lr, #0x10                  \n"
+        "    it      eq                         \n"
+        "    vstmdbeq r0!, {s16-s31}            \n"
+#endif
+        "    stmdb   r0!, {r3-r11, lr}          \n"
+        "    tst     lr, #4                     \n"
+        "    it      eq                         \n"
+        "    msreq   msp, r0                    \n"
+        "    bl      zmos_threadSwitchContext   \n"
+        "    ldmia   r0!, {r3-r11, lr}          \n"
+#if BSP_THREAD_USE_FPU
+        "    tst     lr, #0x10                  \n"
+        "    it      eq                         \n"
+        "    vldmiaeq r0!, {s16-s31}            \n"
+#endif
+        "    tst     lr, #4                     \n"
+        "    ite     eq                         \n"
+        "    msreq   msp, r0                    \n"
+        "    msrne   psp, r0                    \n"
+        "    cpsie   i                          \n"
+        "    bx      lr                         \n"
+    );
+}
+/*************************************************************************************************************************
+ *                                                    LOCAL FUNCTIONS                                                    *
+ *************************************************************************************************************************/
+/*****************************************************************
+* FUNCTION: bsp_threadInit
+*
+* DESCRIPTION:
+*     This function to initialize the context switch, the caller
+*     becomes the lowest priority context.
+* INPUTS:
+*     null
+* RETURNS:
+*     null
+* NOTE:
+*     The PendSV is the lowest priority, the switch is done after
+*     all interrupts return.
+*****************************************************************/
+void bsp_threadInit(void)
+{
+    NVIC_SetPriority(PendSV_IRQn, (1UL << __NVIC_PRIO_BITS) - 1UL);
+}
+/*****************************************************************
+* FUNCTION: bsp_threadStackInit
+*
+* DESCRIPTION:
+*     This function to build the first context of a thread.
+* INPUTS:
+*     stack : The stack of the thread.
+*     stackSize : The stack size in bytes.
+*     entry : The function the thread starts from.
+* RETURNS:
+*     The stack pointer of the thread.
+* NOTE:
+*     The stack is 8-byte aligned as the AAPCS.
+*****************************************************************/
+void *bsp_threadStackInit(void *stack, uint32_t stackSize, void (*entry)(void))
+{
+    uint32_t *pStack = (uint32_t *)(((uint32_t)stack + stackSize) & ~7UL);
+    
+    //Exception frame
+    *--pStack = BSP_THREAD_XPSR;
+    *--pStack = (uint32_t)entry & ~1UL;
+    //lr, r12, r3, r2, r1, r0
+    for(uint8_t i = 0; i < 6; i++)
+    {
+        *--pStack = 0;
+    }
+    //EXC_RETURN, r11 ~ r3
+    *--pStack = BSP_THREAD_EXC_RETURN;
+    for(uint8_t i = 0; i < 9; i++)
+    {
+        *--pStack = 0;
+    }
+    
+    return pStack;
+}
+/*****************************************************************
+* FUNCTION: bsp_threadSwitch
+*
+* DESCRIPTION:
+*     This function to request a context switch.
+* INPUTS:
+*     null
+* RETURNS:
+*     null
+* NOTE:
+*     Pend the PendSV, the switch is done at once out of the
+*     interrupts.
+*****************************************************************/
+void bsp_threadSwitch(void)
+{
+    SCB->ICSR = SCB_ICSR_PENDSVSET_Msk;
+    __DSB();
+    __ISB();
+}
+/****************************************************** END OF FILE ******************************************************/
@@ -48,8 +48,6 @@
 #if (defined ZMOS_INIT_SECTION) && (ZMOS_INIT_SECTION)
 ZMOS_INIT_SECTION_DEF(ZMOS_INIT_SECTION_NAME, zmos_funcInit);
 #endif
-/* ZMOS nesting variable */
-static uint16_t zmosCriticalNesting = 0xCCCC;
 /*************************************************************************************************************************
  *                                                  EXTERNAL VARIABLES                                                   *
  *************************************************************************************************************************/
@@ -65,6 +63,22 @@ extern void zmos_taskStartScheduler(void);
 #if ZMOS_USE_LOW_POWER
 extern void zmos_lowPowerManagement(void);
 #endif
+#if ZMOS_USE_ISR
+extern void zmos_isrProcess(void);
+#endif
+#if ZMOS_TRACE
+extern void zmos_traceInit(void);
+#endif
+#if ZMOS_USE_THREAD
+extern void zmos_threadInit(void);
+extern void zmos_threadProcess(void);
+#endif
+#if ZMOS_USE_CYCLIC
+extern void zmos_cyclicProcess(void);
+#endif
+#if ZMOS_USE_HRTIMER
+extern void zmos_hrtimerProcess(void);
+#endif
 /*************************************************************************************************************************
  *                                                   PUBLIC FUNCTIONS                                                    *
  *************************************************************************************************************************/
@@ -97,6 +111,10 @@ static void zmos_systemClockUpdate(void)
     {
         zmos_timeTickUpdate(clockCnt - zmos_clock);
     }
+#if ZMOS_USE_TIME_US
+    //Read the microsecond count before it wraps around.
+    zmos_timeNowUs();
+#endif
 }
 /*****************************************************************
 * FUNCTION: zmos_sysEnterCritical
@@ -114,7 +132,7 @@ void zmos_sysEnterCritical(void)
 {
     bsp_mcuDisableInterrupt();
     
-    zmosCriticalNesting++;
+    ZMOS_KERNEL->criticalNesting++;
 }
 /*****************************************************************
 * FUNCTION: zmos_sysExitCritical
@@ -126,11 +144,11 @@ void zmos_sysEnterCritical(void)
 * RETURNS:
 *     null
 * NOTE:
-*     null
+*     The interrupts are not enabled before the system initialize.
 *****************************************************************/
 void zmos_sysExitCritical(void)
 {
-    if(zmosCriticalNesting && --zmosCriticalNesting == 0)
+    if(ZMOS_KERNEL->criticalNesting && --ZMOS_KERNEL->criticalNesting == 0 && ZMOS_KERNEL->systemInit)
     {
         bsp_mcuEnableInterrupt();
     }
@@ -150,10 +168,25 @@ void zmos_sysExitCritical(void)
 void zmos_system_init(void)
 {
     //Initialize critical nesting
-    zmosCriticalNesting = 0;
+    ZMOS_KERNEL->criticalNesting = 0;
+    ZMOS_KERNEL->systemInit = 1;
+#if ZMOS_TASK_BUDGET
+    ZMOS_KERNEL->budgetDefault = ZMOS_TASK_BUDGET_DEFAULT;
+#endif
+#if ZMOS_USE_JOB
+    ZMOS_KERNEL->jobSlice = ZMOS_JOB_SLICE;
+#endif
     // Initialize bsp
     bsp_init();
     
+#if ZMOS_TRACE
+    // Initialize the trace buffer and start recording
+    zmos_traceInit();
+#endif
+#if ZMOS_USE_THREAD
+    // Initialize the threads, the tasks run in the main context
+    zmos_threadInit();
+#endif
 #if ZMOS_USE_MEM_MGR
     // Initialize zmos memory management.
     zmos_memoryMgrInit();
@@ -218,6 +251,22 @@ void zmos_system_start(void)
 void zmos_system_run(void)
 {
     zmos_systemClockUpdate();
+#if ZMOS_USE_ISR
+    //Pass the work posted by the interrupts
+    zmos_isrProcess();
+#endif
+#if ZMOS_USE_THREAD
+    //Run the threads made ready by the interrupts
+    zmos_threadProcess();
+#endif
+#if ZMOS_USE_CYCLIC
+    //Run the minor frame of the cyclic executive at its boundary
+    zmos_cyclicProcess();
+#endif
+#if ZMOS_USE_HRTIMER
+    //Run the high resolution timers due
+    zmos_hrtimerProcess();
+#endif
     //ZMOS start a task schedule
     zmos_taskStartScheduler();
     
@@ -227,4 +276,54 @@ void zmos_system_run(void)
 #endif
 }
 
+#if !defined(__GNUC__) && !defined(__CC_ARM) && !defined(__ICCARM__)
+/*****************************************************************
+* FUNCTION: zmos_clz32
+*
+* DESCRIPTION:
+*     Count leading zeros of a 32-bit value.
+* INPUTS:
+*     val : The value to count(must not be 0).
+* RETURNS:
+*     Number of leading zeros.
+* NOTE:
+*     Used by ZMOS_CLZ when the compiler has no intrinsic.
+*****************************************************************/
+unsigned char zmos_clz32(unsigned long val)
+{
+    unsigned char n = 0;
+
+    val &= 0xFFFFFFFFUL;
+    if(!(val & 0xFFFF0000UL)) { n += 16; val <<= 16; }
+    if(!(val & 0xFF000000UL)) { n += 8;  val <<= 8; }
+    if(!(val & 0xF0000000UL)) { n += 4;  val <<= 4; }
+    if(!(val & 0xC0000000UL)) { n += 2;  val <<= 2; }
+    if(!(val & 0x80000000UL)) { n += 1; }
+    return n;
+}
+/*****************************************************************
+* FUNCTION: zmos_ctz32
+*
+* DESCRIPTION:
+*     Count trailing zeros of a 32-bit value.
+* INPUTS:
+*     val : The value to count(must not be 0).
+* RETURNS:
+*     Number of trailing zeros.
+* NOTE:
+*     Used by ZMOS_CTZ when the compiler has no intrinsic.
+*****************************************************************/
+unsigned char zmos_ctz32(unsigned long val)
+{
+    unsigned char n = 0;
+
+    if(!(val & 0x0000FFFFUL)) { n += 16; val >>= 16; }
+    if(!(val & 0x000000FFUL)) { n += 8;  val >>= 8; }
+    if(!(val & 0x0000000FUL)) { n += 4;  val >>= 4; }
+    if(!(val & 0x00000003UL)) { n += 2;  val >>= 2; }
+    if(!(val & 0x00000001UL)) { n += 1; }
+    return n;
+}
+#endif
+
 /****************************************************** END OF FILE ******************************************************/
@@ -24,6 +24,7 @@
 #include "ZMOS_Tasks.h"
 #include "ZMOS_Timers.h"
 #include "ZMOS_Cbtimer.h"
+#include "ZMOS_Kernel.h"
 #include <string.h>
 
 #if ZMOS_USE_CBTIMERS_NUM > 0
@@ -31,6 +32,9 @@
 #if (ZMOS_USE_CBTIMERS_NUM > ZMOS_TASK_EVENT_NUM_MAX)
 #error "ZMOS_USE_CBTIMERS_NUM cannot exceed ZMOS_TASK_EVENT_NUM_MAX!"
 #endif
+#if ZMOS_USE_MSG && (ZMOS_USE_CBTIMERS_NUM >= ZMOS_TASK_EVENT_NUM_MAX)
+#error "The highest task event is reserved for messages, reduce ZMOS_USE_CBTIMERS_NUM!"
+#endif
 /*************************************************************************************************************************
  *                                                        MACROS                                                         *
  *************************************************************************************************************************/
@@ -42,21 +46,11 @@
 /*************************************************************************************************************************
  *                                                       TYPEDEFS                                                        *
  *************************************************************************************************************************/
-/**
- * Callback timer struct.
- */
-typedef struct
-{
-    cbTimerFunction timerFunc;
-    void *param;
-}zmos_cbTimer_t;
+ 
 /*************************************************************************************************************************
  *                                                   GLOBAL VARIABLES                                                    *
  *************************************************************************************************************************/
-/* Callback timer task handle */
-static zmos_taskHandle_t cbTimerTaskHandle;
-/* Callback timer table */
-static zmos_cbTimer_t cbTimers[ZMOS_USE_CBTIMERS_NUM];
+ 
 /*************************************************************************************************************************
  *                                                  EXTERNAL VARIABLES                                                   *
  *************************************************************************************************************************/
@@ -91,8 +85,8 @@ static timerReslt_t zmos_addCbTimer(cbTimerId_t *timerId, void *param, cbTimerFu
 *****************************************************************/
 void zmos_cbTimerInit(void)
 {
-    memset(cbTimers, 0, ZMOS_USE_CBTIMERS_NUM * sizeof(zmos_cbTimer_t));
-    zmos_taskThreadRegister(&cbTimerTaskHandle, zmos_cbTImerTaskProcess);
+    memset(ZMOS_KERNEL->cbTimers, 0, ZMOS_USE_CBTIMERS_NUM * sizeof(zmos_cbTimer_t));
+    zmos_taskThreadRegister(&ZMOS_KERNEL->cbTimerTaskHandle, zmos_cbTImerTaskProcess);
 }
 /*****************************************************************
 * FUNCTION: zmos_startSingleCbtimer
@@ -114,15 +108,15 @@ timerReslt_t zmos_startSingleCbtimer(cbTimerId_t *timerId, uint32_t timeout, voi
     cbTimerId_t cTimerId;
     if(zmos_addCbTimer(&cTimerId, param, cbfunc) == ZMOS_TIMER_SUCCESS)
     {
-        if(zmos_startSingleTimer(cbTimerTaskHandle, BS(cTimerId), timeout) == ZMOS_TIMER_SUCCESS)
+        if(zmos_timerStart(ZMOS_KERNEL->cbTimers[cTimerId].timer, timeout, 0) == ZMOS_TIMER_SUCCESS)
         {
             if(timerId) *timerId = cTimerId;
             return ZMOS_TIMER_SUCCESS;
         }
         else
         {
-            cbTimers[cTimerId].timerFunc = NULL;
-            cbTimers[cTimerId].param = NULL;
+            ZMOS_KERNEL->cbTimers[cTimerId].timerFunc = NULL;
+            ZMOS_KERNEL->cbTimers[cTimerId].param = NULL;
         }
     }
     return ZMOS_TIMER_FAILD;
@@ -147,15 +141,15 @@ timerReslt_t zmos_startReloadCbtimer(cbTimerId_t *timerId, uint32_t timeout, voi
     cbTimerId_t cTimerId;
     if(zmos_addCbTimer(&cTimerId, param, cbfunc) == ZMOS_TIMER_SUCCESS)
     {
-        if(zmos_startReloadTimer(cbTimerTaskHandle, BS(cTimerId), timeout) == ZMOS_TIMER_SUCCESS)
+        if(zmos_timerStart(ZMOS_KERNEL->cbTimers[cTimerId].timer, timeout, timeout) == ZMOS_TIMER_SUCCESS)
         {
             if(timerId) *timerId = cTimerId;
             return ZMOS_TIMER_SUCCESS;
         }
         else
         {
-            cbTimers[cTimerId].timerFunc = NULL;
-            cbTimers[cTimerId].param = NULL;
+            ZMOS_KERNEL->cbTimers[cTimerId].timerFunc = NULL;
+            ZMOS_KERNEL->cbTimers[cTimerId].param = NULL;
         }
     }
     return ZMOS_TIMER_FAILD;
@@ -177,13 +171,15 @@ timerReslt_t zmos_changeCbTimerTimeout(cbTimerId_t timerId, uint32_t timeout)
 {
     if(timerId < ZMOS_USE_CBTIMERS_NUM)
     {
-        if(cbTimers[timerId].timerFunc)
+        if(ZMOS_KERNEL->cbTimers[timerId].timerFunc)
         {
-            if(zmos_getReloadTimeout(cbTimerTaskHandle, BS(timerId)))
+            zmos_timerHandle_t hTimer = ZMOS_KERNEL->cbTimers[timerId].timer;
+            
+            if(zmos_timerGetReloadTime(hTimer))
             {
-                return zmos_startReloadTimer(cbTimerTaskHandle, BS(timerId), timeout);
+                return zmos_timerStart(hTimer, timeout, timeout);
             }
-            else return zmos_startSingleTimer(cbTimerTaskHandle, BS(timerId), timeout);
+            else return zmos_timerStart(hTimer, timeout, 0);
         }
     }
     return ZMOS_TIMER_FAILD;
@@ -204,11 +200,11 @@ timerReslt_t zmos_stopCbtimer(cbTimerId_t timerId)
 {
     if(timerId < ZMOS_USE_CBTIMERS_NUM)
     {
-        if(cbTimers[timerId].timerFunc)
+        if(ZMOS_KERNEL->cbTimers[timerId].timerFunc)
         {
-            cbTimers[timerId].timerFunc = NULL;
-            cbTimers[timerId].param = NULL;
-            return zmos_stopTimer(cbTimerTaskHandle, BS(timerId));
+            ZMOS_KERNEL->cbTimers[timerId].timerFunc = NULL;
+            ZMOS_KERNEL->cbTimers[timerId].param = NULL;
+            return zmos_timerStop(ZMOS_KERNEL->cbTimers[timerId].timer);
         }
     }
     return ZMOS_TIMER_FAILD;
@@ -233,15 +229,15 @@ static uTaskEvent_t zmos_cbTImerTaskProcess(uTaskEvent_t event)
         {
             if(event & BS(i))
             {
-                if(cbTimers[i].timerFunc)
+                if(ZMOS_KERNEL->cbTimers[i].timerFunc)
                 {
-                    cbTimers[i].timerFunc(cbTimers[i].param);
+                    ZMOS_KERNEL->cbTimers[i].timerFunc(ZMOS_KERNEL->cbTimers[i].param);
                 }
                 // Check if reload timer.
-                if(zmos_getReloadTimeout(cbTimerTaskHandle, BS(i)) == 0)
+                if(zmos_timerGetReloadTime(ZMOS_KERNEL->cbTimers[i].timer) == 0)
                 {
-                    cbTimers[i].timerFunc = NULL;
-                    cbTimers[i].param = NULL;
+                    ZMOS_KERNEL->cbTimers[i].timerFunc = NULL;
+                    ZMOS_KERNEL->cbTimers[i].param = NULL;
                 }
                 event ^= BS(i);
             }
@@ -262,7 +258,8 @@ static uTaskEvent_t zmos_cbTImerTaskProcess(uTaskEvent_t event)
 * RETURNS:
 *     0 : success (ZMOS_TIMER_SUCCESS).
 * NOTE:
-*     null
+*     The timer handle of the id is created at the first use and
+*     kept.
 *****************************************************************/
 static timerReslt_t zmos_addCbTimer(cbTimerId_t *timerId, void *param, cbTimerFunction cbfunc)
 {
@@ -270,10 +267,15 @@ static timerReslt_t zmos_addCbTimer(cbTimerId_t *timerId, void *param, cbTimerFu
     
     for(cbTimerId_t i = 0; i < ZMOS_USE_CBTIMERS_NUM; i++)
     {
-        if(cbTimers[i].timerFunc == NULL)
+        if(ZMOS_KERNEL->cbTimers[i].timerFunc == NULL)
         {
-            cbTimers[i].timerFunc = cbfunc;
-            cbTimers[i].param = param;
+            if(ZMOS_KERNEL->cbTimers[i].timer == NULL)
+            {
+                ZMOS_KERNEL->cbTimers[i].timer = zmos_timerCreate(ZMOS_KERNEL->cbTimerTaskHandle, BS(i));
+                if(ZMOS_KERNEL->cbTimers[i].timer == NULL) return ZMOS_TIMER_FAILD;
+            }
+            ZMOS_KERNEL->cbTimers[i].timerFunc = cbfunc;
+            ZMOS_KERNEL->cbTimers[i].param = param;
             
             if(timerId)
             {
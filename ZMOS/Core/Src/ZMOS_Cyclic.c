@@ -0,0 +1,258 @@
+/*****************************************************************
+* Copyright (C) 2026 zm. All rights reserved.                    *
+******************************************************************
+* ZMOS_Cyclic.c
+*
+* DESCRIPTION:
+*     ZMOS time-triggered cyclic executive.
+* AUTHOR:
+*     zm
+* CREATED DATE:
+*     2026/10/17
+* REVISION:
+*     v0.1
+*
+* MODIFICATION HISTORY
+* --------------------
+* $Log:$
+*
+*****************************************************************/
+ 
+/*************************************************************************************************************************
+ *                                                       INCLUDES                                                        *
+ *************************************************************************************************************************/
+#include "ZMOS_Common.h"
+#include "ZMOS_Cyclic.h"
+#include "ZMOS.h"
+#include "bsp_clock.h"
+#include <string.h>
+
+#if ZMOS_USE_CYCLIC
+/*************************************************************************************************************************
+ *                                                        MACROS                                                         *
+ *************************************************************************************************************************/
+ 
+/*************************************************************************************************************************
+ *                                                      CONSTANTS                                                        *
+ *************************************************************************************************************************/
+ 
+/*************************************************************************************************************************
+ *                                                       TYPEDEFS                                                        *
+ *************************************************************************************************************************/
+ 
+/*************************************************************************************************************************
+ *                                                   GLOBAL VARIABLES                                                    *
+ *************************************************************************************************************************/
+ 
+/*************************************************************************************************************************
+ *                                                  EXTERNAL VARIABLES                                                   *
+ *************************************************************************************************************************/
+ 
+/*************************************************************************************************************************
+ *                                                    LOCAL VARIABLES                                                    *
+ *************************************************************************************************************************/
+ 
+/*************************************************************************************************************************
+ *                                                 FUNCTION DECLARATIONS                                                 *
+ *************************************************************************************************************************/
+extern void zmos_taskRunNow(zmos_taskHandle_t pTaskHandle, uTaskEvent_t events);
+/*************************************************************************************************************************
+ *                                                   PUBLIC FUNCTIONS                                                    *
+ *************************************************************************************************************************/
+/*****************************************************************
+* FUNCTION: zmos_cyclicStart
+*
+* DESCRIPTION:
+*     This function to start the cyclic executive with the schedule table.
+* INPUTS:
+*     pTable : The schedule table, it must be kept until stopped.
+* RETURNS:
+*     0 : Success (ZMOS_TASK_SUCCESS).
+*     other : ref ZMOS task return cordes.
+* NOTE:
+*     The first minor frame starts at once, the frames are aligned
+*     to the timer clock(zmos_getTimerClock). Starting again
+*     replaces the table and resets the statistics.
+*****************************************************************/
+taskReslt_t zmos_cyclicStart(const zmos_cyclicTable_t *pTable)
+{
+    if(!pTable || !pTable->frames || !pTable->frameNum || !pTable->minorFrame)
+    {
+        return ZMOS_TASK_ERROR_PARAM;
+    }
+    
+    ZMOS_ENTER_CRITICAL();
+    ZMOS_KERNEL->cyclicTable = pTable;
+    ZMOS_KERNEL->cyclicFrame = 0;
+    ZMOS_KERNEL->cyclicBoundary = zmos_getTimerClock();
+    memset(&ZMOS_KERNEL->cyclicStats, 0, sizeof(zmos_cyclicStats_t));
+    ZMOS_EXIT_CRITICAL();
+    
+    return ZMOS_TASK_SUCCESS;
+}
+/*****************************************************************
+* FUNCTION: zmos_cyclicStop
+*
+* DESCRIPTION:
+*     This function to stop the cyclic executive.
+* INPUTS:
+*     null
+* RETURNS:
+*     null
+* NOTE:
+*     null
+*****************************************************************/
+void zmos_cyclicStop(void)
+{
+    ZMOS_ENTER_CRITICAL();
+    ZMOS_KERNEL->cyclicTable = NULL;
+    ZMOS_EXIT_CRITICAL();
+}
+/*****************************************************************
+* FUNCTION: zmos_cyclicGetStats
+*
+* DESCRIPTION:
+*     This function to get the statistics of the cyclic executive.
+* INPUTS:
+*     pStats : Return the statistics.
+* RETURNS:
+*     0 : Success (ZMOS_TASK_SUCCESS).
+*     other : ref ZMOS task return cordes.
+* NOTE:
+*     null
+*****************************************************************/
+taskReslt_t zmos_cyclicGetStats(zmos_cyclicStats_t *pStats)
+{
+    if(!pStats) return ZMOS_TASK_ERROR_PARAM;
+    
+    ZMOS_ENTER_CRITICAL();
+    *pStats = ZMOS_KERNEL->cyclicStats;
+    ZMOS_EXIT_CRITICAL();
+    
+    return ZMOS_TASK_SUCCESS;
+}
+/*****************************************************************
+* FUNCTION: zmos_cyclicResetStats
+*
+* DESCRIPTION:
+*     This function to reset the statistics of the cyclic executive.
+* INPUTS:
+*     null
+* RETURNS:
+*     null
+* NOTE:
+*     null
+*****************************************************************/
+void zmos_cyclicResetStats(void)
+{
+    ZMOS_ENTER_CRITICAL();
+    memset(&ZMOS_KERNEL->cyclicStats, 0, sizeof(zmos_cyclicStats_t));
+    ZMOS_EXIT_CRITICAL();
+}
+/*****************************************************************
+* FUNCTION: zmos_cyclicProcess
+*
+* DESCRIPTION:
+*     This function to run the minor frame when its boundary is reached.
+* INPUTS:
+*     null
+* RETURNS:
+*     null
+* NOTE:
+*     Called by the main loop before the event tasks, so the event
+*     tasks run in the slack of the frames. The frames missed by an
+*     overrun are skipped to keep the alignment.
+*****************************************************************/
+void zmos_cyclicProcess(void)
+{
+    const zmos_cyclicTable_t *pTable;
+    const zmos_cyclicFrame_t *pFrame;
+    zmos_cyclicStats_t *pStats = &ZMOS_KERNEL->cyclicStats;
+    uint32_t late;
+    uint32_t skip;
+    uint32_t runTime;
+    uint16_t frame;
+    
+    ZMOS_ENTER_CRITICAL();
+    pTable = ZMOS_KERNEL->cyclicTable;
+    late = zmos_getTimerClock() - ZMOS_KERNEL->cyclicBoundary;
+    if(!pTable || (int32_t)late < 0)
+    {
+        ZMOS_EXIT_CRITICAL();
+        return;
+    }
+    skip = late / pTable->minorFrame;
+    late %= pTable->minorFrame;
+    frame = (uint16_t)((ZMOS_KERNEL->cyclicFrame + skip) % pTable->frameNum);
+    ZMOS_KERNEL->cyclicFrame = (frame + 1 == pTable->frameNum) ? 0 : frame + 1;
+    ZMOS_KERNEL->cyclicBoundary += (skip + 1) * pTable->minorFrame;
+    pStats->skipCount += skip;
+    ZMOS_U32_MAX_HOLD(pStats->frameCount);
+    if(late > pStats->maxJitter)
+    {
+        pStats->maxJitter = late;
+    }
+    ZMOS_EXIT_CRITICAL();
+    
+    pFrame = &pTable->frames[frame];
+    runTime = bsp_getCycleCount();
+    for(uint8_t i = 0; i < pFrame->slotNum; i++)
+    {
+        zmos_taskRunNow(*pFrame->slots[i].pTaskHandle, pFrame->slots[i].event);
+    }
+    runTime = bsp_getCycleCount() - runTime;
+    
+    ZMOS_ENTER_CRITICAL();
+    //The table may have been changed by the slots.
+    if(ZMOS_KERNEL->cyclicTable == pTable)
+    {
+        if(runTime > pStats->maxFrameTime)
+        {
+            pStats->maxFrameTime = runTime;
+        }
+        if((int32_t)(bsp_getClockCount() - ZMOS_KERNEL->cyclicBoundary) > 0)
+        {
+            ZMOS_U32_MAX_HOLD(pStats->overrunCount);
+        }
+        if(frame + 1 == pTable->frameNum)
+        {
+            ZMOS_U32_MAX_HOLD(pStats->majorCount);
+        }
+    }
+    ZMOS_EXIT_CRITICAL();
+}
+/*****************************************************************
+* FUNCTION: zmos_cyclicNextTimeout
+*
+* DESCRIPTION:
+*     This function to get the time to the next frame boundary.
+* INPUTS:
+*     null
+* RETURNS:
+*     The time to the next boundary.
+*     TIMER_MAX_TIMEOUT : The cyclic executive is stopped.
+* NOTE:
+*     Used to wake up from the low power at the boundary.
+*****************************************************************/
+uint32_t zmos_cyclicNextTimeout(void)
+{
+    uint32_t timeout;
+    
+    if(!ZMOS_KERNEL->cyclicTable) return TIMER_MAX_TIMEOUT;
+    
+    timeout = ZMOS_KERNEL->cyclicBoundary - zmos_getTimerClock();
+    
+    return ((int32_t)timeout < 0) ? 0 : timeout;
+}
+/*************************************************************************************************************************
+ *                                                    LOCAL FUNCTIONS                                                    *
+ *************************************************************************************************************************/
+ 
+
+#else
+taskReslt_t zmos_cyclicStart(const zmos_cyclicTable_t *pTable) {return ZMOS_TASK_FAILD;}
+void zmos_cyclicStop(void) {}
+taskReslt_t zmos_cyclicGetStats(zmos_cyclicStats_t *pStats) {return ZMOS_TASK_FAILD;}
+void zmos_cyclicResetStats(void) {}
+#endif
+/****************************************************** END OF FILE ******************************************************/
@@ -0,0 +1,274 @@
+/*****************************************************************
+* Copyright (C) 2026 zm. All rights reserved.                    *
+******************************************************************
+* ZMOS_Hrtimer.c
+*
+* DESCRIPTION:
+*     ZMOS high resolution timers.
+* AUTHOR:
+*     zm
+* CREATED DATE:
+*     2026/10/17
+* REVISION:
+*     v0.1
+*
+* MODIFICATION HISTORY
+* --------------------
+* $Log:$
+*
+*****************************************************************/
+ 
+/*************************************************************************************************************************
+ *                                                       INCLUDES                                                        *
+ *************************************************************************************************************************/
+#include "ZMOS_Common.h"
+#include "ZMOS_Hrtimer.h"
+#include "ZMOS.h"
+
+#if ZMOS_USE_HRTIMER
+
+#if !ZMOS_USE_TIME_US
+#error "ZMOS_USE_HRTIMER needs ZMOS_USE_TIME_US!"
+#endif
+/*************************************************************************************************************************
+ *                                                        MACROS                                                         *
+ *************************************************************************************************************************/
+ 
+/*************************************************************************************************************************
+ *                                                      CONSTANTS                                                        *
+ *************************************************************************************************************************/
+ 
+/*************************************************************************************************************************
+ *                                                       TYPEDEFS                                                        *
+ *************************************************************************************************************************/
+ 
+/*************************************************************************************************************************
+ *                                                   GLOBAL VARIABLES                                                    *
+ *************************************************************************************************************************/
+ 
+/*************************************************************************************************************************
+ *                                                  EXTERNAL VARIABLES                                                   *
+ *************************************************************************************************************************/
+ 
+/*************************************************************************************************************************
+ *                                                    LOCAL VARIABLES                                                    *
+ *************************************************************************************************************************/
+ 
+/*************************************************************************************************************************
+ *                                                 FUNCTION DECLARATIONS                                                 *
+ *************************************************************************************************************************/
+static void zmos_hrtimerInsert(zmos_hrtimer_t *pTimer);
+static bool zmos_hrtimerRemove(zmos_hrtimer_t *pTimer);
+/*************************************************************************************************************************
+ *                                                   PUBLIC FUNCTIONS                                                    *
+ *************************************************************************************************************************/
+/*****************************************************************
+* FUNCTION: zmos_hrtimerStart
+*
+* DESCRIPTION:
+*     This function to start a high resolution timer.
+* INPUTS:
+*     pTimer : The timer, it must be kept until stopped or expired.
+*     timeoutUs : The timeout in microseconds.
+*     periodUs : The period in microseconds, 0 is single.
+*     func : The timer function.
+*     param : Param to be passed in to the timer function.
+* RETURNS:
+*     0 : success (ZMOS_TIMER_SUCCESS).
+* NOTE:
+*     The running timer is restarted.
+*****************************************************************/
+timerReslt_t zmos_hrtimerStart(zmos_hrtimer_t *pTimer, uint32_t timeoutUs, uint32_t periodUs,
+                               zmosHrtimerFunc_t func, void *param)
+{
+    if(!pTimer || !func) return ZMOS_TIMER_FAILD;
+    
+    ZMOS_ENTER_CRITICAL();
+    zmos_hrtimerRemove(pTimer);
+    pTimer->func = func;
+    pTimer->param = param;
+    pTimer->deadline = zmos_timeNowUs() + timeoutUs;
+    pTimer->period = periodUs;
+    pTimer->overrunCount = 0;
+    pTimer->maxLateness = 0;
+    zmos_hrtimerInsert(pTimer);
+    ZMOS_EXIT_CRITICAL();
+    
+    return ZMOS_TIMER_SUCCESS;
+}
+/*****************************************************************
+* FUNCTION: zmos_hrtimerStop
+*
+* DESCRIPTION:
+*     This function to stop a high resolution timer.
+* INPUTS:
+*     pTimer : The timer.
+* RETURNS:
+*     0 : success (ZMOS_TIMER_SUCCESS).
+*     other : The timer isn't running.
+* NOTE:
+*     null
+*****************************************************************/
+timerReslt_t zmos_hrtimerStop(zmos_hrtimer_t *pTimer)
+{
+    bool found;
+    
+    if(!pTimer) return ZMOS_TIMER_FAILD;
+    
+    ZMOS_ENTER_CRITICAL();
+    found = zmos_hrtimerRemove(pTimer);
+    ZMOS_EXIT_CRITICAL();
+    
+    return found ? ZMOS_TIMER_SUCCESS : ZMOS_TIMER_FAILD;
+}
+/*****************************************************************
+* FUNCTION: zmos_hrtimerProcess
+*
+* DESCRIPTION:
+*     This function to run the high resolution timers due.
+* INPUTS:
+*     null
+* RETURNS:
+*     null
+* NOTE:
+*     Called by the main loop(zmos_system_run). Only the timers
+*     due at the entry run, a periodic timer runs once in a call
+*     even if its function takes longer than the period. The
+*     periodic timer is put back before its function is called.
+*****************************************************************/
+void zmos_hrtimerProcess(void)
+{
+    zmos_hrtimer_t *pTimer;
+    zmosHrtimerFunc_t func;
+    void *param;
+    uint64_t now;
+    uint64_t late;
+    uint64_t missed;
+    
+    now = zmos_timeNowUs();
+    while(1)
+    {
+        ZMOS_ENTER_CRITICAL();
+        pTimer = ZMOS_KERNEL->hrtimerHead;
+        if(!pTimer || pTimer->deadline > now)
+        {
+            ZMOS_EXIT_CRITICAL();
+            break;
+        }
+        ZMOS_KERNEL->hrtimerHead = pTimer->next;
+        pTimer->next = NULL;
+        late = now - pTimer->deadline;
+        if(late > pTimer->maxLateness)
+        {
+            pTimer->maxLateness = (late > 0xFFFFFFFF) ? 0xFFFFFFFF : (uint32_t)late;
+        }
+        func = pTimer->func;
+        param = pTimer->param;
+        if(pTimer->period)
+        {
+            pTimer->deadline += pTimer->period;
+            if(pTimer->deadline <= now)
+            {
+                //Skip to the first deadline after now.
+                missed = (now - pTimer->deadline) / pTimer->period + 1;
+                pTimer->deadline += missed * pTimer->period;
+                missed += pTimer->overrunCount;
+                pTimer->overrunCount = (missed > 0xFFFFFFFF) ? 0xFFFFFFFF : (uint32_t)missed;
+            }
+            zmos_hrtimerInsert(pTimer);
+        }
+        ZMOS_EXIT_CRITICAL();
+    
+        func(param);
+    }
+}
+/*****************************************************************
+* FUNCTION: zmos_hrtimerNextTimeout
+*
+* DESCRIPTION:
+*     Get the time to the next high resolution timer.
+* INPUTS:
+*     null
+* RETURNS:
+*     The time in timer clock(ms), rounded down.
+*     TIMER_MAX_TIMEOUT : No timer.
+* NOTE:
+*     The timer in less than 1 ms returns 0, the system doesn't
+*     sleep and polls it. Called in critical.
+*****************************************************************/
+uint32_t zmos_hrtimerNextTimeout(void)
+{
+    uint64_t now;
+    uint64_t timeout;
+    
+    if(!ZMOS_KERNEL->hrtimerHead) return TIMER_MAX_TIMEOUT;
+    
+    now = zmos_timeNowUs();
+    if(ZMOS_KERNEL->hrtimerHead->deadline <= now) return 0;
+    
+    timeout = (ZMOS_KERNEL->hrtimerHead->deadline - now) / 1000;
+    return (timeout >= TIMER_MAX_TIMEOUT) ? TIMER_MAX_TIMEOUT - 1 : (uint32_t)timeout;
+}
+/*************************************************************************************************************************
+ *                                                    LOCAL FUNCTIONS                                                    *
+ *************************************************************************************************************************/
+/*****************************************************************
+* FUNCTION: zmos_hrtimerInsert
+*
+* DESCRIPTION:
+*     Insert a timer to the list by the deadline.
+* INPUTS:
+*     pTimer : The timer.
+* RETURNS:
+*     null
+* NOTE:
+*     The timers of the same deadline keep the start order. Called
+*     in critical.
+*****************************************************************/
+static void zmos_hrtimerInsert(zmos_hrtimer_t *pTimer)
+{
+    zmos_hrtimer_t **ppTimer = &ZMOS_KERNEL->hrtimerHead;
+    
+    while(*ppTimer && (*ppTimer)->deadline <= pTimer->deadline)
+    {
+        ppTimer = &(*ppTimer)->next;
+    }
+    pTimer->next = *ppTimer;
+    *ppTimer = pTimer;
+}
+/*****************************************************************
+* FUNCTION: zmos_hrtimerRemove
+*
+* DESCRIPTION:
+*     Remove a timer from the list.
+* INPUTS:
+*     pTimer : The timer.
+* RETURNS:
+*     true : The timer is removed.
+*     false : The timer isn't in the list.
+* NOTE:
+*     Called in critical.
+*****************************************************************/
+static bool zmos_hrtimerRemove(zmos_hrtimer_t *pTimer)
+{
+    zmos_hrtimer_t **ppTimer = &ZMOS_KERNEL->hrtimerHead;
+    
+    while(*ppTimer)
+    {
+        if(*ppTimer == pTimer)
+        {
+            *ppTimer = pTimer->next;
+            pTimer->next = NULL;
+            return true;
+        }
+        ppTimer = &(*ppTimer)->next;
+    }
+    return false;
+}
+
+#else
+timerReslt_t zmos_hrtimerStart(zmos_hrtimer_t *pTimer, uint32_t timeoutUs, uint32_t periodUs,
+                               zmosHrtimerFunc_t func, void *param) {return ZMOS_TIMER_FAILD;}
+timerReslt_t zmos_hrtimerStop(zmos_hrtimer_t *pTimer) {return ZMOS_TIMER_FAILD;}
+#endif
+/****************************************************** END OF FILE ******************************************************/
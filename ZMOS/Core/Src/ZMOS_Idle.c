@@ -0,0 +1,207 @@
+/*****************************************************************
+* Copyright (C) 2026 zm. All rights reserved.                    *
+******************************************************************
+* ZMOS_Idle.c
+*
+* DESCRIPTION:
+*     ZMOS idle hooks.
+* AUTHOR:
+*     zm
+* CREATED DATE:
+*     2026/10/17
+* REVISION:
+*     v0.1
+*
+* MODIFICATION HISTORY
+* --------------------
+* $Log:$
+*
+*****************************************************************/
+ 
+/*************************************************************************************************************************
+ *                                                       INCLUDES                                                        *
+ *************************************************************************************************************************/
+#include "ZMOS_Common.h"
+#include "ZMOS_Idle.h"
+#include "ZMOS.h"
+#include "bsp_clock.h"
+
+#if ZMOS_USE_IDLE_HOOK
+/*************************************************************************************************************************
+ *                                                        MACROS                                                         *
+ *************************************************************************************************************************/
+ 
+/*************************************************************************************************************************
+ *                                                      CONSTANTS                                                        *
+ *************************************************************************************************************************/
+ 
+/*************************************************************************************************************************
+ *                                                       TYPEDEFS                                                        *
+ *************************************************************************************************************************/
+ 
+/*************************************************************************************************************************
+ *                                                   GLOBAL VARIABLES                                                    *
+ *************************************************************************************************************************/
+ 
+/*************************************************************************************************************************
+ *                                                  EXTERNAL VARIABLES                                                   *
+ *************************************************************************************************************************/
+ 
+/*************************************************************************************************************************
+ *                                                    LOCAL VARIABLES                                                    *
+ *************************************************************************************************************************/
+ 
+/*************************************************************************************************************************
+ *                                                 FUNCTION DECLARATIONS                                                 *
+ *************************************************************************************************************************/
+extern uint32_t zmos_getNextWakeupTimeout(void);
+/*************************************************************************************************************************
+ *                                                   PUBLIC FUNCTIONS                                                    *
+ *************************************************************************************************************************/
+/*****************************************************************
+* FUNCTION: zmos_idleHookRegister
+*
+* DESCRIPTION:
+*     This function to register an idle hook.
+* INPUTS:
+*     pHook : The idle hook, it must be kept until unregistered.
+*     func : The hook function.
+*     priority : The higher priority hook runs first.
+*     maxTime : The max run time in timer clock(ms).
+* RETURNS:
+*     0 : Success (ZMOS_TASK_SUCCESS).
+*     other : ref ZMOS task return cordes.
+* NOTE:
+*     The hook runs in the idle path only when the time to the
+*     next timer is more than maxTime. Return ZMOS_TASK_FAILD
+*     when the hook is registered already.
+*****************************************************************/
+taskReslt_t zmos_idleHookRegister(zmos_idleHook_t *pHook, zmosIdleHookFunc_t func, uint8_t priority, uint32_t maxTime)
+{
+    zmos_idleHook_t **ppHook = &ZMOS_KERNEL->idleHookHead;
+    
+    if(!pHook || !func) return ZMOS_TASK_ERROR_PARAM;
+    
+    ZMOS_ENTER_CRITICAL();
+    while(*ppHook)
+    {
+        if(*ppHook == pHook)
+        {
+            ZMOS_EXIT_CRITICAL();
+            return ZMOS_TASK_FAILD;
+        }
+        ppHook = &(*ppHook)->next;
+    }
+    pHook->func = func;
+    pHook->priority = priority;
+    pHook->maxTime = maxTime;
+    pHook->runCount = 0;
+    pHook->skipCount = 0;
+    pHook->overrunCount = 0;
+    //Insert after the hooks of the same or higher priority.
+    ppHook = &ZMOS_KERNEL->idleHookHead;
+    while(*ppHook && (*ppHook)->priority >= priority)
+    {
+        ppHook = &(*ppHook)->next;
+    }
+    pHook->next = *ppHook;
+    *ppHook = pHook;
+    ZMOS_EXIT_CRITICAL();
+    
+    return ZMOS_TASK_SUCCESS;
+}
+/*****************************************************************
+* FUNCTION: zmos_idleHookUnregister
+*
+* DESCRIPTION:
+*     This function to unregister an idle hook.
+* INPUTS:
+*     pHook : The idle hook.
+* RETURNS:
+*     0 : Success (ZMOS_TASK_SUCCESS).
+*     other : ref ZMOS task return cordes.
+* NOTE:
+*     null
+*****************************************************************/
+taskReslt_t zmos_idleHookUnregister(zmos_idleHook_t *pHook)
+{
+    zmos_idleHook_t **ppHook = &ZMOS_KERNEL->idleHookHead;
+    
+    if(!pHook) return ZMOS_TASK_ERROR_PARAM;
+    
+    ZMOS_ENTER_CRITICAL();
+    while(*ppHook)
+    {
+        if(*ppHook == pHook)
+        {
+            *ppHook = pHook->next;
+            pHook->next = NULL;
+            ZMOS_EXIT_CRITICAL();
+            return ZMOS_TASK_SUCCESS;
+        }
+        ppHook = &(*ppHook)->next;
+    }
+    ZMOS_EXIT_CRITICAL();
+    
+    return ZMOS_TASK_FAILD;
+}
+/*****************************************************************
+* FUNCTION: zmos_idleHookProcess
+*
+* DESCRIPTION:
+*     This function to run the idle hooks by priority.
+* INPUTS:
+*     null
+* RETURNS:
+*     null
+* NOTE:
+*     Called by the scheduler when no task is ready. A hook is
+*     skipped when the next timer is not later than its maxTime,
+*     the pass ends when a task is ready.
+*****************************************************************/
+void zmos_idleHookProcess(void)
+{
+    zmos_idleHook_t *pHook = ZMOS_KERNEL->idleHookHead;
+    zmos_idleHook_t *pNext;
+    uint32_t slack;
+    uint32_t elapsed;
+    
+    while(pHook && !zmos_checkTaskIsIdle())
+    {
+        pNext = pHook->next;
+    
+        ZMOS_ENTER_CRITICAL();
+        slack = zmos_getNextWakeupTimeout();
+        ZMOS_EXIT_CRITICAL();
+        //The clock runs since the timers were updated.
+        elapsed = bsp_getClockCount() - zmos_getTimerClock();
+        slack = (slack > elapsed) ? slack - elapsed : 0;
+    
+        if(slack > pHook->maxTime)
+        {
+            elapsed = bsp_getClockCount();
+            pHook->func();
+            elapsed = bsp_getClockCount() - elapsed;
+            ZMOS_U32_MAX_HOLD(pHook->runCount);
+            if(elapsed > pHook->maxTime)
+            {
+                ZMOS_U32_MAX_HOLD(pHook->overrunCount);
+            }
+        }
+        else
+        {
+            ZMOS_U32_MAX_HOLD(pHook->skipCount);
+        }
+        pHook = pNext;
+    }
+}
+/*************************************************************************************************************************
+ *                                                    LOCAL FUNCTIONS                                                    *
+ *************************************************************************************************************************/
+ 
+
+#else
+taskReslt_t zmos_idleHookRegister(zmos_idleHook_t *pHook, zmosIdleHookFunc_t func, uint8_t priority, uint32_t maxTime) {return ZMOS_TASK_FAILD;}
+taskReslt_t zmos_idleHookUnregister(zmos_idleHook_t *pHook) {return ZMOS_TASK_FAILD;}
+#endif
+/****************************************************** END OF FILE ******************************************************/
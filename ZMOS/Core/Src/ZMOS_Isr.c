@@ -0,0 +1,409 @@
+/*****************************************************************
+* Copyright (C) 2026 zm. All rights reserved.                    *
+******************************************************************
+* ZMOS_Isr.c
+*
+* DESCRIPTION:
+*     ZMOS interrupt event posting and deferred call.
+* AUTHOR:
+*     zm
+* CREATED DATE:
+*     2026/10/17
+* REVISION:
+*     v0.1
+*
+* MODIFICATION HISTORY
+* --------------------
+* $Log:$
+*
+*****************************************************************/
+ 
+/*************************************************************************************************************************
+ *                                                       INCLUDES                                                        *
+ *************************************************************************************************************************/
+#include "ZMOS_Common.h"
+#include "ZMOS_Tasks.h"
+#include "ZMOS_Isr.h"
+#include "ZMOS.h"
+
+#if ZMOS_USE_ISR
+/*************************************************************************************************************************
+ *                                                        MACROS                                                         *
+ *************************************************************************************************************************/
+/* The atomics of the task events are lock-free, not the library calls */
+#if (ZMOS_TASK_EVENT_NUM_MAX <= 8)
+#define ZMOS_ISR_EVENT_LOCK_FREE    (__GCC_ATOMIC_CHAR_LOCK_FREE == 2)
+#elif (ZMOS_TASK_EVENT_NUM_MAX <= 16)
+#define ZMOS_ISR_EVENT_LOCK_FREE    (__GCC_ATOMIC_SHORT_LOCK_FREE == 2)
+#elif (__SIZEOF_INT__ == 4)
+#define ZMOS_ISR_EVENT_LOCK_FREE    (__GCC_ATOMIC_INT_LOCK_FREE == 2)
+#else
+#define ZMOS_ISR_EVENT_LOCK_FREE    (__GCC_ATOMIC_LONG_LOCK_FREE == 2)
+#endif
+
+#if ZMOS_ISR_USE_ATOMIC && defined(__GNUC__) && defined(__ATOMIC_ACQ_REL) && ZMOS_ISR_EVENT_LOCK_FREE \
+    && (__GCC_ATOMIC_SHORT_LOCK_FREE == 2) && (__GCC_ATOMIC_POINTER_LOCK_FREE == 2)
+#define ZMOS_ISR_ATOMIC             1
+#else
+#define ZMOS_ISR_ATOMIC             0
+#endif
+
+#if ZMOS_ISR_DEFER_RING_SIZE > 0
+#if (ZMOS_ISR_DEFER_RING_SIZE & (ZMOS_ISR_DEFER_RING_SIZE - 1)) || (ZMOS_ISR_DEFER_RING_SIZE > 0x8000)
+#error "ZMOS_ISR_DEFER_RING_SIZE must be power of 2!"
+#endif
+#define ZMOS_ISR_DEFER_RING_MASK    (ZMOS_ISR_DEFER_RING_SIZE - 1)
+#endif
+/*************************************************************************************************************************
+ *                                                      CONSTANTS                                                        *
+ *************************************************************************************************************************/
+ 
+/*************************************************************************************************************************
+ *                                                       TYPEDEFS                                                        *
+ *************************************************************************************************************************/
+ 
+/*************************************************************************************************************************
+ *                                                   GLOBAL VARIABLES                                                    *
+ *************************************************************************************************************************/
+ 
+/*************************************************************************************************************************
+ *                                                  EXTERNAL VARIABLES                                                   *
+ *************************************************************************************************************************/
+ 
+/*************************************************************************************************************************
+ *                                                    LOCAL VARIABLES                                                    *
+ *************************************************************************************************************************/
+ 
+/*************************************************************************************************************************
+ *                                                 FUNCTION DECLARATIONS                                                 *
+ *************************************************************************************************************************/
+static uTaskEvent_t zmos_isrEventOr(zmos_taskHandle_t pTask, uTaskEvent_t events);
+static uTaskEvent_t zmos_isrEventTake(zmos_taskHandle_t pTask);
+static void zmos_isrTaskPush(zmos_taskHandle_t pTask);
+static zmos_taskHandle_t zmos_isrTaskTakeAll(void);
+#if ZMOS_ISR_DEFER_RING_SIZE > 0
+static uint16_t zmos_isrIndexLoad(uint16_t *pIndex);
+static void zmos_isrIndexStore(uint16_t *pIndex, uint16_t value);
+#endif
+/*************************************************************************************************************************
+ *                                                   PUBLIC FUNCTIONS                                                    *
+ *************************************************************************************************************************/
+/*****************************************************************
+* FUNCTION: zmos_setTaskEventFromISR
+*
+* DESCRIPTION:
+*     This function to set task event in the interrupt.
+* INPUTS:
+*     pTaskHandle : The handle of the task to set event.
+*     events : what event to set.
+* RETURNS:
+*     0 : Success (ZMOS_TASK_SUCCESS).
+*     other : ref ZMOS task return cordes.
+* NOTE:
+*     The interrupts are not disabled, the events are passed to
+*     the task by the next schedule. The task posted by the 
+*     interrupt shouldn't be unregistered.
+*****************************************************************/
+taskReslt_t zmos_setTaskEventFromISR(zmos_taskHandle_t pTaskHandle, uTaskEvent_t events)
+{
+    if(pTaskHandle && events)
+    {
+        //Only the first post pushes the task, the others just merge events.
+        if(!zmos_isrEventOr(pTaskHandle, events))
+        {
+            zmos_isrTaskPush(pTaskHandle);
+        }
+        return ZMOS_TASK_SUCCESS;
+    }
+    return ZMOS_TASK_ERROR_PARAM;
+}
+/*****************************************************************
+* FUNCTION: zmos_deferCallFromISR
+*
+* DESCRIPTION:
+*     This function to defer a function call from the interrupt to
+*     the task context.
+* INPUTS:
+*     func : The function to call.
+*     arg : The param of the function.
+* RETURNS:
+*     0 : Success (ZMOS_TASK_SUCCESS).
+*     other : ref ZMOS task return cordes.
+* NOTE:
+*     Single producer, only one interrupt(or the interrupts of the
+*     same priority) can call it.
+*****************************************************************/
+taskReslt_t zmos_deferCallFromISR(zmosDeferFunc_t func, void *arg)
+{
+#if ZMOS_ISR_DEFER_RING_SIZE > 0
+    uint16_t head = ZMOS_KERNEL->deferHead;
+    
+    if(!func)
+    {
+        return ZMOS_TASK_ERROR_PARAM;
+    }
+    //Ring is full.
+    if((uint16_t)(head - zmos_isrIndexLoad(&ZMOS_KERNEL->deferTail)) >= ZMOS_ISR_DEFER_RING_SIZE)
+    {
+        return ZMOS_TASK_FAILD;
+    }
+    ZMOS_KERNEL->deferRing[head & ZMOS_ISR_DEFER_RING_MASK].func = func;
+    ZMOS_KERNEL->deferRing[head & ZMOS_ISR_DEFER_RING_MASK].arg = arg;
+    //Publish the call after it is written.
+    zmos_isrIndexStore(&ZMOS_KERNEL->deferHead, head + 1);
+    return ZMOS_TASK_SUCCESS;
+#else
+    return ZMOS_TASK_FAILD;
+#endif
+}
+/*****************************************************************
+* FUNCTION: zmos_isrProcess
+*
+* DESCRIPTION:
+*     Pass the events posted by the interrupts to the tasks, and run
+*     the deferred calls.
+* INPUTS:
+*     null
+* RETURNS:
+*     null
+* NOTE:
+*     Called by the system loop, shouldn't be called from anywhere else.
+*****************************************************************/
+void zmos_isrProcess(void)
+{
+    zmos_taskHandle_t pTask = zmos_isrTaskTakeAll();
+    zmos_taskHandle_t pNext;
+    zmos_taskHandle_t pPrev = NULL;
+    
+    //The stack is LIFO, reverse it to keep the post order.
+    while(pTask)
+    {
+        pNext = pTask->isrNext;
+        pTask->isrNext = pPrev;
+        pPrev = pTask;
+        pTask = pNext;
+    }
+    
+    pTask = pPrev;
+    while(pTask)
+    {
+        //Get next before the events are taken, the task may be pushed again after that.
+        pNext = pTask->isrNext;
+        zmos_setTaskEvent(pTask, zmos_isrEventTake(pTask));
+        pTask = pNext;
+    }
+    
+#if ZMOS_ISR_DEFER_RING_SIZE > 0
+    {
+        //Only the calls deferred before now, so a busy interrupt can't hold the scheduler.
+        uint16_t head = zmos_isrIndexLoad(&ZMOS_KERNEL->deferHead);
+        uint16_t tail = ZMOS_KERNEL->deferTail;
+        
+        while(tail != head)
+        {
+            zmosDeferFunc_t func = ZMOS_KERNEL->deferRing[tail & ZMOS_ISR_DEFER_RING_MASK].func;
+            void *arg = ZMOS_KERNEL->deferRing[tail & ZMOS_ISR_DEFER_RING_MASK].arg;
+            
+            //Free the slot before the call.
+            zmos_isrIndexStore(&ZMOS_KERNEL->deferTail, ++tail);
+            func(arg);
+        }
+    }
+#endif
+}
+/*****************************************************************
+* FUNCTION: zmos_isrCheckPending
+*
+* DESCRIPTION:
+*     This function to check whether the interrupts posted work.
+* INPUTS:
+*     null
+* RETURNS:
+*     0 : No work.
+*     1 : Work is pending.
+* NOTE:
+*     null
+*****************************************************************/
+uint8_t zmos_isrCheckPending(void)
+{
+#if ZMOS_ISR_DEFER_RING_SIZE > 0
+    if(zmos_isrIndexLoad(&ZMOS_KERNEL->deferHead) != ZMOS_KERNEL->deferTail)
+    {
+        return 1;
+    }
+#endif
+#if ZMOS_ISR_ATOMIC
+    return __atomic_load_n(&ZMOS_KERNEL->isrTaskStack, __ATOMIC_ACQUIRE) ? 1 : 0;
+#else
+    return *(zmos_taskHandle_t volatile *)&ZMOS_KERNEL->isrTaskStack ? 1 : 0;
+#endif
+}
+/*************************************************************************************************************************
+ *                                                    LOCAL FUNCTIONS                                                    *
+ *************************************************************************************************************************/
+/*****************************************************************
+* FUNCTION: zmos_isrEventOr
+*
+* DESCRIPTION:
+*     Merge the events to the interrupt events of the task.
+* INPUTS:
+*     pTask : The task.
+*     events : The events to merge.
+* RETURNS:
+*     The interrupt events before merged.
+* NOTE:
+*     null
+*****************************************************************/
+static uTaskEvent_t zmos_isrEventOr(zmos_taskHandle_t pTask, uTaskEvent_t events)
+{
+#if ZMOS_ISR_ATOMIC
+    return __atomic_fetch_or(&pTask->isrEvent, events, __ATOMIC_ACQ_REL);
+#else
+    uTaskEvent_t oldEvents;
+    
+    ZMOS_ENTER_CRITICAL();
+    oldEvents = pTask->isrEvent;
+    pTask->isrEvent |= events;
+    ZMOS_EXIT_CRITICAL();
+    return oldEvents;
+#endif
+}
+/*****************************************************************
+* FUNCTION: zmos_isrEventTake
+*
+* DESCRIPTION:
+*     Take and clear the interrupt events of the task.
+* INPUTS:
+*     pTask : The task.
+* RETURNS:
+*     The interrupt events.
+* NOTE:
+*     null
+*****************************************************************/
+static uTaskEvent_t zmos_isrEventTake(zmos_taskHandle_t pTask)
+{
+#if ZMOS_ISR_ATOMIC
+    return __atomic_exchange_n(&pTask->isrEvent, 0, __ATOMIC_ACQ_REL);
+#else
+    uTaskEvent_t events;
+    
+    ZMOS_ENTER_CRITICAL();
+    events = pTask->isrEvent;
+    pTask->isrEvent = 0;
+    ZMOS_EXIT_CRITICAL();
+    return events;
+#endif
+}
+/*****************************************************************
+* FUNCTION: zmos_isrTaskPush
+*
+* DESCRIPTION:
+*     Push the task to the interrupt task stack.
+* INPUTS:
+*     pTask : The task.
+* RETURNS:
+*     null
+* NOTE:
+*     Lock-free, the interrupts may be nested.
+*****************************************************************/
+static void zmos_isrTaskPush(zmos_taskHandle_t pTask)
+{
+#if ZMOS_ISR_ATOMIC
+    zmos_taskHandle_t pHead = __atomic_load_n(&ZMOS_KERNEL->isrTaskStack, __ATOMIC_RELAXED);
+    
+    do
+    {
+        pTask->isrNext = pHead;
+    }while(!__atomic_compare_exchange_n(&ZMOS_KERNEL->isrTaskStack, &pHead, pTask, true, 
+                                        __ATOMIC_RELEASE, __ATOMIC_RELAXED));
+#else
+    ZMOS_ENTER_CRITICAL();
+    pTask->isrNext = ZMOS_KERNEL->isrTaskStack;
+    ZMOS_KERNEL->isrTaskStack = pTask;
+    ZMOS_EXIT_CRITICAL();
+#endif
+}
+/*****************************************************************
+* FUNCTION: zmos_isrTaskTakeAll
+*
+* DESCRIPTION:
+*     Take all tasks from the interrupt task stack.
+* INPUTS:
+*     null
+* RETURNS:
+*     The top of the stack.
+* NOTE:
+*     null
+*****************************************************************/
+static zmos_taskHandle_t zmos_isrTaskTakeAll(void)
+{
+#if ZMOS_ISR_ATOMIC
+    return __atomic_exchange_n(&ZMOS_KERNEL->isrTaskStack, NULL, __ATOMIC_ACQUIRE);
+#else
+    zmos_taskHandle_t pHead;
+    
+    ZMOS_ENTER_CRITICAL();
+    pHead = ZMOS_KERNEL->isrTaskStack;
+    ZMOS_KERNEL->isrTaskStack = NULL;
+    ZMOS_EXIT_CRITICAL();
+    return pHead;
+#endif
+}
+#if ZMOS_ISR_DEFER_RING_SIZE > 0
+/*****************************************************************
+* FUNCTION: zmos_isrIndexLoad
+*
+* DESCRIPTION:
+*     Load the ring index written by the other side.
+* INPUTS:
+*     pIndex : The index.
+* RETURNS:
+*     The index value.
+* NOTE:
+*     null
+*****************************************************************/
+static uint16_t zmos_isrIndexLoad(uint16_t *pIndex)
+{
+#if ZMOS_ISR_ATOMIC
+    return __atomic_load_n(pIndex, __ATOMIC_ACQUIRE);
+#else
+    uint16_t value;
+    
+    ZMOS_ENTER_CRITICAL();
+    value = *(volatile uint16_t *)pIndex;
+    ZMOS_EXIT_CRITICAL();
+    return value;
+#endif
+}
+/*****************************************************************
+* FUNCTION: zmos_isrIndexStore
+*
+* DESCRIPTION:
+*     Store the ring index read by the other side.
+* INPUTS:
+*     pIndex : The index.
+*     value : The index value.
+* RETURNS:
+*     null
+* NOTE:
+*     null
+*****************************************************************/
+static void zmos_isrIndexStore(uint16_t *pIndex, uint16_t value)
+{
+#if ZMOS_ISR_ATOMIC
+    __atomic_store_n(pIndex, value, __ATOMIC_RELEASE);
+#else
+    ZMOS_ENTER_CRITICAL();
+    *(volatile uint16_t *)pIndex = value;
+    ZMOS_EXIT_CRITICAL();
+#endif
+}
+#endif
+
+#else
+taskReslt_t zmos_setTaskEventFromISR(zmos_taskHandle_t pTaskHandle, uTaskEvent_t events) {return zmos_setTaskEvent(pTaskHandle, events);}
+taskReslt_t zmos_deferCallFromISR(zmosDeferFunc_t func, void *arg) {return ZMOS_TASK_FAILD;}
+void zmos_isrProcess(void) {}
+uint8_t zmos_isrCheckPending(void) {return 0;}
+#endif
+/****************************************************** END OF FILE ******************************************************/
@@ -0,0 +1,312 @@
+/*****************************************************************
+* Copyright (C) 2026 zm. All rights reserved.                    *
+******************************************************************
+* ZMOS_Job.c
+*
+* DESCRIPTION:
+*     ZMOS budgeted background jobs.
+* AUTHOR:
+*     zm
+* CREATED DATE:
+*     2026/10/17
+* REVISION:
+*     v0.1
+*
+* MODIFICATION HISTORY
+* --------------------
+* $Log:$
+*
+*****************************************************************/
+ 
+/*************************************************************************************************************************
+ *                                                       INCLUDES                                                        *
+ *************************************************************************************************************************/
+#include "ZMOS_Common.h"
+#include "ZMOS_Job.h"
+#include "ZMOS.h"
+#include "bsp_clock.h"
+
+#if ZMOS_USE_JOB
+/*************************************************************************************************************************
+ *                                                        MACROS                                                         *
+ *************************************************************************************************************************/
+ 
+/*************************************************************************************************************************
+ *                                                      CONSTANTS                                                        *
+ *************************************************************************************************************************/
+ 
+/*************************************************************************************************************************
+ *                                                       TYPEDEFS                                                        *
+ *************************************************************************************************************************/
+ 
+/*************************************************************************************************************************
+ *                                                   GLOBAL VARIABLES                                                    *
+ *************************************************************************************************************************/
+ 
+/*************************************************************************************************************************
+ *                                                  EXTERNAL VARIABLES                                                   *
+ *************************************************************************************************************************/
+ 
+/*************************************************************************************************************************
+ *                                                    LOCAL VARIABLES                                                    *
+ *************************************************************************************************************************/
+ 
+/*************************************************************************************************************************
+ *                                                 FUNCTION DECLARATIONS                                                 *
+ *************************************************************************************************************************/
+static void zmos_jobRemove(zmos_job_t *pJob);
+/*************************************************************************************************************************
+ *                                                   PUBLIC FUNCTIONS                                                    *
+ *************************************************************************************************************************/
+/*****************************************************************
+* FUNCTION: zmos_jobSubmit
+*
+* DESCRIPTION:
+*     This function to submit a background job.
+* INPUTS:
+*     pJob : The job, it must be kept until done.
+*     step : The step function of the job.
+*     state : The state passed to the step function.
+*     pTaskHandle : The task to notify, NULL is none.
+*     progressEvent : Set to the task when the progress changes, 0 is none.
+*     doneEvent : Set to the task when the job is done, 0 is none.
+* RETURNS:
+*     0 : Success (ZMOS_TASK_SUCCESS).
+*     other : ref ZMOS task return cordes.
+* NOTE:
+*     The steps run only when no task is ready, in slices of
+*     the budget(zmos_jobSetSlice). Return ZMOS_TASK_FAILD when
+*     the job is queued already.
+*****************************************************************/
+taskReslt_t zmos_jobSubmit(zmos_job_t *pJob, zmosJobStep_t step, void *state, 
+                           zmos_taskHandle_t pTaskHandle, uTaskEvent_t progressEvent, uTaskEvent_t doneEvent)
+{
+    if(!pJob || !step) return ZMOS_TASK_ERROR_PARAM;
+    
+    ZMOS_ENTER_CRITICAL();
+    if(pJob->status == ZMOS_JOB_QUEUED)
+    {
+        ZMOS_EXIT_CRITICAL();
+        return ZMOS_TASK_FAILD;
+    }
+    pJob->step = step;
+    pJob->state = state;
+    pJob->taskHandle = pTaskHandle;
+    pJob->progressEvent = progressEvent;
+    pJob->doneEvent = doneEvent;
+    pJob->progress = 0;
+    pJob->status = ZMOS_JOB_QUEUED;
+    pJob->next = NULL;
+    if(ZMOS_KERNEL->jobTail)
+    {
+        ZMOS_KERNEL->jobTail->next = pJob;
+    }
+    else
+    {
+        ZMOS_KERNEL->jobHead = pJob;
+    }
+    ZMOS_KERNEL->jobTail = pJob;
+    ZMOS_EXIT_CRITICAL();
+    
+    return ZMOS_TASK_SUCCESS;
+}
+/*****************************************************************
+* FUNCTION: zmos_jobCancel
+*
+* DESCRIPTION:
+*     This function to cancel a background job.
+* INPUTS:
+*     pJob : The job.
+* RETURNS:
+*     0 : Success (ZMOS_TASK_SUCCESS).
+*     other : ref ZMOS task return cordes.
+* NOTE:
+*     No event is set to the task of the cancelled job.
+*****************************************************************/
+taskReslt_t zmos_jobCancel(zmos_job_t *pJob)
+{
+    if(!pJob) return ZMOS_TASK_ERROR_PARAM;
+    
+    ZMOS_ENTER_CRITICAL();
+    if(pJob->status != ZMOS_JOB_QUEUED)
+    {
+        ZMOS_EXIT_CRITICAL();
+        return ZMOS_TASK_FAILD;
+    }
+    zmos_jobRemove(pJob);
+    pJob->status = ZMOS_JOB_CANCELLED;
+    ZMOS_EXIT_CRITICAL();
+    
+    return ZMOS_TASK_SUCCESS;
+}
+/*****************************************************************
+* FUNCTION: zmos_jobGetProgress
+*
+* DESCRIPTION:
+*     This function to get the progress of a background job.
+* INPUTS:
+*     pJob : The job.
+* RETURNS:
+*     The progress returned by the last step(0 ~ 100).
+* NOTE:
+*     null
+*****************************************************************/
+uint8_t zmos_jobGetProgress(const zmos_job_t *pJob)
+{
+    return pJob ? pJob->progress : 0;
+}
+/*****************************************************************
+* FUNCTION: zmos_jobGetStatus
+*
+* DESCRIPTION:
+*     This function to get the status of a background job.
+* INPUTS:
+*     pJob : The job.
+* RETURNS:
+*     ref ZMOS job status.
+* NOTE:
+*     null
+*****************************************************************/
+uint8_t zmos_jobGetStatus(const zmos_job_t *pJob)
+{
+    return pJob ? pJob->status : ZMOS_JOB_IDLE;
+}
+/*****************************************************************
+* FUNCTION: zmos_jobSetSlice
+*
+* DESCRIPTION:
+*     This function to set the time budget of a slice of the jobs.
+* INPUTS:
+*     slice : The budget in bsp_getCycleCount unit, 0 is one step.
+* RETURNS:
+*     null
+* NOTE:
+*     The runner stops at once when a task is ready, the budget
+*     bounds the delay by the step in progress.
+*****************************************************************/
+void zmos_jobSetSlice(uint32_t slice)
+{
+    ZMOS_KERNEL->jobSlice = slice;
+}
+/*****************************************************************
+* FUNCTION: zmos_jobProcess
+*
+* DESCRIPTION:
+*     This function to run the steps of the jobs in a slice.
+* INPUTS:
+*     null
+* RETURNS:
+*     null
+* NOTE:
+*     Called by the scheduler when no task is ready, the slice ends
+*     when a task is ready or the budget is used up. The job not
+*     done goes to the tail after its slice.
+*****************************************************************/
+void zmos_jobProcess(void)
+{
+    zmos_job_t *pJob;
+    zmos_taskHandle_t pTaskHandle;
+    uTaskEvent_t events;
+    uint32_t startCycle = bsp_getCycleCount();
+    uint8_t progress;
+    
+    while((pJob = ZMOS_KERNEL->jobHead) != NULL)
+    {
+        progress = pJob->step(pJob->state);
+        if(progress > ZMOS_JOB_PROGRESS_DONE)
+        {
+            progress = ZMOS_JOB_PROGRESS_DONE;
+        }
+    
+        events = 0;
+        ZMOS_ENTER_CRITICAL();
+        pTaskHandle = pJob->taskHandle;
+        //The job may have been cancelled by the step.
+        if(pJob->status == ZMOS_JOB_QUEUED)
+        {
+            if(progress != pJob->progress)
+            {
+                events |= pJob->progressEvent;
+            }
+            pJob->progress = progress;
+            if(progress == ZMOS_JOB_PROGRESS_DONE)
+            {
+                zmos_jobRemove(pJob);
+                pJob->status = ZMOS_JOB_DONE;
+                events |= pJob->doneEvent;
+            }
+        }
+        ZMOS_EXIT_CRITICAL();
+        if(pTaskHandle && events)
+        {
+            zmos_setTaskEvent(pTaskHandle, events);
+        }
+    
+        //Give way to the tasks.
+        if(zmos_checkTaskIsIdle()) break;
+    
+        if(bsp_getCycleCount() - startCycle >= ZMOS_KERNEL->jobSlice)
+        {
+            ZMOS_ENTER_CRITICAL();
+            //Round robin the jobs by slice.
+            if(pJob == ZMOS_KERNEL->jobHead && pJob->next)
+            {
+                zmos_jobRemove(pJob);
+                pJob->next = NULL;
+                ZMOS_KERNEL->jobTail->next = pJob;
+                ZMOS_KERNEL->jobTail = pJob;
+            }
+            ZMOS_EXIT_CRITICAL();
+            break;
+        }
+    }
+}
+/*************************************************************************************************************************
+ *                                                    LOCAL FUNCTIONS                                                    *
+ *************************************************************************************************************************/
+/*****************************************************************
+* FUNCTION: zmos_jobRemove
+*
+* DESCRIPTION:
+*     Remove the job from the job queue.
+* INPUTS:
+*     pJob : The job to remove.
+* RETURNS:
+*     null
+* NOTE:
+*     Must be called in critical.
+*****************************************************************/
+static void zmos_jobRemove(zmos_job_t *pJob)
+{
+    zmos_job_t *pPrev = NULL;
+    zmos_job_t *pSrch = ZMOS_KERNEL->jobHead;
+    
+    while(pSrch && pSrch != pJob)
+    {
+        pPrev = pSrch;
+        pSrch = pSrch->next;
+    }
+    if(!pSrch) return;
+    
+    if(pPrev)
+    {
+        pPrev->next = pJob->next;
+    }
+    else
+    {
+        ZMOS_KERNEL->jobHead = pJob->next;
+    }
+    if(ZMOS_KERNEL->jobTail == pJob)
+    {
+        ZMOS_KERNEL->jobTail = pPrev;
+    }
+}
+
+#else
+taskReslt_t zmos_jobSubmit(zmos_job_t *pJob, zmosJobStep_t step, void *state, zmos_taskHandle_t pTaskHandle, uTaskEvent_t progressEvent, uTaskEvent_t doneEvent) {return ZMOS_TASK_FAILD;}
+taskReslt_t zmos_jobCancel(zmos_job_t *pJob) {return ZMOS_TASK_FAILD;}
+uint8_t zmos_jobGetProgress(const zmos_job_t *pJob) {return 0;}
+uint8_t zmos_jobGetStatus(const zmos_job_t *pJob) {return ZMOS_JOB_IDLE;}
+void zmos_jobSetSlice(uint32_t slice) {}
+#endif
+/****************************************************** END OF FILE ******************************************************/
@@ -0,0 +1,128 @@
+/*****************************************************************
+* Copyright (C) 2026 zm. All rights reserved.                    *
+******************************************************************
+* ZMOS_Kernel.c
+*
+* DESCRIPTION:
+*     ZMOS kernel instance.
+* AUTHOR:
+*     zm
+* CREATED DATE:
+*     2026/10/17
+* REVISION:
+*     v0.1
+*
+* MODIFICATION HISTORY
+* --------------------
+* $Log:$
+*
+*****************************************************************/
+ 
+/*************************************************************************************************************************
+ *                                                       INCLUDES                                                        *
+ *************************************************************************************************************************/
+#include <string.h>
+#include "ZMOS_Common.h"
+#include "ZMOS_Kernel.h"
+#include "ZMOS.h"
+/*************************************************************************************************************************
+ *                                                        MACROS                                                         *
+ *************************************************************************************************************************/
+ 
+/*************************************************************************************************************************
+ *                                                      CONSTANTS                                                        *
+ *************************************************************************************************************************/
+ 
+/*************************************************************************************************************************
+ *                                                       TYPEDEFS                                                        *
+ *************************************************************************************************************************/
+ 
+/*************************************************************************************************************************
+ *                                                   GLOBAL VARIABLES                                                    *
+ *************************************************************************************************************************/
+/* The default kernel, zero initialized and set by zmos_system_init */
+zmos_kernel_t zmosDefaultKernel;
+#if ZMOS_KERNEL_INSTANCE
+/* The kernel used by the thread */
+ZMOS_THREAD_LOCAL zmos_kernel_t *zmosCurrentKernel = &zmosDefaultKernel;
+#endif
+/*************************************************************************************************************************
+ *                                                  EXTERNAL VARIABLES                                                   *
+ *************************************************************************************************************************/
+ 
+/*************************************************************************************************************************
+ *                                                    LOCAL VARIABLES                                                    *
+ *************************************************************************************************************************/
+ 
+/*************************************************************************************************************************
+ *                                                 FUNCTION DECLARATIONS                                                 *
+ *************************************************************************************************************************/
+ 
+/*************************************************************************************************************************
+ *                                                   PUBLIC FUNCTIONS                                                    *
+ *************************************************************************************************************************/
+ 
+/*************************************************************************************************************************
+ *                                                    LOCAL FUNCTIONS                                                    *
+ *************************************************************************************************************************/
+/*****************************************************************
+* FUNCTION: zmos_kernelInit
+*
+* DESCRIPTION:
+*     This function to initialize a kernel instance and select it.
+* INPUTS:
+*     pKernel : The kernel instance.
+* RETURNS:
+*     null
+* NOTE:
+*     Call zmos_system_init after it to initialize the system
+*     of the kernel.
+*****************************************************************/
+void zmos_kernelInit(zmos_kernel_t *pKernel)
+{
+#if ZMOS_KERNEL_INSTANCE
+    if(pKernel)
+    {
+        memset(pKernel, 0, sizeof(zmos_kernel_t));
+        zmosCurrentKernel = pKernel;
+    }
+#endif
+}
+/*****************************************************************
+* FUNCTION: zmos_kernelSelect
+*
+* DESCRIPTION:
+*     This function to select the kernel used by the calling thread.
+* INPUTS:
+*     pKernel : The kernel instance, NULL is the default kernel.
+* RETURNS:
+*     The kernel selected before.
+* NOTE:
+*     Only the default kernel when ZMOS_KERNEL_INSTANCE is disabled.
+*****************************************************************/
+zmos_kernel_t *zmos_kernelSelect(zmos_kernel_t *pKernel)
+{
+    zmos_kernel_t *pPrevKernel = ZMOS_KERNEL;
+    
+#if ZMOS_KERNEL_INSTANCE
+    zmosCurrentKernel = pKernel ? pKernel : &zmosDefaultKernel;
+#endif
+    return pPrevKernel;
+}
+/*****************************************************************
+* FUNCTION: zmos_getKernel
+*
+* DESCRIPTION:
+*     This function to get the kernel used by the calling thread.
+* INPUTS:
+*     null
+* RETURNS:
+*     The kernel instance.
+* NOTE:
+*     null
+*****************************************************************/
+zmos_kernel_t *zmos_getKernel(void)
+{
+    return ZMOS_KERNEL;
+}
+/****************************************************** END OF FILE ******************************************************/
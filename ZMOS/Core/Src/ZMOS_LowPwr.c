@@ -43,7 +43,7 @@
 /*************************************************************************************************************************
  *                                                   GLOBAL VARIABLES                                                    *
  *************************************************************************************************************************/
-static uint32_t zmos_lowPwrEvents = 0;
+ 
 /*************************************************************************************************************************
  *                                                  EXTERNAL VARIABLES                                                   *
  *************************************************************************************************************************/
@@ -55,7 +55,7 @@ static uint32_t zmos_lowPwrEvents = 0;
 /*************************************************************************************************************************
  *                                                 FUNCTION DECLARATIONS                                                 *
  *************************************************************************************************************************/
- 
+extern uint32_t zmos_getNextWakeupTimeout(void);
 /*************************************************************************************************************************
  *                                                   PUBLIC FUNCTIONS                                                    *
  *************************************************************************************************************************/
@@ -77,7 +77,7 @@ static uint32_t zmos_lowPwrEvents = 0;
 *****************************************************************/
 void zmos_lowPwrMgrInit(void)
 {
-    zmos_lowPwrEvents = 0;
+    ZMOS_KERNEL->lowPwrEvents = 0;
 }
 /*****************************************************************
 * FUNCTION: zmos_lowPwrSetEvent
@@ -95,7 +95,7 @@ void zmos_lowPwrSetEvent(uint8_t event)
 {
     if(event < 32)
     {
-        zmos_lowPwrEvents |= BS(event);
+        ZMOS_KERNEL->lowPwrEvents |= BS(event);
     }
 }
 /*****************************************************************
@@ -114,7 +114,7 @@ void zmos_lowPwrClearEvent(uint8_t event)
 {
     if(event < 32)
     {
-        zmos_lowPwrEvents &= BC(event);
+        ZMOS_KERNEL->lowPwrEvents &= BC(event);
     }
 }
 /*****************************************************************
@@ -132,9 +132,12 @@ void zmos_lowPwrClearEvent(uint8_t event)
 void zmos_lowPowerManagement(void)
 {
     // When no event runs
-    if(zmos_lowPwrEvents == 0
+    if(ZMOS_KERNEL->lowPwrEvents == 0
 #if ZMOS_LPM_WAIT_IDLE
        && !zmos_checkTaskIsIdle()
+#endif
+#if ZMOS_USE_JOB
+       && !ZMOS_KERNEL->jobHead
 #endif
            )
     {
@@ -142,15 +145,17 @@ void zmos_lowPowerManagement(void)
 
         ZMOS_ENTER_CRITICAL();
         // Get next timeout
-        nextTimeout  = zmos_getNextLowestTimeout();
+        nextTimeout  = zmos_getNextWakeupTimeout();
         
         ZMOS_EXIT_CRITICAL();
         //Processing before entering low power
         bsp_lowPwrEnterBefore(nextTimeout);
+        ZMOS_TRACE_POINT(ZMOS_TRACE_LPM_ENTER, 0, nextTimeout, 0);
         //Enter low power
         bsp_systemEnterLpm();
         //Processing after low power
         bsp_lowPwrExitAfter();
+        ZMOS_TRACE_POINT(ZMOS_TRACE_LPM_EXIT, 0, 0, 0);
     }
 }
 #else
@@ -26,6 +26,7 @@
 #include "ZMOS_Types.h"
 #include "ZMOS_Config.h"
 #include "ZMOS_Memory.h"
+#include "ZMOS_Kernel.h"
 
 #if ZMOS_USE_MEM_MGR
 /*************************************************************************************************************************
@@ -64,12 +65,6 @@ typedef struct zmosMem
     zm_size_t next;
 }zmosMem_t;
 
-typedef struct
-{
-    //zm_size_t surpSize;
-    zm_size_t usedSize;
-    zm_size_t maxSize;
-}zmosMemStats_t;
 /*************************************************************************************************************************
  *                                                   GLOBAL VARIABLES                                                    *
  *************************************************************************************************************************/
@@ -82,22 +77,8 @@ typedef struct
 #error "Error heap addr"
 #endif*/
      
-#else
-static zm_uint8_t zmos_pool[ZMOS_MEM_SIZE];
-#endif
-
-/** pointer to the heap: for alignment, heap_ptr is now a pointer instead of an array */
-static zm_uint8_t *zmosMemHeap;
-/** the last entry, always unused! */
-static zmosMem_t *zmosMemEnd;
-/** pointer to the lowest free block */
-static zmosMem_t *lfree;
-
-static zm_size_t zmosMemSize;
-
-#if ZMOS_MEM_STATS
-static zmosMemStats_t memStats;
 #endif
+/* The memory pool and heap state are in the kernel(zmos_kernel_t) */
 /*************************************************************************************************************************
  *                                                  EXTERNAL VARIABLES                                                   *
  *************************************************************************************************************************/
@@ -123,30 +104,30 @@ static void zmos_putTogether(zmosMem_t *pMem)
     zmosMem_t *nextMem;
     zmosMem_t *prevMem;
     
-    nextMem = (zmosMem_t *)&zmosMemHeap[pMem->next];
+    nextMem = (zmosMem_t *)&ZMOS_KERNEL->memHeap[pMem->next];
     
     if(nextMem->magic == ZMOS_HEAP_MAGIC && nextMem != pMem &&
-       nextMem->used == 0 && nextMem != zmosMemEnd)
+       nextMem->used == 0 && nextMem != ZMOS_KERNEL->memEnd)
     {
-        if(lfree == nextMem)
+        if(ZMOS_KERNEL->memLfree == nextMem)
         {
-            lfree = pMem;
+            ZMOS_KERNEL->memLfree = pMem;
         }
         pMem->next = nextMem->next;
-        ((zmosMem_t *)&zmosMemHeap[nextMem->next])->prev = (zm_uint8_t *)pMem - zmosMemHeap;
+        ((zmosMem_t *)&ZMOS_KERNEL->memHeap[nextMem->next])->prev = (zm_uint8_t *)pMem - ZMOS_KERNEL->memHeap;
     }
     
-    prevMem = (zmosMem_t *)&zmosMemHeap[pMem->prev];
+    prevMem = (zmosMem_t *)&ZMOS_KERNEL->memHeap[pMem->prev];
     
     if(prevMem->magic == ZMOS_HEAP_MAGIC &&
        nextMem != pMem && prevMem->used == 0)
     {
-        if(lfree == pMem)
+        if(ZMOS_KERNEL->memLfree == pMem)
         {
-            lfree = prevMem;
+            ZMOS_KERNEL->memLfree = prevMem;
         }
         prevMem->next = pMem->next;
-        ((zmosMem_t *)&zmosMemHeap[pMem->next])->prev = (zm_uint8_t *)prevMem - zmosMemHeap;
+        ((zmosMem_t *)&ZMOS_KERNEL->memHeap[pMem->next])->prev = (zm_uint8_t *)prevMem - ZMOS_KERNEL->memHeap;
     }
 }
 
@@ -167,13 +148,13 @@ static void zmos_mem_init(void *beginAddr, void *endAddr)
 {
     zmosMem_t *pMem;
     
-    zm_size_t beginAlign = ZMOS_ALIGN((zm_size_t)beginAddr, ZMOS_MEM_ALIGN_SIZE);
-    zm_size_t endAlign = ZMOS_ALIGN_DOWN((zm_size_t)endAddr, ZMOS_MEM_ALIGN_SIZE);
+    zm_uintptr_t beginAlign = ZMOS_ALIGN((zm_uintptr_t)beginAddr, ZMOS_MEM_ALIGN_SIZE);
+    zm_uintptr_t endAlign = ZMOS_ALIGN_DOWN((zm_uintptr_t)endAddr, ZMOS_MEM_ALIGN_SIZE);
     
     if(endAlign > (2 * MEM_STRUCT_SIZE) &&
        (endAlign - 2 * MEM_STRUCT_SIZE) >= beginAlign)
     {
-        zmosMemSize = endAlign - beginAlign - 2 * MEM_STRUCT_SIZE;
+        ZMOS_KERNEL->memSize = (zm_size_t)(endAlign - beginAlign - 2 * MEM_STRUCT_SIZE);
     }
     else
     {
@@ -181,26 +162,26 @@ static void zmos_mem_init(void *beginAddr, void *endAddr)
         return;
     }
     
-    zmosMemHeap = (zm_uint8_t *)beginAlign;
+    ZMOS_KERNEL->memHeap = (zm_uint8_t *)beginAlign;
     
-    pMem = (zmosMem_t *)zmosMemHeap;
+    pMem = (zmosMem_t *)ZMOS_KERNEL->memHeap;
     pMem->magic = ZMOS_HEAP_MAGIC;
     pMem->used = 0;
-    pMem->next = zmosMemSize + MEM_STRUCT_SIZE;
+    pMem->next = ZMOS_KERNEL->memSize + MEM_STRUCT_SIZE;
     pMem->prev = 0;
     
-    zmosMemEnd = (zmosMem_t *)&zmosMemHeap[pMem->next];
-    zmosMemEnd->magic = ZMOS_HEAP_MAGIC;
-    zmosMemEnd->used = 1;
-    zmosMemEnd->next = zmosMemSize + MEM_STRUCT_SIZE;
-    zmosMemEnd->prev = zmosMemSize + MEM_STRUCT_SIZE;
+    ZMOS_KERNEL->memEnd = (zmosMem_t *)&ZMOS_KERNEL->memHeap[pMem->next];
+    ZMOS_KERNEL->memEnd->magic = ZMOS_HEAP_MAGIC;
+    ZMOS_KERNEL->memEnd->used = 1;
+    ZMOS_KERNEL->memEnd->next = ZMOS_KERNEL->memSize + MEM_STRUCT_SIZE;
+    ZMOS_KERNEL->memEnd->prev = ZMOS_KERNEL->memSize + MEM_STRUCT_SIZE;
     
-    lfree = pMem;
+    ZMOS_KERNEL->memLfree = pMem;
 
 #if ZMOS_MEM_STATS
-    memStats.maxSize = 0;
-    memStats.usedSize = 0;
-    //memStats.surpSize = zmosMemSize;
+    ZMOS_KERNEL->memStats.maxSize = 0;
+    ZMOS_KERNEL->memStats.usedSize = 0;
+    //ZMOS_KERNEL->memStats.surpSize = ZMOS_KERNEL->memSize;
 #endif
 }
 
@@ -226,15 +207,15 @@ static void *zmos_mem_malloc(zm_size_t size)
     
     size = ZMOS_ALIGN_GET(size);
     
-    if(size > zmosMemSize) return NULL;
+    if(size > ZMOS_KERNEL->memSize) return NULL;
     
     if(size < MIN_SIZE_ALIGNED) size = MIN_SIZE_ALIGNED;
     
-    for(idx = (zm_uint8_t *)lfree - zmosMemHeap;
-        idx < (zmosMemSize - size);
-        idx = ((zmosMem_t *)&zmosMemHeap[idx])->next)
+    for(idx = (zm_uint8_t *)ZMOS_KERNEL->memLfree - ZMOS_KERNEL->memHeap;
+        idx < (ZMOS_KERNEL->memSize - size);
+        idx = ((zmosMem_t *)&ZMOS_KERNEL->memHeap[idx])->next)
     {
-        pMem = (zmosMem_t *)&zmosMemHeap[idx];
+        pMem = (zmosMem_t *)&ZMOS_KERNEL->memHeap[idx];
         
         if(!pMem->used && (pMem->next - idx - MEM_STRUCT_SIZE) >= size)
         {
@@ -243,7 +224,7 @@ static void *zmos_mem_malloc(zm_size_t size)
             {
                 zm_size_t ptr = idx + MEM_STRUCT_SIZE + size;
                 
-                mem = (zmosMem_t *)&zmosMemHeap[ptr];
+                mem = (zmosMem_t *)&ZMOS_KERNEL->memHeap[ptr];
                 mem->magic = ZMOS_HEAP_MAGIC;
                 mem->used = 0;
                 mem->next = pMem->next;
@@ -252,15 +233,15 @@ static void *zmos_mem_malloc(zm_size_t size)
                 pMem->next = ptr;
                 pMem->used = 1;
                 
-                if(mem->next != (zmosMemSize + MEM_STRUCT_SIZE))
+                if(mem->next != (ZMOS_KERNEL->memSize + MEM_STRUCT_SIZE))
                 {
-                    ((zmosMem_t *)&zmosMemHeap[mem->next])->prev = ptr;
+                    ((zmosMem_t *)&ZMOS_KERNEL->memHeap[mem->next])->prev = ptr;
                 }
 #if ZMOS_MEM_STATS
-                memStats.usedSize += (size + MEM_STRUCT_SIZE);
-                if(memStats.maxSize < memStats.usedSize)
+                ZMOS_KERNEL->memStats.usedSize += (size + MEM_STRUCT_SIZE);
+                if(ZMOS_KERNEL->memStats.maxSize < ZMOS_KERNEL->memStats.usedSize)
                 {
-                    memStats.maxSize = memStats.usedSize;
+                    ZMOS_KERNEL->memStats.maxSize = ZMOS_KERNEL->memStats.usedSize;
                 }
 #endif
             }
@@ -268,23 +249,23 @@ static void *zmos_mem_malloc(zm_size_t size)
             {
                 pMem->used = 1;
 #if ZMOS_MEM_STATS
-                memStats.usedSize += (pMem->next - idx);
-                if(memStats.maxSize < memStats.usedSize)
+                ZMOS_KERNEL->memStats.usedSize += (pMem->next - idx);
+                if(ZMOS_KERNEL->memStats.maxSize < ZMOS_KERNEL->memStats.usedSize)
                 {
-                    memStats.maxSize = memStats.usedSize;
+                    ZMOS_KERNEL->memStats.maxSize = ZMOS_KERNEL->memStats.usedSize;
                 }
 #endif
             }
             pMem->magic = ZMOS_HEAP_MAGIC;
             
-            if(pMem == lfree)
+            if(pMem == ZMOS_KERNEL->memLfree)
             {
-                while(lfree->used && lfree != zmosMemEnd)
+                while(ZMOS_KERNEL->memLfree->used && ZMOS_KERNEL->memLfree != ZMOS_KERNEL->memEnd)
                 {
-                    lfree = (zmosMem_t *)&zmosMemHeap[lfree->next];
+                    ZMOS_KERNEL->memLfree = (zmosMem_t *)&ZMOS_KERNEL->memHeap[ZMOS_KERNEL->memLfree->next];
                 }
                 
-                ZMOS_MEM_ASSERT(lfree == zmosMemEnd || !lfree->used);
+                ZMOS_MEM_ASSERT(ZMOS_KERNEL->memLfree == ZMOS_KERNEL->memEnd || !ZMOS_KERNEL->memLfree->used);
             }
             
             return (zm_uint8_t *)pMem + MEM_STRUCT_SIZE;
@@ -316,7 +297,7 @@ static void *zmos_mem_realloc(void *ptr, zm_size_t newsize)
     
     newsize = ZMOS_ALIGN_GET(newsize);
     
-    if(newsize > zmosMemSize) return NULL;
+    if(newsize > ZMOS_KERNEL->memSize) return NULL;
     
     if(newsize == 0)
     {
@@ -328,8 +309,8 @@ static void *zmos_mem_realloc(void *ptr, zm_size_t newsize)
     
     if(ptr == NULL) return zmos_mem_malloc(newsize);
     
-    if((zm_uint8_t *)ptr < (zm_uint8_t *)zmosMemHeap ||
-       (zm_uint8_t *)ptr >= (zm_uint8_t *)zmosMemEnd)
+    if((zm_uint8_t *)ptr < (zm_uint8_t *)ZMOS_KERNEL->memHeap ||
+       (zm_uint8_t *)ptr >= (zm_uint8_t *)ZMOS_KERNEL->memEnd)
     {
         //illegal memory
         return ptr;
@@ -337,7 +318,7 @@ static void *zmos_mem_realloc(void *ptr, zm_size_t newsize)
     
     pMem = (zmosMem_t *)((zm_uint8_t *)ptr - MEM_STRUCT_SIZE);
     
-    idx = (zm_uint8_t *)pMem - zmosMemHeap;
+    idx = (zm_uint8_t *)pMem - ZMOS_KERNEL->memHeap;
     size = pMem->next - idx - MEM_STRUCT_SIZE;
     
     if(size == newsize)
@@ -351,7 +332,7 @@ static void *zmos_mem_realloc(void *ptr, zm_size_t newsize)
         zmosMem_t *mem;
         
         idx2 = idx + MEM_STRUCT_SIZE + size;
-        mem = (zmosMem_t *)&zmosMemHeap[idx2];
+        mem = (zmosMem_t *)&ZMOS_KERNEL->memHeap[idx2];
         mem->magic = ZMOS_HEAP_MAGIC;
         mem->used = 0;
         mem->next = pMem->next;
@@ -359,14 +340,14 @@ static void *zmos_mem_realloc(void *ptr, zm_size_t newsize)
         
         pMem->next = idx2;
         
-        if(mem->next != (zmosMemSize + MEM_STRUCT_SIZE))
+        if(mem->next != (ZMOS_KERNEL->memSize + MEM_STRUCT_SIZE))
         {
-            ((zmosMem_t *)&zmosMemHeap[mem->next])->prev = idx2;
+            ((zmosMem_t *)&ZMOS_KERNEL->memHeap[mem->next])->prev = idx2;
         }
 #if ZMOS_MEM_STATS
-        memStats.usedSize -= (size - newsize);
+        ZMOS_KERNEL->memStats.usedSize -= (size - newsize);
 #endif
-        if(mem < lfree) lfree = mem;
+        if(mem < ZMOS_KERNEL->memLfree) ZMOS_KERNEL->memLfree = mem;
         
         zmos_putTogether(mem);
         
@@ -428,8 +409,8 @@ static void zmos_mem_free(void *ptr)
     
     if(ptr == NULL) return;
     
-    if((zm_uint8_t *)ptr < (zm_uint8_t *)zmosMemHeap ||
-       (zm_uint8_t *)ptr >= (zm_uint8_t *)zmosMemEnd)
+    if((zm_uint8_t *)ptr < (zm_uint8_t *)ZMOS_KERNEL->memHeap ||
+       (zm_uint8_t *)ptr >= (zm_uint8_t *)ZMOS_KERNEL->memEnd)
     {
         //illegal memory
         return;
@@ -443,11 +424,12 @@ static void zmos_mem_free(void *ptr)
         //return;
     }
     pMem->used = 0;
+    ZMOS_TRACE_POINT(ZMOS_TRACE_FREE, ptr, pMem->next - ((zm_uint8_t *)pMem - ZMOS_KERNEL->memHeap) - MEM_STRUCT_SIZE, 0);
     
-    if(pMem < lfree) lfree = pMem;
+    if(pMem < ZMOS_KERNEL->memLfree) ZMOS_KERNEL->memLfree = pMem;
     
 #if ZMOS_MEM_STATS
-    memStats.usedSize -= (pMem->next - ((zm_uint8_t *)pMem - zmosMemHeap));
+    ZMOS_KERNEL->memStats.usedSize -= (pMem->next - ((zm_uint8_t *)pMem - ZMOS_KERNEL->memHeap));
 #endif
     
     zmos_putTogether(pMem);
@@ -470,7 +452,7 @@ void zmos_memoryMgrInit(void)
 #if ZMOS_MEM_USE_HEAP
     zmos_mem_init((void *)ZMOS_MEM_HEAP_BEGIN, (void *)ZMOS_MEM_HEAP_END);
 #else
-    zmos_mem_init((void *)&zmos_pool[0], (void *)((zm_uint8_t *)&zmos_pool[ZMOS_MEM_SIZE - 1]));
+    zmos_mem_init((void *)&ZMOS_KERNEL->memPool[0], (void *)((zm_uint8_t *)&ZMOS_KERNEL->memPool[ZMOS_MEM_SIZE - 1]));
 #endif
 }
 /*****************************************************************
@@ -488,7 +470,10 @@ void zmos_memoryMgrInit(void)
 *****************************************************************/
 void *zmos_malloc(zm_size_t size)
 {
-    return zmos_mem_malloc(size);
+    void *ptr = zmos_mem_malloc(size);
+    
+    ZMOS_TRACE_POINT(ZMOS_TRACE_MALLOC, ptr, size, 0);
+    return ptr;
 }
 /*****************************************************************
 * FUNCTION: zmos_realloc
@@ -507,7 +492,10 @@ void *zmos_malloc(zm_size_t size)
 *****************************************************************/
 void *zmos_realloc(void *ptr, zm_size_t newsize)
 {
-    return zmos_mem_realloc(ptr, newsize);
+    void *newPtr = zmos_mem_realloc(ptr, newsize);
+    
+    ZMOS_TRACE_POINT(ZMOS_TRACE_REALLOC, newPtr, newsize, ptr);
+    return newPtr;
 }
 /*****************************************************************
 * FUNCTION: zmos_mem_calloc
@@ -528,7 +516,10 @@ void *zmos_realloc(void *ptr, zm_size_t newsize)
 *****************************************************************/
 void *zmos_calloc(zm_size_t count, zm_size_t size)
 {
-    return zmos_mem_calloc(count, size);
+    void *ptr = zmos_mem_calloc(count, size);
+    
+    ZMOS_TRACE_POINT(ZMOS_TRACE_MALLOC, ptr, count * size, 0);
+    return ptr;
 }
 /*****************************************************************
 * FUNCTION: zmos_free
@@ -560,7 +551,7 @@ void zmos_free(void *ptr)
 *****************************************************************/
 zm_size_t zmos_getMemTotal(void)
 {
-    return zmosMemSize;
+    return ZMOS_KERNEL->memSize;
 }
 /*****************************************************************
 * FUNCTION: zmos_getMemUsed
@@ -577,7 +568,7 @@ zm_size_t zmos_getMemTotal(void)
 zm_size_t zmos_getMemUsed(void)
 {
 #if ZMOS_MEM_STATS
-    return memStats.usedSize;
+    return ZMOS_KERNEL->memStats.usedSize;
 #else
     return 0;
 #endif
@@ -597,7 +588,7 @@ zm_size_t zmos_getMemUsed(void)
 zm_size_t zmos_getMemMaxUsed(void)
 {
 #if ZMOS_MEM_STATS
-    return memStats.maxSize;
+    return ZMOS_KERNEL->memStats.maxSize;
 #else
     return 0;
 #endif
@@ -620,7 +611,10 @@ zm_size_t zmos_getMemMaxUsed(void)
 *****************************************************************/
 __weak void *zmos_malloc(zm_size_t size)
 {
-    return malloc(size);
+    void *ptr = malloc(size);
+    
+    ZMOS_TRACE_POINT(ZMOS_TRACE_MALLOC, ptr, size, 0);
+    return ptr;
 }
 /*****************************************************************
 * FUNCTION: zmos_free
@@ -636,6 +630,7 @@ __weak void *zmos_malloc(zm_size_t size)
 *****************************************************************/
 __weak void zmos_free(void *ptr)
 {
+    ZMOS_TRACE_POINT(ZMOS_TRACE_FREE, ptr, 0, 0);
     free(ptr);
 }
 /*****************************************************************
@@ -0,0 +1,250 @@
+/*****************************************************************
+* Copyright (C) 2026 zm. All rights reserved.                    *
+******************************************************************
+* ZMOS_Msg.c
+*
+* DESCRIPTION:
+*     ZMOS task message queue.
+* AUTHOR:
+*     zm
+* CREATED DATE:
+*     2026/10/17
+* REVISION:
+*     v0.1
+*
+* MODIFICATION HISTORY
+* --------------------
+* $Log:$
+*
+*****************************************************************/
+ 
+/*************************************************************************************************************************
+ *                                                       INCLUDES                                                        *
+ *************************************************************************************************************************/
+#include "ZMOS_Common.h"
+#include "ZMOS_Tasks.h"
+#include "ZMOS_Memory.h"
+#include "ZMOS_Msg.h"
+#include "ZMOS.h"
+
+#if ZMOS_USE_MSG
+/*************************************************************************************************************************
+ *                                                        MACROS                                                         *
+ *************************************************************************************************************************/
+/* Get message header from message payload */
+#define ZMOS_MSG_HDR(pMsg)          ((zmos_msgHdr_t *)(pMsg) - 1)
+/*************************************************************************************************************************
+ *                                                      CONSTANTS                                                        *
+ *************************************************************************************************************************/
+ 
+/*************************************************************************************************************************
+ *                                                       TYPEDEFS                                                        *
+ *************************************************************************************************************************/
+/**
+ * Message header, placed in front of the message payload.
+ */
+typedef struct zmos_msgHdr
+{
+    struct zmos_msgHdr *next;
+    uint16_t len;
+}zmos_msgHdr_t;
+/*************************************************************************************************************************
+ *                                                   GLOBAL VARIABLES                                                    *
+ *************************************************************************************************************************/
+ 
+/*************************************************************************************************************************
+ *                                                  EXTERNAL VARIABLES                                                   *
+ *************************************************************************************************************************/
+ 
+/*************************************************************************************************************************
+ *                                                    LOCAL VARIABLES                                                    *
+ *************************************************************************************************************************/
+ 
+/*************************************************************************************************************************
+ *                                                 FUNCTION DECLARATIONS                                                 *
+ *************************************************************************************************************************/
+ 
+/*************************************************************************************************************************
+ *                                                   PUBLIC FUNCTIONS                                                    *
+ *************************************************************************************************************************/
+ 
+/*************************************************************************************************************************
+ *                                                    LOCAL FUNCTIONS                                                    *
+ *************************************************************************************************************************/
+/*****************************************************************
+* FUNCTION: zmos_msgAlloc
+*
+* DESCRIPTION:
+*     Allocate a message buffer from the ZMOS heap.
+* INPUTS:
+*     len : Message payload length.
+* RETURNS:
+*     Pointer to the message payload.
+*     NULL : Out of memory.
+* NOTE:
+*     Don't call it in the interrupt.
+*****************************************************************/
+void *zmos_msgAlloc(uint16_t len)
+{
+    zmos_msgHdr_t *pHdr;
+    
+    pHdr = (zmos_msgHdr_t *)zmos_malloc(sizeof(zmos_msgHdr_t) + len);
+    if(pHdr)
+    {
+        pHdr->next = NULL;
+        pHdr->len = len;
+        return (void *)(pHdr + 1);
+    }
+    return NULL;
+}
+/*****************************************************************
+* FUNCTION: zmos_msgSend
+*
+* DESCRIPTION:
+*     Send a message to the task, the message is linked
+*     into the task message queue without copying.
+* INPUTS:
+*     pTaskHandle : The handle of the task to receive.
+*     pMsg : The message allocated by zmos_msgAlloc.
+* RETURNS:
+*     0 : Success (ZMOS_TASK_SUCCESS).
+*     other : ref ZMOS task return cordes.
+* NOTE:
+*     The ZMOS_TASK_MSG_EVENT will be set to the task.
+*****************************************************************/
+taskReslt_t zmos_msgSend(zmos_taskHandle_t pTaskHandle, void *pMsg)
+{
+    zmos_msgHdr_t *pHdr;
+    
+    if(!pTaskHandle || !pMsg) return ZMOS_TASK_ERROR_PARAM;
+    
+    pHdr = ZMOS_MSG_HDR(pMsg);
+    pHdr->next = NULL;
+    
+    ZMOS_ENTER_CRITICAL();
+    if(pTaskHandle->msgTail)
+    {
+        ((zmos_msgHdr_t *)pTaskHandle->msgTail)->next = pHdr;
+    }
+    else
+    {
+        pTaskHandle->msgHead = pHdr;
+    }
+    pTaskHandle->msgTail = pHdr;
+    zmos_setTaskEvent(pTaskHandle, ZMOS_TASK_MSG_EVENT);
+    ZMOS_EXIT_CRITICAL();
+    
+    return ZMOS_TASK_SUCCESS;
+}
+/*****************************************************************
+* FUNCTION: zmos_msgReceive
+*
+* DESCRIPTION:
+*     Receive a message from the task message queue.
+* INPUTS:
+*     pTaskHandle : The handle of the task, NULL is the current task.
+* RETURNS:
+*     Pointer to the message payload.
+*     NULL : No message.
+* NOTE:
+*     The message must be freed by zmos_msgFree.
+*****************************************************************/
+void *zmos_msgReceive(zmos_taskHandle_t pTaskHandle)
+{
+    zmos_msgHdr_t *pHdr;
+    
+    if(pTaskHandle == NULL)
+    {
+        pTaskHandle = zmos_getCurrentTaskHandle();
+        if(pTaskHandle == NULL) return NULL;
+    }
+    
+    ZMOS_ENTER_CRITICAL();
+    pHdr = (zmos_msgHdr_t *)pTaskHandle->msgHead;
+    if(pHdr)
+    {
+        pTaskHandle->msgHead = pHdr->next;
+        if(pTaskHandle->msgHead == NULL)
+        {
+            pTaskHandle->msgTail = NULL;
+        }
+    }
+    ZMOS_EXIT_CRITICAL();
+    
+    if(pHdr)
+    {
+        pHdr->next = NULL;
+        return (void *)(pHdr + 1);
+    }
+    return NULL;
+}
+/*****************************************************************
+* FUNCTION: zmos_msgFree
+*
+* DESCRIPTION:
+*     Free a message.
+* INPUTS:
+*     pMsg : The message to free.
+* RETURNS:
+*     null
+* NOTE:
+*     null
+*****************************************************************/
+void zmos_msgFree(void *pMsg)
+{
+    if(pMsg)
+    {
+        zmos_free(ZMOS_MSG_HDR(pMsg));
+    }
+}
+/*****************************************************************
+* FUNCTION: zmos_msgGetLength
+*
+* DESCRIPTION:
+*     Get the payload length of a message.
+* INPUTS:
+*     pMsg : The message.
+* RETURNS:
+*     The message payload length.
+* NOTE:
+*     null
+*****************************************************************/
+uint16_t zmos_msgGetLength(void *pMsg)
+{
+    if(pMsg)
+    {
+        return ZMOS_MSG_HDR(pMsg)->len;
+    }
+    return 0;
+}
+/*****************************************************************
+* FUNCTION: zmos_msgClear
+*
+* DESCRIPTION:
+*     Free all messages of the task.
+* INPUTS:
+*     pTaskHandle : The handle of the task.
+* RETURNS:
+*     null
+* NOTE:
+*     Called when the task is unregistered.
+*****************************************************************/
+void zmos_msgClear(zmos_taskHandle_t pTaskHandle)
+{
+    void *pMsg;
+    
+    while((pMsg = zmos_msgReceive(pTaskHandle)) != NULL)
+    {
+        zmos_msgFree(pMsg);
+    }
+}
+
+#else
+void *zmos_msgAlloc(uint16_t len) {return NULL;}
+taskReslt_t zmos_msgSend(zmos_taskHandle_t pTaskHandle, void *pMsg) {return ZMOS_TASK_FAILD;}
+void *zmos_msgReceive(zmos_taskHandle_t pTaskHandle) {return NULL;}
+void zmos_msgFree(void *pMsg) {}
+uint16_t zmos_msgGetLength(void *pMsg) {return 0;}
+void zmos_msgClear(zmos_taskHandle_t pTaskHandle) {}
+#endif
+/****************************************************** END OF FILE ******************************************************/
@@ -25,10 +25,18 @@
 #include "ZMOS_Tasks.h"
 #include "ZMOS_Memory.h"
 #include "ZMOS.h"
+#if ZMOS_TASK_STATS || ZMOS_TASK_LATENCY || ZMOS_TASK_BUDGET || ZMOS_TASK_PERIODIC
+#include "bsp_clock.h"
+#endif
+#include <string.h>
 /*************************************************************************************************************************
  *                                                        MACROS                                                         *
  *************************************************************************************************************************/
- 
+#if (defined ZMOS_TASK_SECTION) && (ZMOS_TASK_SECTION)
+#define ZMOS_TASK_SECTION_ITEM_GET(i)   ZM_SECTION_ITEM_GET(ZMOS_TASK_SECTION_NAME, zmos_task_t, (i))
+#define ZMOS_TASK_SECTION_ITEM_COUNT    ZM_SECTION_ITEM_COUNT(ZMOS_TASK_SECTION_NAME, zmos_task_t)
+#endif
+
 /*************************************************************************************************************************
  *                                                      CONSTANTS                                                        *
  *************************************************************************************************************************/
@@ -47,12 +55,9 @@ typedef struct zmosTaskList_T
 /*************************************************************************************************************************
  *                                                   GLOBAL VARIABLES                                                    *
  *************************************************************************************************************************/
-/* Task list head */
-static zmosTaskList_t *taskListHead = NULL;
-/* Index of active task */
-static zmos_taskHandle_t activeTask = NULL;
-/* Idle task function */
-static idleTaskFunc zmosIdleTaskFunc = NULL;
+#if (defined ZMOS_TASK_SECTION) && (ZMOS_TASK_SECTION)
+ZM_SECTION_DEF(ZMOS_TASK_SECTION_NAME, zmos_task_t);
+#endif
 /*************************************************************************************************************************
  *                                                  EXTERNAL VARIABLES                                                   *
  *************************************************************************************************************************/
@@ -65,6 +70,51 @@ static idleTaskFunc zmosIdleTaskFunc = NULL;
  *                                                 FUNCTION DECLARATIONS                                                 *
  *************************************************************************************************************************/
 static zmos_taskHandle_t zmos_getReadyTask(void);
+static zmos_taskHandle_t zmos_taskCreate(taskFunction_t taskFunc, const taskEventHandler_t *eventTable, 
+                                         uint8_t tableNum, taskPriority_t priority);
+static uTaskEvent_t zmos_taskDispatch(zmos_taskHandle_t pTask, uTaskEvent_t events);
+static void zmos_taskRun(zmos_taskHandle_t pTask, uTaskEvent_t events);
+static void zmos_taskReadyInsert(zmos_taskHandle_t pTask, bool head);
+static void zmos_taskReadyRemove(zmos_taskHandle_t pTask);
+#if ZMOS_TASK_EVENT_COUNT
+static void zmos_taskEventCount(zmos_taskHandle_t pTask, uTaskEvent_t events);
+#endif
+#if ZMOS_TASK_STATS
+static void zmos_taskStatsUpdate(zmos_taskStats_t *pStats, uint32_t runTime);
+#endif
+#if ZMOS_TASK_LATENCY
+static void zmos_taskLatencyStamp(zmos_taskHandle_t pTask, uTaskEvent_t events);
+static void zmos_taskLatencyRecord(zmos_taskHandle_t pTask, uTaskEvent_t events);
+#endif
+#if ZMOS_TASK_BUDGET
+static uint8_t zmos_taskBudgetCheck(zmos_taskHandle_t pTask, uTaskEvent_t events, uint32_t runTime, uint32_t *pOverrun);
+#endif
+#if ZMOS_TASK_PERIODIC
+static void zmos_taskPeriodicRelease(void);
+static void zmos_taskPeriodicRemove(zmos_taskHandle_t pTask);
+static void zmos_taskJobDone(zmos_taskHandle_t pTask);
+#endif
+#if ZMOS_TASK_PERIODIC && ZMOS_TASK_EDF
+static zmos_taskHandle_t zmos_taskEdfPosition(zmos_taskHandle_t pTask, bool head);
+#endif
+#if ZMOS_USE_ISR
+extern uint8_t zmos_isrCheckPending(void);
+#endif
+#if ZMOS_USE_MSG
+extern void zmos_msgClear(zmos_taskHandle_t pTaskHandle);
+#endif
+#if ZMOS_USE_TOPIC
+extern void zmos_topicTaskRemove(zmos_taskHandle_t pTaskHandle);
+#endif
+#if ZMOS_TIMER_STORE != ZMOS_TIMER_STORE_LIST
+extern void zmos_timerTaskRemove(zmos_taskHandle_t pTaskHandle);
+#endif
+#if ZMOS_USE_JOB
+extern void zmos_jobProcess(void);
+#endif
+#if ZMOS_USE_IDLE_HOOK
+extern void zmos_idleHookProcess(void);
+#endif
 /*************************************************************************************************************************
  *                                                   PUBLIC FUNCTIONS                                                    *
  *************************************************************************************************************************/
@@ -89,52 +139,134 @@ static zmos_taskHandle_t zmos_getReadyTask(void);
 *****************************************************************/
 taskReslt_t zmos_taskThreadRegister(zmos_taskHandle_t * const pTaskHandle, taskFunction_t taskFunc)
 {
-    if(!taskFunc) return ZMOS_TASK_ERROR_PARAM;
+    return zmos_taskThreadRegisterPriority(pTaskHandle, taskFunc, ZMOS_TASK_PRIORITY_DEFAULT);
+}
+/*****************************************************************
+* FUNCTION: zmos_taskThreadRegisterPriority
+*
+* DESCRIPTION:
+*     Register task thread to ZMOS with priority.
+* INPUTS:
+*     pTaskHandle : The handle of the task.
+*     taskFunc : Task function.
+*     priority : Task priority(0 ~ ZMOS_TASK_PRIORITY_HIGHEST).
+* RETURNS:
+*     0 : Success (ZMOS_TASK_SUCCESS).
+*     other : ref ZMOS task return cordes.
+* NOTE:
+*     If the task is registered, the priority will not be changed.
+*****************************************************************/
+taskReslt_t zmos_taskThreadRegisterPriority(zmos_taskHandle_t * const pTaskHandle, taskFunction_t taskFunc, taskPriority_t priority)
+{
+    zmos_taskHandle_t pTask;
     
-    zmosTaskList_t *newTask;
-    zmosTaskList_t *srchTask;
-    zmosTaskList_t *prevTask;
+    if(!taskFunc || priority > ZMOS_TASK_PRIORITY_HIGHEST) return ZMOS_TASK_ERROR_PARAM;
+    
+    pTask = zmos_taskCreate(taskFunc, NULL, 0, priority);
+    if(pTask)
+    {
+        if(pTaskHandle != NULL)
+        {
+            *pTaskHandle = pTask;
+        }
+        return ZMOS_TASK_SUCCESS;
+    }
+    return ZMOS_TASK_FAILD;
+}
+/*****************************************************************
+* FUNCTION: zmos_taskThreadRegisterTable
+*
+* DESCRIPTION:
+*     Register task thread to ZMOS with an event handler table.
+* INPUTS:
+*     pTaskHandle : The handle of the task.
+*     eventTable : Event handlers indexed by event bit.
+*     tableNum : Number of the event handlers.
+*     priority : Task priority(0 ~ ZMOS_TASK_PRIORITY_HIGHEST).
+* RETURNS:
+*     0 : Success (ZMOS_TASK_SUCCESS).
+*     other : ref ZMOS task return cordes.
+* NOTE:
+*     All pending events are handled within one dispatch, the 
+*     order is set by ZMOS_TASK_EVENT_TABLE_MSB_FIRST. Events 
+*     without handler are discarded.
+*****************************************************************/
+taskReslt_t zmos_taskThreadRegisterTable(zmos_taskHandle_t * const pTaskHandle, const taskEventHandler_t *eventTable, 
+                                         uint8_t tableNum, taskPriority_t priority)
+{
+    zmos_taskHandle_t pTask;
     
-    srchTask = taskListHead;
+    if(!eventTable || !tableNum || tableNum > ZMOS_TASK_EVENT_NUM_MAX || 
+       priority > ZMOS_TASK_PRIORITY_HIGHEST) return ZMOS_TASK_ERROR_PARAM;
     
-    while(srchTask)
+    pTask = zmos_taskCreate(NULL, eventTable, tableNum, priority);
+    if(pTask)
     {
-        //Whether task is registered.
-        if(srchTask->taskHandle.taskFunc == taskFunc)
+        if(pTaskHandle != NULL)
         {
-            if(pTaskHandle != NULL)
-            {
-                *pTaskHandle = &srchTask->taskHandle;
-            }
-            return ZMOS_TASK_SUCCESS;
+            *pTaskHandle = pTask;
         }
-        prevTask = srchTask;
-        srchTask = srchTask->next;
+        return ZMOS_TASK_SUCCESS;
     }
+    return ZMOS_TASK_FAILD;
+}
+#if ZMOS_TASK_CONTEXT
+/*****************************************************************
+* FUNCTION: zmos_taskThreadRegisterContext
+*
+* DESCRIPTION:
+*     Register task thread to ZMOS with a user context.
+* INPUTS:
+*     pTaskHandle : The handle of the task(can't be NULL).
+*     taskFunc : Task function with context.
+*     context : The context passed to the task function.
+*     priority : Task priority(0 ~ ZMOS_TASK_PRIORITY_HIGHEST).
+* RETURNS:
+*     0 : Success (ZMOS_TASK_SUCCESS).
+*     other : ref ZMOS task return cordes.
+* NOTE:
+*     The task is identified by the handle, one task function can 
+*     be registered many times with different handles. If the 
+*     handle is a registered task, it's not registered again.
+*****************************************************************/
+taskReslt_t zmos_taskThreadRegisterContext(zmos_taskHandle_t * const pTaskHandle, taskContextFunction_t taskFunc, 
+                                           void *context, taskPriority_t priority)
+{
+    zmos_taskHandle_t pTask;
+    zmosTaskList_t *srchTask;
     
-    newTask = (zmosTaskList_t *)zmos_malloc(sizeof(zmosTaskList_t));
-    if(newTask)
+    if(!pTaskHandle || !taskFunc || priority > ZMOS_TASK_PRIORITY_HIGHEST) return ZMOS_TASK_ERROR_PARAM;
+    
+    //Whether the handle is registered.
+    if(*pTaskHandle)
     {
-        newTask->next = NULL;
-        newTask->taskHandle.event = 0;
-        newTask->taskHandle.taskFunc = taskFunc;
-        
-        /* Add to the linked list */
-        if(taskListHead)
+        if(zmos_getTaskIndex(*pTaskHandle) != ZMOS_TASK_INVALID_INDEX)
         {
-            prevTask->next = newTask;
+            return ZMOS_TASK_SUCCESS;
         }
-        else taskListHead = newTask;
-        
-        if(pTaskHandle != NULL)
+        srchTask = ZMOS_KERNEL->taskListHead;
+        while(srchTask)
         {
-            *pTaskHandle = &newTask->taskHandle;
+            if(&srchTask->taskHandle == *pTaskHandle)
+            {
+                return ZMOS_TASK_SUCCESS;
+            }
+            srchTask = srchTask->next;
         }
-        
+    }
+    
+    //No function and table, always create a new task.
+    pTask = zmos_taskCreate(NULL, NULL, 0, priority);
+    if(pTask)
+    {
+        pTask->contextFunc = taskFunc;
+        pTask->context = context;
+        *pTaskHandle = pTask;
         return ZMOS_TASK_SUCCESS;
     }
     return ZMOS_TASK_FAILD;
 }
+#endif
 /*****************************************************************
 * FUNCTION: zmos_taskThreadUnregister
 *
@@ -155,10 +287,39 @@ void zmos_taskThreadUnregister(zmos_taskHandle_t pTaskHandle)
     
     if(pDelTask == NULL)
     {
-        pDelTask = activeTask;
+        pDelTask = ZMOS_KERNEL->activeTask;
+    }
+    
+    if(zmos_getTaskIndex(pDelTask) != ZMOS_TASK_INVALID_INDEX)
+    {
+        //Static task can not be deleted, only clear its events.
+        ZMOS_ENTER_CRITICAL();
+        if(ZMOS_KERNEL->activeTask == pDelTask)
+        {
+            ZMOS_KERNEL->activeTask = NULL;
+        }
+        else if(pDelTask->event)
+        {
+            zmos_taskReadyRemove(pDelTask);
+        }
+        pDelTask->event = 0;
+#if ZMOS_TASK_PERIODIC
+        zmos_taskPeriodicRemove(pDelTask);
+#endif
+        ZMOS_EXIT_CRITICAL();
+#if ZMOS_USE_MSG
+        zmos_msgClear(pDelTask);
+#endif
+#if ZMOS_USE_TOPIC
+        zmos_topicTaskRemove(pDelTask);
+#endif
+#if ZMOS_TIMER_STORE != ZMOS_TIMER_STORE_LIST
+        zmos_timerTaskRemove(pDelTask);
+#endif
+        return;
     }
     
-    srchTask = taskListHead;
+    srchTask = ZMOS_KERNEL->taskListHead;
     
     while(srchTask)
     {
@@ -171,14 +332,39 @@ void zmos_taskThreadUnregister(zmos_taskHandle_t pTaskHandle)
     }
     if(srchTask)
     {
-        if(srchTask == taskListHead)
+        if(srchTask == ZMOS_KERNEL->taskListHead)
         {
-            taskListHead = taskListHead->next;
+            ZMOS_KERNEL->taskListHead = ZMOS_KERNEL->taskListHead->next;
         }
         else
         {
             prevTask->next = srchTask->next;
         }
+        
+        ZMOS_ENTER_CRITICAL();
+        if(ZMOS_KERNEL->activeTask == pDelTask)
+        {
+            //The running task is not in the ready list.
+            ZMOS_KERNEL->activeTask = NULL;
+        }
+        else if(srchTask->taskHandle.event)
+        {
+            zmos_taskReadyRemove(&srchTask->taskHandle);
+        }
+#if ZMOS_TASK_PERIODIC
+        zmos_taskPeriodicRemove(&srchTask->taskHandle);
+#endif
+        ZMOS_EXIT_CRITICAL();
+        
+#if ZMOS_USE_MSG
+        zmos_msgClear(&srchTask->taskHandle);
+#endif
+#if ZMOS_USE_TOPIC
+        zmos_topicTaskRemove(&srchTask->taskHandle);
+#endif
+#if ZMOS_TIMER_STORE != ZMOS_TIMER_STORE_LIST
+        zmos_timerTaskRemove(&srchTask->taskHandle);
+#endif
         zmos_free(srchTask);
     }
 }
@@ -202,8 +388,19 @@ taskReslt_t zmos_setTaskEvent(zmos_taskHandle_t pTaskHandle, uTaskEvent_t events
     if(pTaskHandle)
     {
         ZMOS_ENTER_CRITICAL();
+        if(!pTaskHandle->event && events && pTaskHandle != ZMOS_KERNEL->activeTask)
+        {
+            zmos_taskReadyInsert(pTaskHandle, false);
+        }
+#if ZMOS_TASK_EVENT_COUNT
+        zmos_taskEventCount(pTaskHandle, events);
+#endif
+#if ZMOS_TASK_LATENCY
+        zmos_taskLatencyStamp(pTaskHandle, events & ~pTaskHandle->event);
+#endif
         pTaskHandle->event |= events;
         ZMOS_EXIT_CRITICAL();
+        ZMOS_TRACE_POINT(ZMOS_TRACE_EVENT_SET, pTaskHandle, events, 0);
         return ZMOS_TASK_SUCCESS;
     }
     return ZMOS_TASK_ERROR_PARAM;
@@ -227,136 +424,1564 @@ taskReslt_t zmos_clearTaskEvent(zmos_taskHandle_t pTaskHandle, uTaskEvent_t even
 {
     if(pTaskHandle)
     {
+        ZMOS_TRACE_POINT(ZMOS_TRACE_EVENT_CLEAR, pTaskHandle, events, 0);
         ZMOS_ENTER_CRITICAL();
+        if(pTaskHandle->event && !(pTaskHandle->event & ~events) && pTaskHandle != ZMOS_KERNEL->activeTask)
+        {
+            zmos_taskReadyRemove(pTaskHandle);
+        }
         pTaskHandle->event &= ~events;
+#if ZMOS_TASK_EVENT_COUNT
+        //Occurrences of the cleared events are discarded.
+        events &= pTaskHandle->countEvents;
+        while(events)
+        {
+            pTaskHandle->eventCounters[ZMOS_CTZ(events)] = 0;
+            events &= events - 1;
+        }
+#endif
         ZMOS_EXIT_CRITICAL();
         return ZMOS_TASK_SUCCESS;
     }
     return ZMOS_TASK_ERROR_PARAM;
 }
 /*****************************************************************
-* FUNCTION: zmos_setIdleTaskFunction
+* FUNCTION: zmos_setTaskPriority
 *
 * DESCRIPTION:
-*     This function to set the idle task function.
+*     This function to change the task priority.
 * INPUTS:
-*     func : idle task function.
+*     pTaskHandle : The handle of the task.
+*     priority : New priority(0 ~ ZMOS_TASK_PRIORITY_HIGHEST).
 * RETURNS:
-*     null
+*     0 : Success (ZMOS_TASK_SUCCESS).
+*     other : ref ZMOS task return cordes.
 * NOTE:
 *     null
 *****************************************************************/
-void zmos_setIdleTaskFunction(idleTaskFunc func)
+taskReslt_t zmos_setTaskPriority(zmos_taskHandle_t pTaskHandle, taskPriority_t priority)
 {
-    zmosIdleTaskFunc  = func;
+    if(pTaskHandle && priority <= ZMOS_TASK_PRIORITY_HIGHEST)
+    {
+        ZMOS_ENTER_CRITICAL();
+        if(pTaskHandle->event && pTaskHandle != ZMOS_KERNEL->activeTask)
+        {
+            zmos_taskReadyRemove(pTaskHandle);
+            pTaskHandle->priority = priority;
+            zmos_taskReadyInsert(pTaskHandle, false);
+        }
+        else
+        {
+            pTaskHandle->priority = priority;
+        }
+        ZMOS_EXIT_CRITICAL();
+        return ZMOS_TASK_SUCCESS;
+    }
+    return ZMOS_TASK_ERROR_PARAM;
 }
 /*****************************************************************
-* FUNCTION: zmos_getCurrentTaskHandle
+* FUNCTION: zmos_setTaskEventCounter
 *
 * DESCRIPTION:
-*     This function to gets the handle to the current task.
+*     This function to enable counting of task events.
 * INPUTS:
-*     null
+*     pTaskHandle : The handle of the task.
+*     events : The events to count.
+*     counters : Counter array of ZMOS_TASK_EVENT_NUM_MAX, indexed
+*                  by event bit. NULL to disable counting.
 * RETURNS:
-*     Current task handle.
-*     NULL : No tasks are currently running.
+*     0 : Success (ZMOS_TASK_SUCCESS).
+*     other : ref ZMOS task return cordes.
 * NOTE:
-*     null
+*     Each zmos_setTaskEvent of a counted event increases its
+*     counter, the counter saturates at 255.
 *****************************************************************/
-zmos_taskHandle_t zmos_getCurrentTaskHandle(void)
+taskReslt_t zmos_setTaskEventCounter(zmos_taskHandle_t pTaskHandle, uTaskEvent_t events, uint8_t *counters)
 {
-    return activeTask;
+#if ZMOS_TASK_EVENT_COUNT
+    if(pTaskHandle)
+    {
+        if(counters)
+        {
+            memset(counters, 0, ZMOS_TASK_EVENT_NUM_MAX);
+        }
+        ZMOS_ENTER_CRITICAL();
+        pTaskHandle->countEvents = counters ? events : 0;
+        pTaskHandle->eventCounters = counters;
+        ZMOS_EXIT_CRITICAL();
+        return ZMOS_TASK_SUCCESS;
+    }
+    return ZMOS_TASK_ERROR_PARAM;
+#else
+    return ZMOS_TASK_FAILD;
+#endif
 }
 /*****************************************************************
-* FUNCTION: zmos_taskStartScheduler
+* FUNCTION: zmos_takeTaskEventCount
 *
 * DESCRIPTION:
-*     This function performs task scheduling.
+*     This function to read and clear the count of a task event.
 * INPUTS:
+*     pTaskHandle : The handle of the task, NULL is the current task.
+*     event : The event to read(only one bit).
+* RETURNS:
+*     The number of times the event was set since last taken.
+* NOTE:
 *     null
+*****************************************************************/
+uint8_t zmos_takeTaskEventCount(zmos_taskHandle_t pTaskHandle, uTaskEvent_t event)
+{
+    uint8_t count = 0;
+#if ZMOS_TASK_EVENT_COUNT
+    if(pTaskHandle == NULL)
+    {
+        pTaskHandle = ZMOS_KERNEL->activeTask;
+    }
+    if(pTaskHandle && (pTaskHandle->countEvents & event))
+    {
+        uint8_t bit = ZMOS_CTZ(event);
+        
+        ZMOS_ENTER_CRITICAL();
+        count = pTaskHandle->eventCounters[bit];
+        pTaskHandle->eventCounters[bit] = 0;
+        ZMOS_EXIT_CRITICAL();
+    }
+#endif
+    return count;
+}
+/*****************************************************************
+* FUNCTION: zmos_getTaskMergedEvents
+*
+* DESCRIPTION:
+*     This function to get the number of merged event signals.
+* INPUTS:
+*     pTaskHandle : The handle of the task.
 * RETURNS:
+*     The number of times an event was set while it was still pending.
+* NOTE:
 *     null
+*****************************************************************/
+uint32_t zmos_getTaskMergedEvents(zmos_taskHandle_t pTaskHandle)
+{
+#if ZMOS_TASK_EVENT_COUNT
+    if(pTaskHandle)
+    {
+        return pTaskHandle->mergedEvents;
+    }
+#endif
+    return 0;
+}
+#if ZMOS_TASK_STATS
+/*****************************************************************
+* FUNCTION: zmos_getTaskStats
+*
+* DESCRIPTION:
+*     This function to get a snapshot of the task statistics.
+* INPUTS:
+*     pTaskHandle : The handle of the task.
+*     pStats : Return the statistics.
+* RETURNS:
+*     0 : Success (ZMOS_TASK_SUCCESS).
+*     other : ref ZMOS task return cordes.
 * NOTE:
-*     Shouldn't be called from anywhere else.
+*     null
 *****************************************************************/
-void zmos_taskStartScheduler(void)
+taskReslt_t zmos_getTaskStats(zmos_taskHandle_t pTaskHandle, zmos_taskStats_t *pStats)
 {
-    zmos_taskHandle_t pNextTask;
-        
-    pNextTask = zmos_getReadyTask();
-    
-    if(pNextTask)
+    if(pTaskHandle && pStats)
     {
-        uTaskEvent_t events;
-        
         ZMOS_ENTER_CRITICAL();
-        events = pNextTask->event;
-        pNextTask->event = 0;
+        *pStats = pTaskHandle->stats;
         ZMOS_EXIT_CRITICAL();
-        
-        activeTask = pNextTask;
-        events = pNextTask->taskFunc(events);
-        activeTask = NULL;
-        
+        return ZMOS_TASK_SUCCESS;
+    }
+    return ZMOS_TASK_ERROR_PARAM;
+}
+/*****************************************************************
+* FUNCTION: zmos_getIdleStats
+*
+* DESCRIPTION:
+*     This function to get a snapshot of the idle function statistics.
+* INPUTS:
+*     pStats : Return the statistics.
+* RETURNS:
+*     0 : Success (ZMOS_TASK_SUCCESS).
+*     other : ref ZMOS task return cordes.
+* NOTE:
+*     null
+*****************************************************************/
+taskReslt_t zmos_getIdleStats(zmos_taskStats_t *pStats)
+{
+    if(pStats)
+    {
         ZMOS_ENTER_CRITICAL();
-        pNextTask->event |= events;
+        *pStats = ZMOS_KERNEL->idleStats;
         ZMOS_EXIT_CRITICAL();
+        return ZMOS_TASK_SUCCESS;
+    }
+    return ZMOS_TASK_ERROR_PARAM;
+}
+/*****************************************************************
+* FUNCTION: zmos_resetTaskStats
+*
+* DESCRIPTION:
+*     This function to reset the task statistics.
+* INPUTS:
+*     pTaskHandle : The handle of the task, NULL to reset all tasks and idle.
+* RETURNS:
+*     0 : Success (ZMOS_TASK_SUCCESS).
+*     other : ref ZMOS task return cordes.
+* NOTE:
+*     null
+*****************************************************************/
+taskReslt_t zmos_resetTaskStats(zmos_taskHandle_t pTaskHandle)
+{
+    ZMOS_ENTER_CRITICAL();
+    if(pTaskHandle)
+    {
+        memset(&pTaskHandle->stats, 0, sizeof(zmos_taskStats_t));
     }
     else
     {
-        if(zmosIdleTaskFunc) zmosIdleTaskFunc();
+        zmosTaskList_t *srchTask = ZMOS_KERNEL->taskListHead;
+        
+        while(srchTask)
+        {
+            memset(&srchTask->taskHandle.stats, 0, sizeof(zmos_taskStats_t));
+            srchTask = srchTask->next;
+        }
+        for(uint16_t i = 0; i < zmos_getStaticTaskNum(); i++)
+        {
+            memset(&zmos_getTaskHandleByIndex(i)->stats, 0, sizeof(zmos_taskStats_t));
+        }
+        memset(&ZMOS_KERNEL->idleStats, 0, sizeof(zmos_taskStats_t));
     }
+    ZMOS_EXIT_CRITICAL();
+    return ZMOS_TASK_SUCCESS;
 }
+#endif
+#if ZMOS_TASK_LATENCY
 /*****************************************************************
-* FUNCTION: zmos_checkTaskIsIdle
+* FUNCTION: zmos_setTaskLatencyRecord
 *
 * DESCRIPTION:
-*     This function to check task is idle.
+*     This function to attach the latency record to the task.
 * INPUTS:
-*     null
+*     pTaskHandle : The handle of the task.
+*     pLatency : The latency record, NULL to stop recording.
 * RETURNS:
-*     0:task idle
-*     1:task busy
+*     0 : Success (ZMOS_TASK_SUCCESS).
+*     other : ref ZMOS task return cordes.
 * NOTE:
-*     null
+*     Events already pending are not recorded.
 *****************************************************************/
-uint8_t zmos_checkTaskIsIdle(void)
+taskReslt_t zmos_setTaskLatencyRecord(zmos_taskHandle_t pTaskHandle, zmos_taskLatency_t *pLatency)
 {
-    if(zmos_getReadyTask())
+    if(pTaskHandle)
     {
-        return 1;
+        ZMOS_ENTER_CRITICAL();
+        pTaskHandle->latency = pLatency;
+        ZMOS_EXIT_CRITICAL();
+        return zmos_resetTaskLatency(pTaskHandle);
     }
-    return 0;
+    return ZMOS_TASK_ERROR_PARAM;
 }
 /*****************************************************************
-* FUNCTION: zmos_getReadyTask
+* FUNCTION: zmos_resetTaskLatency
 *
 * DESCRIPTION:
-*     ZMOS Get the registered ready task.
+*     This function to reset the latency record of the task.
 * INPUTS:
-*     null
+*     pTaskHandle : The handle of the task.
 * RETURNS:
-*     Task handle.
+*     0 : Success (ZMOS_TASK_SUCCESS).
+*     other : ref ZMOS task return cordes.
 * NOTE:
 *     null
 *****************************************************************/
-static zmos_taskHandle_t zmos_getReadyTask(void)
+taskReslt_t zmos_resetTaskLatency(zmos_taskHandle_t pTaskHandle)
 {
-    zmosTaskList_t *srchTask;
-    zmos_task_t *task = NULL;
-    
-    srchTask = taskListHead;
-    
-    while(srchTask)
+    if(pTaskHandle)
     {
-        if(srchTask->taskHandle.event)
+        ZMOS_ENTER_CRITICAL();
+        if(pTaskHandle->latency)
         {
-            task = &srchTask->taskHandle;
+            zmos_taskLatency_t *pLatency = pTaskHandle->latency;
+            uint32_t now = bsp_getCycleCount();
+            
+            memset(pLatency->bucket, 0, sizeof(pLatency->bucket));
+            pLatency->count = 0;
+            pLatency->minLatency = 0xFFFFFFFF;
+            pLatency->maxLatency = 0;
+            //Pending events are measured from now.
+            for(uint8_t i = 0; i < ZMOS_TASK_EVENT_NUM_MAX; i++)
+            {
+                pLatency->setTime[i] = now;
+            }
+        }
+        ZMOS_EXIT_CRITICAL();
+        return ZMOS_TASK_SUCCESS;
+    }
+    return ZMOS_TASK_ERROR_PARAM;
+}
+/*****************************************************************
+* FUNCTION: zmos_getTaskLatencyPercentile
+*
+* DESCRIPTION:
+*     This function to get the latency percentile of the task.
+* INPUTS:
+*     pTaskHandle : The handle of the task.
+*     percent : The percentile(1 ~ 100).
+* RETURNS:
+*     The upper bound of the histogram bucket of the percentile.
+*     0 : No latency recorded.
+* NOTE:
+*     null
+*****************************************************************/
+uint32_t zmos_getTaskLatencyPercentile(zmos_taskHandle_t pTaskHandle, uint8_t percent)
+{
+    uint32_t latency = 0;
+    
+    if(pTaskHandle && pTaskHandle->latency && percent)
+    {
+        zmos_taskLatency_t *pLatency = pTaskHandle->latency;
+        uint32_t target;
+        uint32_t sum = 0;
+        
+        ZMOS_ENTER_CRITICAL();
+        if(pLatency->count)
+        {
+            if(percent > 100) percent = 100;
+            //Rank of the percentile, round up.
+            target = (uint32_t)(((uint64_t)pLatency->count * percent + 99) / 100);
+            for(uint8_t i = 0; i < ZMOS_TASK_LATENCY_BUCKET_NUM; i++)
+            {
+                sum += pLatency->bucket[i];
+                if(sum >= target)
+                {
+                    latency = i ? (uint32_t)(((uint64_t)1 << i) - 1) : 0;
+                    break;
+                }
+            }
+            latency = ZMOS_GET_MIN(latency, pLatency->maxLatency);
+        }
+        ZMOS_EXIT_CRITICAL();
+    }
+    return latency;
+}
+#endif
+#if ZMOS_TASK_BUDGET
+/*****************************************************************
+* FUNCTION: zmos_setTaskBudget
+*
+* DESCRIPTION:
+*     This function to set the execution budget of the task.
+* INPUTS:
+*     pTaskHandle : The handle of the task, NULL to set the default
+*                   budget of all tasks.
+*     budget : The budget in bsp_getCycleCount unit, 0 of the task
+*              uses the default budget, 0 of the default is no budget.
+* RETURNS:
+*     0 : Success (ZMOS_TASK_SUCCESS).
+*     other : ref ZMOS task return cordes.
+* NOTE:
+*     The default budget is ZMOS_TASK_BUDGET_DEFAULT.
+*****************************************************************/
+taskReslt_t zmos_setTaskBudget(zmos_taskHandle_t pTaskHandle, uint32_t budget)
+{
+    if(pTaskHandle)
+    {
+        pTaskHandle->budget = budget;
+    }
+    else
+    {
+        ZMOS_KERNEL->budgetDefault = budget;
+    }
+    return ZMOS_TASK_SUCCESS;
+}
+/*****************************************************************
+* FUNCTION: zmos_setTaskBudgetHook
+*
+* DESCRIPTION:
+*     This function to set the hooks called when a task is over
+*     the budget.
+* INPUTS:
+*     overrunHook : Called on each overrun, NULL is none.
+*     escalateHook : Called when a task is over the budget
+*                    ZMOS_TASK_BUDGET_ESCALATE times in a row, NULL is none.
+* RETURNS:
+*     null
+* NOTE:
+*     The hooks are called by the scheduler after the dispatch,
+*     the escalate hook may log the fault and reset the system
+*     or stop feeding the watchdog.
+*****************************************************************/
+void zmos_setTaskBudgetHook(zmosBudgetHook_t overrunHook, zmosBudgetHook_t escalateHook)
+{
+    ZMOS_KERNEL->budgetHook = overrunHook;
+    ZMOS_KERNEL->budgetEscalateHook = escalateHook;
+}
+/*****************************************************************
+* FUNCTION: zmos_getTaskBudgetStats
+*
+* DESCRIPTION:
+*     This function to get a snapshot of the task budget statistics.
+* INPUTS:
+*     pTaskHandle : The handle of the task.
+*     pStats : Return the statistics.
+* RETURNS:
+*     0 : Success (ZMOS_TASK_SUCCESS).
+*     other : ref ZMOS task return cordes.
+* NOTE:
+*     null
+*****************************************************************/
+taskReslt_t zmos_getTaskBudgetStats(zmos_taskHandle_t pTaskHandle, zmos_taskBudgetStats_t *pStats)
+{
+    if(pTaskHandle && pStats)
+    {
+        ZMOS_ENTER_CRITICAL();
+        *pStats = pTaskHandle->budgetStats;
+        ZMOS_EXIT_CRITICAL();
+        return ZMOS_TASK_SUCCESS;
+    }
+    return ZMOS_TASK_ERROR_PARAM;
+}
+/*****************************************************************
+* FUNCTION: zmos_resetTaskBudgetStats
+*
+* DESCRIPTION:
+*     This function to reset the task budget statistics.
+* INPUTS:
+*     pTaskHandle : The handle of the task, NULL to reset all tasks.
+* RETURNS:
+*     0 : Success (ZMOS_TASK_SUCCESS).
+*     other : ref ZMOS task return cordes.
+* NOTE:
+*     null
+*****************************************************************/
+taskReslt_t zmos_resetTaskBudgetStats(zmos_taskHandle_t pTaskHandle)
+{
+    ZMOS_ENTER_CRITICAL();
+    if(pTaskHandle)
+    {
+        memset(&pTaskHandle->budgetStats, 0, sizeof(zmos_taskBudgetStats_t));
+    }
+    else
+    {
+        zmosTaskList_t *srchTask = ZMOS_KERNEL->taskListHead;
+        
+        while(srchTask)
+        {
+            memset(&srchTask->taskHandle.budgetStats, 0, sizeof(zmos_taskBudgetStats_t));
+            srchTask = srchTask->next;
+        }
+        for(uint16_t i = 0; i < zmos_getStaticTaskNum(); i++)
+        {
+            memset(&zmos_getTaskHandleByIndex(i)->budgetStats, 0, sizeof(zmos_taskBudgetStats_t));
+        }
+    }
+    ZMOS_EXIT_CRITICAL();
+    return ZMOS_TASK_SUCCESS;
+}
+#endif
+#if ZMOS_TASK_PERIODIC
+/*****************************************************************
+* FUNCTION: zmos_setTaskPeriodic
+*
+* DESCRIPTION:
+*     This function to make the task periodic, the event is set to
+*     the task as a job each period.
+* INPUTS:
+*     pTaskHandle : The handle of the task, NULL is the current task.
+*     period : The period in timer clock(ms), 0 to stop.
+*     deadline : The deadline from the release, 0 is the period.
+*     offset : The first release from now.
+*     event : The event of the job.
+* RETURNS:
+*     0 : Success (ZMOS_TASK_SUCCESS).
+*     other : ref ZMOS task return cordes.
+* NOTE:
+*     The releases are at fixed times of the period, the job is
+*     done when the task returns with the event cleared. Setting
+*     again restarts the releases and resets the statistics.
+*****************************************************************/
+taskReslt_t zmos_setTaskPeriodic(zmos_taskHandle_t pTaskHandle, uint32_t period, uint32_t deadline, 
+                                 uint32_t offset, uTaskEvent_t event)
+{
+    if(pTaskHandle == NULL)
+    {
+        pTaskHandle = ZMOS_KERNEL->activeTask;
+    }
+    if(!pTaskHandle || (period && !event)) return ZMOS_TASK_ERROR_PARAM;
+    
+    ZMOS_ENTER_CRITICAL();
+    zmos_taskPeriodicRemove(pTaskHandle);
+    if(period)
+    {
+        pTaskHandle->period = period;
+        pTaskHandle->relDeadline = deadline ? deadline : period;
+        pTaskHandle->release = zmos_getTimerClock() + offset;
+        pTaskHandle->jobEvent = event;
+        memset(&pTaskHandle->deadlineStats, 0, sizeof(zmos_taskDeadlineStats_t));
+        pTaskHandle->periodicNext = ZMOS_KERNEL->periodicList;
+        ZMOS_KERNEL->periodicList = pTaskHandle;
+    }
+    ZMOS_EXIT_CRITICAL();
+    
+    return ZMOS_TASK_SUCCESS;
+}
+/*****************************************************************
+* FUNCTION: zmos_getTaskDeadlineStats
+*
+* DESCRIPTION:
+*     This function to get a snapshot of the task deadline statistics.
+* INPUTS:
+*     pTaskHandle : The handle of the task.
+*     pStats : Return the statistics.
+* RETURNS:
+*     0 : Success (ZMOS_TASK_SUCCESS).
+*     other : ref ZMOS task return cordes.
+* NOTE:
+*     null
+*****************************************************************/
+taskReslt_t zmos_getTaskDeadlineStats(zmos_taskHandle_t pTaskHandle, zmos_taskDeadlineStats_t *pStats)
+{
+    if(pTaskHandle && pStats)
+    {
+        ZMOS_ENTER_CRITICAL();
+        *pStats = pTaskHandle->deadlineStats;
+        ZMOS_EXIT_CRITICAL();
+        return ZMOS_TASK_SUCCESS;
+    }
+    return ZMOS_TASK_ERROR_PARAM;
+}
+/*****************************************************************
+* FUNCTION: zmos_resetTaskDeadlineStats
+*
+* DESCRIPTION:
+*     This function to reset the task deadline statistics.
+* INPUTS:
+*     pTaskHandle : The handle of the task, NULL to reset all tasks.
+* RETURNS:
+*     0 : Success (ZMOS_TASK_SUCCESS).
+*     other : ref ZMOS task return cordes.
+* NOTE:
+*     null
+*****************************************************************/
+taskReslt_t zmos_resetTaskDeadlineStats(zmos_taskHandle_t pTaskHandle)
+{
+    ZMOS_ENTER_CRITICAL();
+    if(pTaskHandle)
+    {
+        memset(&pTaskHandle->deadlineStats, 0, sizeof(zmos_taskDeadlineStats_t));
+    }
+    else
+    {
+        //Only the periodic tasks have the statistics.
+        for(pTaskHandle = ZMOS_KERNEL->periodicList; pTaskHandle; pTaskHandle = pTaskHandle->periodicNext)
+        {
+            memset(&pTaskHandle->deadlineStats, 0, sizeof(zmos_taskDeadlineStats_t));
+        }
+    }
+    ZMOS_EXIT_CRITICAL();
+    return ZMOS_TASK_SUCCESS;
+}
+/*****************************************************************
+* FUNCTION: zmos_taskPeriodicNextTimeout
+*
+* DESCRIPTION:
+*     This function to get the time to the next job release.
+* INPUTS:
+*     null
+* RETURNS:
+*     The time to the next release.
+*     TIMER_MAX_TIMEOUT : No periodic tasks.
+* NOTE:
+*     Used to wake up from the low power at the release.
+*****************************************************************/
+uint32_t zmos_taskPeriodicNextTimeout(void)
+{
+    zmos_taskHandle_t pTask;
+    uint32_t timeout = TIMER_MAX_TIMEOUT;
+    uint32_t clock = zmos_getTimerClock();
+    
+    ZMOS_ENTER_CRITICAL();
+    for(pTask = ZMOS_KERNEL->periodicList; pTask; pTask = pTask->periodicNext)
+    {
+        if((int32_t)(pTask->release - clock) <= 0)
+        {
+            timeout = 0;
+            break;
+        }
+        if(pTask->release - clock < timeout)
+        {
+            timeout = pTask->release - clock;
+        }
+    }
+    ZMOS_EXIT_CRITICAL();
+    
+    return timeout;
+}
+#endif
+/*****************************************************************
+* FUNCTION: zmos_setIdleTaskFunction
+*
+* DESCRIPTION:
+*     This function to set the idle task function.
+* INPUTS:
+*     func : idle task function.
+* RETURNS:
+*     null
+* NOTE:
+*     null
+*****************************************************************/
+void zmos_setIdleTaskFunction(idleTaskFunc func)
+{
+    ZMOS_KERNEL->idleFunc  = func;
+}
+/*****************************************************************
+* FUNCTION: zmos_getCurrentTaskHandle
+*
+* DESCRIPTION:
+*     This function to gets the handle to the current task.
+* INPUTS:
+*     null
+* RETURNS:
+*     Current task handle.
+*     NULL : No tasks are currently running.
+* NOTE:
+*     null
+*****************************************************************/
+zmos_taskHandle_t zmos_getCurrentTaskHandle(void)
+{
+    return ZMOS_KERNEL->activeTask;
+}
+#if ZMOS_TASK_CONTEXT
+/*****************************************************************
+* FUNCTION: zmos_getCurrentTaskContext
+*
+* DESCRIPTION:
+*     This function to get the context of the current task.
+* INPUTS:
+*     null
+* RETURNS:
+*     The context of the current task.
+*     NULL : No tasks are currently running or no context.
+* NOTE:
+*     null
+*****************************************************************/
+void *zmos_getCurrentTaskContext(void)
+{
+    return ZMOS_KERNEL->activeTask ? ZMOS_KERNEL->activeTask->context : NULL;
+}
+#endif
+/*****************************************************************
+* FUNCTION: zmos_taskStartScheduler
+*
+* DESCRIPTION:
+*     This function performs task scheduling.
+* INPUTS:
+*     null
+* RETURNS:
+*     null
+* NOTE:
+*     Shouldn't be called from anywhere else.
+*****************************************************************/
+void zmos_taskStartScheduler(void)
+{
+    zmos_taskHandle_t pNextTask;
+    uTaskEvent_t events = 0;
+#if ZMOS_TASK_STATS
+    uint32_t startCycle;
+#endif
+    
+#if ZMOS_TASK_PERIODIC
+    //Release the jobs of the periodic tasks
+    zmos_taskPeriodicRelease();
+#endif
+    ZMOS_ENTER_CRITICAL();
+    pNextTask = zmos_getReadyTask();
+    if(pNextTask)
+    {
+        zmos_taskReadyRemove(pNextTask);
+        events = pNextTask->event;
+        pNextTask->event = 0;
+        ZMOS_KERNEL->activeTask = pNextTask;
+#if ZMOS_TASK_LATENCY
+        zmos_taskLatencyRecord(pNextTask, events);
+#endif
+    }
+    ZMOS_EXIT_CRITICAL();
+    
+    if(pNextTask)
+    {
+        zmos_taskRun(pNextTask, events);
+    }
+    else
+    {
+#if ZMOS_USE_JOB
+        //Run the background jobs in the idle time
+        zmos_jobProcess();
+#endif
+#if ZMOS_TASK_STATS
+        if(ZMOS_KERNEL->idleFunc)
+        {
+            startCycle = bsp_getCycleCount();
+            ZMOS_KERNEL->idleFunc();
+            startCycle = bsp_getCycleCount() - startCycle;
+            ZMOS_ENTER_CRITICAL();
+            zmos_taskStatsUpdate(&ZMOS_KERNEL->idleStats, startCycle);
+            ZMOS_EXIT_CRITICAL();
+        }
+#else
+        if(ZMOS_KERNEL->idleFunc) ZMOS_KERNEL->idleFunc();
+#endif
+#if ZMOS_USE_IDLE_HOOK
+        //Run the idle hooks that fit the time to the next timer
+        zmos_idleHookProcess();
+#endif
+    }
+}
+#if ZMOS_USE_CYCLIC
+/*****************************************************************
+* FUNCTION: zmos_taskRunNow
+*
+* DESCRIPTION:
+*     This function to run the task at once with the events and
+*     the pending events of it.
+* INPUTS:
+*     pTaskHandle : The handle of the task.
+*     events : The events to run.
+* RETURNS:
+*     null
+* NOTE:
+*     Called by the cyclic executive out of the tasks, the task
+*     leaves the ready list as it is dispatched.
+*****************************************************************/
+void zmos_taskRunNow(zmos_taskHandle_t pTaskHandle, uTaskEvent_t events)
+{
+    if(!pTaskHandle || ZMOS_KERNEL->activeTask) return;
+    
+    ZMOS_ENTER_CRITICAL();
+    if(pTaskHandle->event)
+    {
+        zmos_taskReadyRemove(pTaskHandle);
+#if ZMOS_TASK_LATENCY
+        zmos_taskLatencyRecord(pTaskHandle, pTaskHandle->event);
+#endif
+        events |= pTaskHandle->event;
+        pTaskHandle->event = 0;
+    }
+    ZMOS_KERNEL->activeTask = pTaskHandle;
+    ZMOS_EXIT_CRITICAL();
+    
+    zmos_taskRun(pTaskHandle, events);
+}
+#endif
+/*****************************************************************
+* FUNCTION: zmos_checkTaskIsIdle
+*
+* DESCRIPTION:
+*     This function to check task is idle.
+* INPUTS:
+*     null
+* RETURNS:
+*     0:task idle
+*     1:task busy
+* NOTE:
+*     null
+*****************************************************************/
+uint8_t zmos_checkTaskIsIdle(void)
+{
+    if(ZMOS_KERNEL->readyPriorityMap)
+    {
+        return 1;
+    }
+#if ZMOS_USE_ISR
+    return zmos_isrCheckPending();
+#else
+    return 0;
+#endif
+}
+/*****************************************************************
+* FUNCTION: zmos_getStaticTaskNum
+*
+* DESCRIPTION:
+*     This function to get the number of static tasks.
+* INPUTS:
+*     null
+* RETURNS:
+*     Number of tasks defined by ZMOS_TASK_DEFINE.
+* NOTE:
+*     null
+*****************************************************************/
+uint16_t zmos_getStaticTaskNum(void)
+{
+#if (defined ZMOS_TASK_SECTION) && (ZMOS_TASK_SECTION)
+    return (uint16_t)ZMOS_TASK_SECTION_ITEM_COUNT;
+#else
+    return 0;
+#endif
+}
+/*****************************************************************
+* FUNCTION: zmos_getTaskIndex
+*
+* DESCRIPTION:
+*     This function to get the index of a static task.
+* INPUTS:
+*     pTaskHandle : The handle of the task.
+* RETURNS:
+*     The index of the task in the task section.
+*     ZMOS_TASK_INVALID_INDEX : Not a static task.
+* NOTE:
+*     null
+*****************************************************************/
+uint16_t zmos_getTaskIndex(zmos_taskHandle_t pTaskHandle)
+{
+#if (defined ZMOS_TASK_SECTION) && (ZMOS_TASK_SECTION)
+    zmos_taskHandle_t pFirst = ZMOS_TASK_SECTION_ITEM_GET(0);
+    
+    if(pTaskHandle >= pFirst && pTaskHandle < pFirst + ZMOS_TASK_SECTION_ITEM_COUNT)
+    {
+        return (uint16_t)(pTaskHandle - pFirst);
+    }
+#endif
+    return ZMOS_TASK_INVALID_INDEX;
+}
+/*****************************************************************
+* FUNCTION: zmos_getTaskHandleByIndex
+*
+* DESCRIPTION:
+*     This function to get the handle of a static task by index.
+* INPUTS:
+*     index : The index of the task in the task section.
+* RETURNS:
+*     Task handle.
+*     NULL : Index out of range.
+* NOTE:
+*     null
+*****************************************************************/
+zmos_taskHandle_t zmos_getTaskHandleByIndex(uint16_t index)
+{
+#if (defined ZMOS_TASK_SECTION) && (ZMOS_TASK_SECTION)
+    if(index < ZMOS_TASK_SECTION_ITEM_COUNT)
+    {
+        return ZMOS_TASK_SECTION_ITEM_GET(index);
+    }
+#endif
+    return NULL;
+}
+/*****************************************************************
+* FUNCTION: zmos_taskCreate
+*
+* DESCRIPTION:
+*     Create a task and add it to the task list.
+* INPUTS:
+*     taskFunc : Task function.
+*     eventTable : Event handler table.
+*     tableNum : Number of the event handlers.
+*     priority : Task priority.
+* RETURNS:
+*     Task handle.
+*     NULL : Out of memory.
+* NOTE:
+*     If the task function or event table is registered, 
+*     return the registered task.
+*****************************************************************/
+static zmos_taskHandle_t zmos_taskCreate(taskFunction_t taskFunc, const taskEventHandler_t *eventTable, 
+                                         uint8_t tableNum, taskPriority_t priority)
+{
+    zmosTaskList_t *newTask;
+    zmosTaskList_t *srchTask;
+    zmosTaskList_t *prevTask;
+    
+    srchTask = ZMOS_KERNEL->taskListHead;
+    
+    while(srchTask)
+    {
+        //Whether task is registered.
+        if((taskFunc && srchTask->taskHandle.taskFunc == taskFunc) ||
+           (eventTable && srchTask->taskHandle.eventTable == eventTable))
+        {
+            return &srchTask->taskHandle;
+        }
+        prevTask = srchTask;
+        srchTask = srchTask->next;
+    }
+    
+    newTask = (zmosTaskList_t *)zmos_malloc(sizeof(zmosTaskList_t));
+    if(newTask)
+    {
+        newTask->next = NULL;
+        newTask->taskHandle.event = 0;
+        newTask->taskHandle.taskFunc = taskFunc;
+        newTask->taskHandle.eventTable = eventTable;
+        newTask->taskHandle.eventTableNum = tableNum;
+        newTask->taskHandle.priority = priority;
+        newTask->taskHandle.readyNext = NULL;
+        newTask->taskHandle.readyPrev = NULL;
+#if ZMOS_TASK_CONTEXT
+        newTask->taskHandle.contextFunc = NULL;
+        newTask->taskHandle.context = NULL;
+#endif
+#if ZMOS_USE_MSG
+        newTask->taskHandle.msgHead = NULL;
+        newTask->taskHandle.msgTail = NULL;
+#endif
+#if ZMOS_USE_ISR
+        newTask->taskHandle.isrEvent = 0;
+        newTask->taskHandle.isrNext = NULL;
+#endif
+#if ZMOS_TASK_EVENT_COUNT
+        newTask->taskHandle.countEvents = 0;
+        newTask->taskHandle.eventCounters = NULL;
+        newTask->taskHandle.mergedEvents = 0;
+#endif
+#if ZMOS_TASK_STATS
+        memset(&newTask->taskHandle.stats, 0, sizeof(zmos_taskStats_t));
+#endif
+#if ZMOS_TASK_LATENCY
+        newTask->taskHandle.latency = NULL;
+#endif
+#if ZMOS_TASK_BUDGET
+        newTask->taskHandle.budget = 0;
+        memset(&newTask->taskHandle.budgetStats, 0, sizeof(zmos_taskBudgetStats_t));
+#endif
+#if ZMOS_TASK_PERIODIC
+        newTask->taskHandle.period = 0;
+        newTask->taskHandle.jobState = 0;
+        newTask->taskHandle.periodicNext = NULL;
+        memset(&newTask->taskHandle.deadlineStats, 0, sizeof(zmos_taskDeadlineStats_t));
+#endif
+#if ZMOS_TIMER_STORE != ZMOS_TIMER_STORE_LIST
+        newTask->taskHandle.timerList = NULL;
+#endif
+        
+        /* Add to the linked list */
+        if(ZMOS_KERNEL->taskListHead)
+        {
+            prevTask->next = newTask;
+        }
+        else ZMOS_KERNEL->taskListHead = newTask;
+        
+        return &newTask->taskHandle;
+    }
+    return NULL;
+}
+/*****************************************************************
+* FUNCTION: zmos_taskRun
+*
+* DESCRIPTION:
+*     Dispatch the events to the active task, then put the events
+*     left back to the task.
+* INPUTS:
+*     pTask : The active task.
+*     events : The events to dispatch.
+* RETURNS:
+*     null
+* NOTE:
+*     The task is the activeTask and not in the ready list.
+*****************************************************************/
+static void zmos_taskRun(zmos_taskHandle_t pTask, uTaskEvent_t events)
+{
+#if ZMOS_TASK_STATS || ZMOS_TASK_BUDGET
+    uint32_t startCycle;
+#endif
+#if ZMOS_TASK_BUDGET || ZMOS_TASK_PERIODIC
+    uTaskEvent_t runEvents = events;
+#endif
+#if ZMOS_TASK_BUDGET
+    uint32_t overrun = 0;
+    uint8_t budgetState = 0;
+#endif
+    
+    ZMOS_TRACE_POINT(ZMOS_TRACE_DISPATCH_BEGIN, pTask, events, 0);
+#if ZMOS_TASK_STATS || ZMOS_TASK_BUDGET
+    startCycle = bsp_getCycleCount();
+#endif
+    events = zmos_taskDispatch(pTask, events);
+#if ZMOS_TASK_STATS || ZMOS_TASK_BUDGET
+    startCycle = bsp_getCycleCount() - startCycle;
+#endif
+    ZMOS_TRACE_POINT(ZMOS_TRACE_DISPATCH_END, pTask, events, 0);
+    
+    ZMOS_ENTER_CRITICAL();
+    //The task may have been unregistered by itself.
+    if(ZMOS_KERNEL->activeTask == pTask)
+    {
+        ZMOS_KERNEL->activeTask = NULL;
+#if ZMOS_TASK_STATS
+        zmos_taskStatsUpdate(&pTask->stats, startCycle);
+        if(events)
+        {
+            ZMOS_U32_MAX_HOLD(pTask->stats.unprocessedCount);
+        }
+#endif
+#if ZMOS_TASK_BUDGET
+        budgetState = zmos_taskBudgetCheck(pTask, runEvents, startCycle, &overrun);
+#endif
+#if ZMOS_TASK_PERIODIC
+        //The job is done when its event is handled.
+        if((pTask->jobState & ZMOS_TASK_JOB_ACTIVE) && (runEvents & pTask->jobEvent) && !(events & pTask->jobEvent))
+        {
+            zmos_taskJobDone(pTask);
+        }
+#endif
+#if ZMOS_USE_MSG
+        //Messages not received yet.
+        if(pTask->msgHead)
+        {
+            events |= ZMOS_TASK_MSG_EVENT;
+        }
+#endif
+#if ZMOS_TASK_LATENCY
+        //The events set again are measured from now.
+        zmos_taskLatencyStamp(pTask, events & ~pTask->event);
+#endif
+        pTask->event |= events;
+        if(pTask->event)
+        {
+#if ZMOS_TASK_ROUND_ROBIN
+            //Give way to the other tasks of the same priority.
+            zmos_taskReadyInsert(pTask, false);
+#else
+            zmos_taskReadyInsert(pTask, true);
+#endif
+        }
+    }
+    ZMOS_EXIT_CRITICAL();
+#if ZMOS_TASK_BUDGET
+    //Report the overrun out of the critical.
+    if(budgetState && ZMOS_KERNEL->budgetHook)
+    {
+        ZMOS_KERNEL->budgetHook(pTask, runEvents, overrun);
+    }
+    if(budgetState > 1 && ZMOS_KERNEL->budgetEscalateHook)
+    {
+        ZMOS_KERNEL->budgetEscalateHook(pTask, runEvents, overrun);
+    }
+#endif
+}
+/*****************************************************************
+* FUNCTION: zmos_taskDispatch
+*
+* DESCRIPTION:
+*     Pass the events to the task function or event handlers.
+* INPUTS:
+*     pTask : The task to run.
+*     events : The events to handle.
+* RETURNS:
+*     The events not handled.
+* NOTE:
+*     null
+*****************************************************************/
+static uTaskEvent_t zmos_taskDispatch(zmos_taskHandle_t pTask, uTaskEvent_t events)
+{
+    if(pTask->eventTable)
+    {
+        uTaskEvent_t retEvents = 0;
+        
+        while(events)
+        {
+#if ZMOS_TASK_EVENT_TABLE_MSB_FIRST
+            uint8_t bit = ZMOS_HIGHEST_BIT(events);
+#else
+            uint8_t bit = ZMOS_CTZ(events);
+#endif
+            uTaskEvent_t event = (uTaskEvent_t)((uint32_t)1 << bit);
+            
+            events &= ~event;
+            if(bit < pTask->eventTableNum && pTask->eventTable[bit])
+            {
+                retEvents |= pTask->eventTable[bit](event);
+            }
+        }
+        return retEvents;
+    }
+#if ZMOS_TASK_CONTEXT
+    if(pTask->contextFunc)
+    {
+        return pTask->contextFunc(pTask->context, events);
+    }
+#endif
+    return pTask->taskFunc(events);
+}
+#if ZMOS_TASK_STATS
+/*****************************************************************
+* FUNCTION: zmos_taskStatsUpdate
+*
+* DESCRIPTION:
+*     Add a run to the statistics.
+* INPUTS:
+*     pStats : The statistics.
+*     runTime : Execution time of the run.
+* RETURNS:
+*     null
+* NOTE:
+*     null
+*****************************************************************/
+static void zmos_taskStatsUpdate(zmos_taskStats_t *pStats, uint32_t runTime)
+{
+    ZMOS_U32_MAX_HOLD(pStats->dispatchCount);
+    pStats->lastTime = runTime;
+    pStats->totalTime += runTime;
+    if(runTime > pStats->maxTime)
+    {
+        pStats->maxTime = runTime;
+    }
+}
+#endif
+#if ZMOS_TASK_LATENCY
+/*****************************************************************
+* FUNCTION: zmos_taskLatencyStamp
+*
+* DESCRIPTION:
+*     Record the set time of the new pending events.
+* INPUTS:
+*     pTask : The task.
+*     events : The new pending events.
+* RETURNS:
+*     null
+* NOTE:
+*     Must be called in critical.
+*****************************************************************/
+static void zmos_taskLatencyStamp(zmos_taskHandle_t pTask, uTaskEvent_t events)
+{
+    if(pTask->latency && events)
+    {
+        uint32_t now = bsp_getCycleCount();
+        
+        while(events)
+        {
+            pTask->latency->setTime[ZMOS_CTZ(events)] = now;
+            events &= events - 1;
+        }
+    }
+}
+/*****************************************************************
+* FUNCTION: zmos_taskLatencyRecord
+*
+* DESCRIPTION:
+*     Add the latency of the dispatched events to the histogram.
+* INPUTS:
+*     pTask : The task.
+*     events : The dispatched events.
+* RETURNS:
+*     null
+* NOTE:
+*     Must be called in critical.
+*****************************************************************/
+static void zmos_taskLatencyRecord(zmos_taskHandle_t pTask, uTaskEvent_t events)
+{
+    zmos_taskLatency_t *pLatency = pTask->latency;
+    
+    if(pLatency && events)
+    {
+        uint32_t now = bsp_getCycleCount();
+        
+        while(events)
+        {
+            uint32_t latency = now - pLatency->setTime[ZMOS_CTZ(events)];
+            uint8_t bucket = latency ? ZMOS_HIGHEST_BIT(latency) + 1 : 0;
+            
+            if(bucket >= ZMOS_TASK_LATENCY_BUCKET_NUM)
+            {
+                bucket = ZMOS_TASK_LATENCY_BUCKET_NUM - 1;
+            }
+            ZMOS_U32_MAX_HOLD(pLatency->bucket[bucket]);
+            ZMOS_U32_MAX_HOLD(pLatency->count);
+            if(latency < pLatency->minLatency) pLatency->minLatency = latency;
+            if(latency > pLatency->maxLatency) pLatency->maxLatency = latency;
+            events &= events - 1;
+        }
+    }
+}
+#endif
+#if ZMOS_TASK_BUDGET
+/*****************************************************************
+* FUNCTION: zmos_taskBudgetCheck
+*
+* DESCRIPTION:
+*     Check the execution time of the dispatch with the task budget.
+* INPUTS:
+*     pTask : The task.
+*     events : The events handled by the dispatch.
+*     runTime : Execution time of the dispatch.
+*     pOverrun : Return the time over the budget.
+* RETURNS:
+*     0 : Within the budget.
+*     1 : Over the budget.
+*     2 : Over the budget and escalate.
+* NOTE:
+*     Must be called in critical.
+*****************************************************************/
+static uint8_t zmos_taskBudgetCheck(zmos_taskHandle_t pTask, uTaskEvent_t events, uint32_t runTime, uint32_t *pOverrun)
+{
+    zmos_taskBudgetStats_t *pStats = &pTask->budgetStats;
+    uint32_t budget = pTask->budget ? pTask->budget : ZMOS_KERNEL->budgetDefault;
+    
+    if(!budget || runTime <= budget)
+    {
+        pStats->consecutiveCount = 0;
+        return 0;
+    }
+    *pOverrun = runTime - budget;
+    ZMOS_U32_MAX_HOLD(pStats->overrunCount);
+    ZMOS_U32_MAX_HOLD(pStats->consecutiveCount);
+    pStats->lastOverrun = *pOverrun;
+    pStats->lastEvents = events;
+    if(*pOverrun > pStats->maxOverrun)
+    {
+        pStats->maxOverrun = *pOverrun;
+    }
+#if ZMOS_TASK_BUDGET_ESCALATE > 0
+    //Escalate once when the overruns reach the limit in a row.
+    if(pStats->consecutiveCount == ZMOS_TASK_BUDGET_ESCALATE)
+    {
+        ZMOS_U32_MAX_HOLD(pStats->escalateCount);
+        return 2;
+    }
+#endif
+    return 1;
+}
+#endif
+#if ZMOS_TASK_PERIODIC
+/*****************************************************************
+* FUNCTION: zmos_taskPeriodicRelease
+*
+* DESCRIPTION:
+*     Release the jobs of the periodic tasks reached the release
+*     time, and count the active jobs over the deadline.
+* INPUTS:
+*     null
+* RETURNS:
+*     null
+* NOTE:
+*     The releases missed when the last job is not done are merged
+*     into the job.
+*****************************************************************/
+static void zmos_taskPeriodicRelease(void)
+{
+    zmos_taskHandle_t pTask;
+    zmos_taskDeadlineStats_t *pStats;
+    uint32_t clock = zmos_getTimerClock();
+    uint32_t skip;
+    
+    ZMOS_ENTER_CRITICAL();
+    for(pTask = ZMOS_KERNEL->periodicList; pTask; pTask = pTask->periodicNext)
+    {
+        pStats = &pTask->deadlineStats;
+        if(pTask->jobState == ZMOS_TASK_JOB_ACTIVE && (int32_t)(clock - pTask->deadline) > 0)
+        {
+            //Count the miss once when the job is over the deadline.
+            pTask->jobState |= ZMOS_TASK_JOB_MISSED;
+            ZMOS_U32_MAX_HOLD(pStats->missCount);
+        }
+        if((int32_t)(clock - pTask->release) < 0) continue;
+        
+        skip = (clock - pTask->release) / pTask->period;
+        if(pTask->jobState & ZMOS_TASK_JOB_ACTIVE)
+        {
+            //The last job isn't done at the release, it's missed.
+            if(!(pTask->jobState & ZMOS_TASK_JOB_MISSED))
+            {
+                ZMOS_U32_MAX_HOLD(pStats->missCount);
+            }
+            skip++;
+        }
+        pStats->skipCount += skip;
+        ZMOS_U32_MAX_HOLD(pStats->jobCount);
+        pTask->release += (clock - pTask->release) / pTask->period * pTask->period;
+        pTask->deadline = pTask->release + pTask->relDeadline;
+        pTask->release += pTask->period;
+        pTask->jobState = ZMOS_TASK_JOB_ACTIVE;
+        
+        if(pTask != ZMOS_KERNEL->activeTask)
+        {
+            //Move the task in the ready list by the new deadline.
+            if(pTask->event)
+            {
+                zmos_taskReadyRemove(pTask);
+            }
+            zmos_taskReadyInsert(pTask, false);
+        }
+#if ZMOS_TASK_LATENCY
+        zmos_taskLatencyStamp(pTask, pTask->jobEvent & ~pTask->event);
+#endif
+        pTask->event |= pTask->jobEvent;
+        ZMOS_TRACE_POINT(ZMOS_TRACE_EVENT_SET, pTask, pTask->jobEvent, 0);
+    }
+    ZMOS_EXIT_CRITICAL();
+}
+/*****************************************************************
+* FUNCTION: zmos_taskPeriodicRemove
+*
+* DESCRIPTION:
+*     Remove the task from the periodic tasks.
+* INPUTS:
+*     pTask : The task to remove.
+* RETURNS:
+*     null
+* NOTE:
+*     Must be called in critical.
+*****************************************************************/
+static void zmos_taskPeriodicRemove(zmos_taskHandle_t pTask)
+{
+    zmos_taskHandle_t *ppTask = &ZMOS_KERNEL->periodicList;
+    
+    while(*ppTask)
+    {
+        if(*ppTask == pTask)
+        {
+            *ppTask = pTask->periodicNext;
             break;
         }
-        srchTask = srchTask->next;
+        ppTask = &(*ppTask)->periodicNext;
+    }
+    pTask->periodicNext = NULL;
+    pTask->period = 0;
+    pTask->jobState = 0;
+}
+/*****************************************************************
+* FUNCTION: zmos_taskJobDone
+*
+* DESCRIPTION:
+*     Finish the job of the task and check its deadline.
+* INPUTS:
+*     pTask : The periodic task.
+* RETURNS:
+*     null
+* NOTE:
+*     The lateness is by the timer clock of the deadline, updated
+*     at each run of the main loop. Must be called in critical.
+*****************************************************************/
+static void zmos_taskJobDone(zmos_taskHandle_t pTask)
+{
+    zmos_taskDeadlineStats_t *pStats = &pTask->deadlineStats;
+    uint32_t lateness = zmos_getTimerClock() - pTask->deadline;
+    
+    if((int32_t)lateness > 0)
+    {
+        if(!(pTask->jobState & ZMOS_TASK_JOB_MISSED))
+        {
+            ZMOS_U32_MAX_HOLD(pStats->missCount);
+        }
+        pStats->lastLateness = lateness;
+        if(lateness > pStats->maxLateness)
+        {
+            pStats->maxLateness = lateness;
+        }
+    }
+    pTask->jobState = 0;
+}
+#endif
+#if ZMOS_TASK_PERIODIC && ZMOS_TASK_EDF
+/*****************************************************************
+* FUNCTION: zmos_taskEdfPosition
+*
+* DESCRIPTION:
+*     Get the position to insert the task in the ready list, the
+*     jobs are ahead of the other tasks by the earliest deadline.
+* INPUTS:
+*     pTask : The task to insert.
+*     head : Insert the task without job at the head.
+* RETURNS:
+*     The task to insert before.
+*     NULL : Insert at the tail.
+* NOTE:
+*     Must be called in critical, the list must not be empty.
+*****************************************************************/
+static zmos_taskHandle_t zmos_taskEdfPosition(zmos_taskHandle_t pTask, bool head)
+{
+    zmos_taskHandle_t pos = ZMOS_KERNEL->readyListHead[pTask->priority];
+    bool isJob = (pTask->jobState & ZMOS_TASK_JOB_ACTIVE) != 0;
+    
+    if(!isJob && !head) return NULL;
+    
+    while(pos && (pos->jobState & ZMOS_TASK_JOB_ACTIVE) && 
+          (!isJob || (int32_t)(pos->deadline - pTask->deadline) <= 0))
+    {
+        pos = pos->readyNext;
+    }
+    return pos;
+}
+#endif
+#if ZMOS_TASK_EVENT_COUNT
+/*****************************************************************
+* FUNCTION: zmos_taskEventCount
+*
+* DESCRIPTION:
+*     Count the events set to the task.
+* INPUTS:
+*     pTask : The task.
+*     events : The events to set.
+* RETURNS:
+*     null
+* NOTE:
+*     Must be called in critical.
+*****************************************************************/
+static void zmos_taskEventCount(zmos_taskHandle_t pTask, uTaskEvent_t events)
+{
+    uTaskEvent_t merged = pTask->event & events;
+    uTaskEvent_t counted = pTask->countEvents & events;
+    
+    //Signals coalesced into a pending event.
+    while(merged)
+    {
+        ZMOS_U32_MAX_HOLD(pTask->mergedEvents);
+        merged &= merged - 1;
+    }
+    
+    while(counted)
+    {
+        ZMOS_U8_MAX_HOLD(pTask->eventCounters[ZMOS_CTZ(counted)]);
+        counted &= counted - 1;
+    }
+}
+#endif
+/*****************************************************************
+* FUNCTION: zmos_getReadyTask
+*
+* DESCRIPTION:
+*     ZMOS Get the registered ready task.
+* INPUTS:
+*     null
+* RETURNS:
+*     Task handle.
+* NOTE:
+*     null
+*****************************************************************/
+static zmos_taskHandle_t zmos_getReadyTask(void)
+{
+    if(ZMOS_KERNEL->readyPriorityMap)
+    {
+        taskPriority_t prio = ZMOS_HIGHEST_BIT(ZMOS_KERNEL->readyPriorityMap);
+#if ZMOS_TASK_AGING_TIME > 0
+        uint32_t lowerMap = ZMOS_KERNEL->readyPriorityMap & ~((uint32_t)1 << prio);
+        uint32_t clock = zmos_getTimerClock();
+        
+        //Check whether a lower priority task has waited too long.
+        while(lowerMap)
+        {
+            taskPriority_t lowerPrio = ZMOS_HIGHEST_BIT(lowerMap);
+            
+            if(clock - ZMOS_KERNEL->readyListHead[lowerPrio]->readyTime >= ZMOS_TASK_AGING_TIME)
+            {
+                return ZMOS_KERNEL->readyListHead[lowerPrio];
+            }
+            lowerMap &= ~((uint32_t)1 << lowerPrio);
+        }
+#endif
+        return ZMOS_KERNEL->readyListHead[prio];
+    }
+    return NULL;
+}
+/*****************************************************************
+* FUNCTION: zmos_taskReadyInsert
+*
+* DESCRIPTION:
+*     Insert a task into the ready list of its priority.
+* INPUTS:
+*     pTask : The task to insert.
+*     head : true : insert at the head of the list.
+*            false : insert at the tail of the list.
+* RETURNS:
+*     null
+* NOTE:
+*     Must be called in critical.
+*****************************************************************/
+static void zmos_taskReadyInsert(zmos_taskHandle_t pTask, bool head)
+{
+    taskPriority_t prio = pTask->priority;
+#if ZMOS_TASK_PERIODIC && ZMOS_TASK_EDF
+    zmos_taskHandle_t pos;
+#endif
+    
+#if ZMOS_TASK_AGING_TIME > 0
+    pTask->readyTime = zmos_getTimerClock();
+#endif
+    if(ZMOS_KERNEL->readyListHead[prio] == NULL)
+    {
+        pTask->readyNext = NULL;
+        pTask->readyPrev = NULL;
+        ZMOS_KERNEL->readyListHead[prio] = pTask;
+        ZMOS_KERNEL->readyListTail[prio] = pTask;
+        ZMOS_KERNEL->readyPriorityMap |= ((uint32_t)1 << prio);
+    }
+#if ZMOS_TASK_PERIODIC && ZMOS_TASK_EDF
+    else if((pos = zmos_taskEdfPosition(pTask, head)) != NULL)
+    {
+        //Insert before the position.
+        pTask->readyNext = pos;
+        pTask->readyPrev = pos->readyPrev;
+        if(pos->readyPrev)
+        {
+            pos->readyPrev->readyNext = pTask;
+        }
+        else
+        {
+            ZMOS_KERNEL->readyListHead[prio] = pTask;
+        }
+        pos->readyPrev = pTask;
+    }
+#else
+    else if(head)
+    {
+        pTask->readyPrev = NULL;
+        pTask->readyNext = ZMOS_KERNEL->readyListHead[prio];
+        ZMOS_KERNEL->readyListHead[prio]->readyPrev = pTask;
+        ZMOS_KERNEL->readyListHead[prio] = pTask;
+    }
+#endif
+    else
+    {
+        pTask->readyNext = NULL;
+        pTask->readyPrev = ZMOS_KERNEL->readyListTail[prio];
+        ZMOS_KERNEL->readyListTail[prio]->readyNext = pTask;
+        ZMOS_KERNEL->readyListTail[prio] = pTask;
+    }
+}
+/*****************************************************************
+* FUNCTION: zmos_taskReadyRemove
+*
+* DESCRIPTION:
+*     Remove a task from the ready list of its priority.
+* INPUTS:
+*     pTask : The task to remove.
+* RETURNS:
+*     null
+* NOTE:
+*     Must be called in critical.
+*****************************************************************/
+static void zmos_taskReadyRemove(zmos_taskHandle_t pTask)
+{
+    taskPriority_t prio = pTask->priority;
+    
+    if(pTask->readyPrev)
+    {
+        pTask->readyPrev->readyNext = pTask->readyNext;
+    }
+    else
+    {
+        ZMOS_KERNEL->readyListHead[prio] = pTask->readyNext;
+    }
+    
+    if(pTask->readyNext)
+    {
+        pTask->readyNext->readyPrev = pTask->readyPrev;
+    }
+    else
+    {
+        ZMOS_KERNEL->readyListTail[prio] = pTask->readyPrev;
+    }
+    
+    pTask->readyNext = NULL;
+    pTask->readyPrev = NULL;
+    
+    if(ZMOS_KERNEL->readyListHead[prio] == NULL)
+    {
+        ZMOS_KERNEL->readyPriorityMap &= ~((uint32_t)1 << prio);
     }
-    return (zmos_taskHandle_t)task;
 }
 
 /****************************************************** END OF FILE ******************************************************/
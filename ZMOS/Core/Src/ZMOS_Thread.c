@@ -0,0 +1,369 @@
+/*****************************************************************
+* Copyright (C) 2026 zm. All rights reserved.                    *
+******************************************************************
+* ZMOS_Thread.c
+*
+* DESCRIPTION:
+*     ZMOS preemptive fixed priority threads.
+* AUTHOR:
+*     zm
+* CREATED DATE:
+*     2026/10/17
+* REVISION:
+*     v0.1
+*
+* MODIFICATION HISTORY
+* --------------------
+* $Log:$
+*
+*****************************************************************/
+ 
+/*************************************************************************************************************************
+ *                                                       INCLUDES                                                        *
+ *************************************************************************************************************************/
+#include "ZMOS_Common.h"
+#include "ZMOS_Thread.h"
+#include "ZMOS.h"
+#include "bsp_thread.h"
+
+#if ZMOS_USE_THREAD
+/*************************************************************************************************************************
+ *                                                        MACROS                                                         *
+ *************************************************************************************************************************/
+#if (ZMOS_THREAD_PRIORITY_NUM > 32) || (ZMOS_THREAD_PRIORITY_NUM == 0)
+#error "ZMOS_THREAD_PRIORITY_NUM must be 1 ~ 32!"
+#endif
+/*************************************************************************************************************************
+ *                                                      CONSTANTS                                                        *
+ *************************************************************************************************************************/
+ 
+/*************************************************************************************************************************
+ *                                                       TYPEDEFS                                                        *
+ *************************************************************************************************************************/
+ 
+/*************************************************************************************************************************
+ *                                                   GLOBAL VARIABLES                                                    *
+ *************************************************************************************************************************/
+ 
+/*************************************************************************************************************************
+ *                                                  EXTERNAL VARIABLES                                                   *
+ *************************************************************************************************************************/
+ 
+/*************************************************************************************************************************
+ *                                                    LOCAL VARIABLES                                                    *
+ *************************************************************************************************************************/
+ 
+/*************************************************************************************************************************
+ *                                                 FUNCTION DECLARATIONS                                                 *
+ *************************************************************************************************************************/
+static zmos_thread_t *zmos_threadHighest(void);
+static void zmos_threadReschedule(void);
+static void zmos_threadEntry(void);
+/*************************************************************************************************************************
+ *                                                   PUBLIC FUNCTIONS                                                    *
+ *************************************************************************************************************************/
+/*****************************************************************
+* FUNCTION: zmos_threadInit
+*
+* DESCRIPTION:
+*     This function to initialize the threads, the caller is the
+*     main context of the tasks.
+* INPUTS:
+*     null
+* RETURNS:
+*     null
+* NOTE:
+*     null
+*****************************************************************/
+void zmos_threadInit(void)
+{
+    zmos_thread_t *pMain = &ZMOS_KERNEL->threadMain;
+    
+    pMain->sp = NULL;
+    pMain->func = NULL;
+    pMain->arg = NULL;
+    pMain->event = 0;
+    pMain->waitEvents = 0;
+    pMain->priority = 0;
+    pMain->state = ZMOS_THREAD_READY;
+    ZMOS_KERNEL->threadCurrent = pMain;
+    bsp_threadInit();
+}
+/*****************************************************************
+* FUNCTION: zmos_threadProcess
+*
+* DESCRIPTION:
+*     This function to run the threads made ready without a
+*     context switch.
+* INPUTS:
+*     null
+* RETURNS:
+*     null
+* NOTE:
+*     Called by the main loop, a bsp may defer the switch
+*     requested out of the kernel.
+*****************************************************************/
+void zmos_threadProcess(void)
+{
+    zmos_threadReschedule();
+}
+/*****************************************************************
+* FUNCTION: zmos_threadCreate
+*
+* DESCRIPTION:
+*     This function to create a preemptive thread.
+* INPUTS:
+*     pThread : The thread.
+*     func : The thread function.
+*     arg : The param of the thread function.
+*     stack : The stack of the thread.
+*     stackSize : The stack size in bytes.
+*     priority : Thread priority(0 ~ ZMOS_THREAD_PRIORITY_NUM - 1).
+* RETURNS:
+*     0 : Success (ZMOS_TASK_SUCCESS).
+*     other : ref ZMOS task return cordes.
+* NOTE:
+*     Call it after zmos_system_init. All threads preempt the
+*     tasks, one thread of each priority, return ZMOS_TASK_FAILD
+*     when the priority is used.
+*****************************************************************/
+taskReslt_t zmos_threadCreate(zmos_thread_t *pThread, zmosThreadFunc_t func, void *arg,
+                              void *stack, zm_size_t stackSize, uint8_t priority)
+{
+    if(!pThread || !func || !stack || !stackSize || priority >= ZMOS_THREAD_PRIORITY_NUM)
+    {
+        return ZMOS_TASK_ERROR_PARAM;
+    }
+    
+    ZMOS_ENTER_CRITICAL();
+    if(!ZMOS_KERNEL->threadCurrent || ZMOS_KERNEL->threads[priority])
+    {
+        ZMOS_EXIT_CRITICAL();
+        return ZMOS_TASK_FAILD;
+    }
+    pThread->func = func;
+    pThread->arg = arg;
+    pThread->event = 0;
+    pThread->waitEvents = 0;
+    pThread->priority = priority;
+    pThread->state = ZMOS_THREAD_READY;
+    pThread->sp = bsp_threadStackInit(stack, (uint32_t)stackSize, zmos_threadEntry);
+    if(!pThread->sp)
+    {
+        ZMOS_EXIT_CRITICAL();
+        return ZMOS_TASK_ERROR_PARAM;
+    }
+    ZMOS_KERNEL->threads[priority] = pThread;
+    ZMOS_KERNEL->threadReadyMap |= (uint32_t)1 << priority;
+    ZMOS_EXIT_CRITICAL();
+    
+    zmos_threadReschedule();
+    
+    return ZMOS_TASK_SUCCESS;
+}
+/*****************************************************************
+* FUNCTION: zmos_threadSetEvent
+*
+* DESCRIPTION:
+*     This function to set the events of the thread.
+* INPUTS:
+*     pThread : The thread.
+*     events : What events to set.
+* RETURNS:
+*     0 : Success (ZMOS_TASK_SUCCESS).
+*     other : ref ZMOS task return cordes.
+* NOTE:
+*     It can be called by the tasks, threads and interrupts, the
+*     waiting thread preempts at once if it's the highest.
+*****************************************************************/
+taskReslt_t zmos_threadSetEvent(zmos_thread_t *pThread, uTaskEvent_t events)
+{
+    if(!pThread || !events) return ZMOS_TASK_ERROR_PARAM;
+    
+    ZMOS_ENTER_CRITICAL();
+    if(pThread->state == ZMOS_THREAD_EXIT || ZMOS_KERNEL->threads[pThread->priority] != pThread)
+    {
+        ZMOS_EXIT_CRITICAL();
+        return ZMOS_TASK_FAILD;
+    }
+    pThread->event |= events;
+    if(pThread->state == ZMOS_THREAD_WAIT && (pThread->event & pThread->waitEvents))
+    {
+        pThread->state = ZMOS_THREAD_READY;
+        ZMOS_KERNEL->threadReadyMap |= (uint32_t)1 << pThread->priority;
+    }
+    ZMOS_EXIT_CRITICAL();
+    
+    zmos_threadReschedule();
+    
+    return ZMOS_TASK_SUCCESS;
+}
+/*****************************************************************
+* FUNCTION: zmos_threadWaitEvent
+*
+* DESCRIPTION:
+*     This function to wait any of the events by the current thread.
+* INPUTS:
+*     events : What events to wait.
+* RETURNS:
+*     The events received, they are cleared.
+* NOTE:
+*     Only the thread can wait, it returns 0 at once in the tasks.
+*     The thread signals the tasks by zmos_setTaskEvent.
+*****************************************************************/
+uTaskEvent_t zmos_threadWaitEvent(uTaskEvent_t events)
+{
+    zmos_thread_t *pThread = ZMOS_KERNEL->threadCurrent;
+    uTaskEvent_t received;
+    
+    if(!pThread || pThread == &ZMOS_KERNEL->threadMain || !events) return 0;
+    
+    ZMOS_ENTER_CRITICAL();
+    while(!(pThread->event & events))
+    {
+        pThread->waitEvents = events;
+        pThread->state = ZMOS_THREAD_WAIT;
+        ZMOS_KERNEL->threadReadyMap &= ~((uint32_t)1 << pThread->priority);
+        ZMOS_EXIT_CRITICAL();
+        //Run the others until the events are set
+        zmos_threadReschedule();
+        ZMOS_ENTER_CRITICAL();
+    }
+    pThread->waitEvents = 0;
+    received = pThread->event & events;
+    pThread->event ^= received;
+    ZMOS_EXIT_CRITICAL();
+    
+    return received;
+}
+/*****************************************************************
+* FUNCTION: zmos_threadSelf
+*
+* DESCRIPTION:
+*     This function to get the current thread.
+* INPUTS:
+*     null
+* RETURNS:
+*     The current thread.
+*     NULL : Run in the tasks.
+* NOTE:
+*     null
+*****************************************************************/
+zmos_thread_t *zmos_threadSelf(void)
+{
+    zmos_thread_t *pThread = ZMOS_KERNEL->threadCurrent;
+    
+    return (pThread == &ZMOS_KERNEL->threadMain) ? NULL : pThread;
+}
+/*****************************************************************
+* FUNCTION: zmos_threadSwitchContext
+*
+* DESCRIPTION:
+*     This function to save the context of the current thread
+*     and select the highest ready thread.
+* INPUTS:
+*     sp : The context of the current thread.
+* RETURNS:
+*     The context of the thread to run.
+* NOTE:
+*     Only called by the bsp context switch with the interrupts
+*     disabled.
+*****************************************************************/
+void *zmos_threadSwitchContext(void *sp)
+{
+    ZMOS_KERNEL->threadCurrent->sp = sp;
+    ZMOS_KERNEL->threadCurrent = zmos_threadHighest();
+    
+    return ZMOS_KERNEL->threadCurrent->sp;
+}
+/*************************************************************************************************************************
+ *                                                    LOCAL FUNCTIONS                                                    *
+ *************************************************************************************************************************/
+/*****************************************************************
+* FUNCTION: zmos_threadHighest
+*
+* DESCRIPTION:
+*     Get the highest ready thread.
+* INPUTS:
+*     null
+* RETURNS:
+*     The highest ready thread, the main context if none.
+* NOTE:
+*     Must be called in critical.
+*****************************************************************/
+static zmos_thread_t *zmos_threadHighest(void)
+{
+    uint32_t readyMap = ZMOS_KERNEL->threadReadyMap;
+    
+    if(!readyMap) return &ZMOS_KERNEL->threadMain;
+    
+    return ZMOS_KERNEL->threads[31 - ZMOS_CLZ(readyMap)];
+}
+/*****************************************************************
+* FUNCTION: zmos_threadReschedule
+*
+* DESCRIPTION:
+*     Request the context switch when the current is not the
+*     highest ready thread.
+* INPUTS:
+*     null
+* RETURNS:
+*     null
+* NOTE:
+*     Called out of the critical, so the switch is never done with
+*     the critical nested.
+*****************************************************************/
+static void zmos_threadReschedule(void)
+{
+    uint8_t needSwitch;
+    
+    ZMOS_ENTER_CRITICAL();
+    needSwitch = ZMOS_KERNEL->threadCurrent && (zmos_threadHighest() != ZMOS_KERNEL->threadCurrent);
+    ZMOS_EXIT_CRITICAL();
+    
+    if(needSwitch)
+    {
+        bsp_threadSwitch();
+    }
+}
+/*****************************************************************
+* FUNCTION: zmos_threadEntry
+*
+* DESCRIPTION:
+*     The first function of all threads, run the thread function
+*     and exit the thread when it returns.
+* INPUTS:
+*     null
+* RETURNS:
+*     null
+* NOTE:
+*     It doesn't return.
+*****************************************************************/
+static void zmos_threadEntry(void)
+{
+    zmos_thread_t *pThread = ZMOS_KERNEL->threadCurrent;
+    
+    pThread->func(pThread->arg);
+    
+    ZMOS_ENTER_CRITICAL();
+    pThread->state = ZMOS_THREAD_EXIT;
+    ZMOS_KERNEL->threadReadyMap &= ~((uint32_t)1 << pThread->priority);
+    ZMOS_KERNEL->threads[pThread->priority] = NULL;
+    ZMOS_EXIT_CRITICAL();
+    
+    while(1)
+    {
+        //Never switch back to the exited thread
+        zmos_threadReschedule();
+    }
+}
+
+#else
+taskReslt_t zmos_threadCreate(zmos_thread_t *pThread, zmosThreadFunc_t func, void *arg,
+                              void *stack, zm_size_t stackSize, uint8_t priority) {return ZMOS_TASK_FAILD;}
+taskReslt_t zmos_threadSetEvent(zmos_thread_t *pThread, uTaskEvent_t events) {return ZMOS_TASK_FAILD;}
+uTaskEvent_t zmos_threadWaitEvent(uTaskEvent_t events) {return 0;}
+zmos_thread_t *zmos_threadSelf(void) {return NULL;}
+void *zmos_threadSwitchContext(void *sp) {return sp;}
+#endif
+/****************************************************** END OF FILE ******************************************************/
@@ -25,10 +25,25 @@
 #include "ZMOS_Timers.h"
 #include "ZMOS_Memory.h"
 #include "ZMOS.h"
+#include "bsp_clock.h"
 /*************************************************************************************************************************
  *                                                        MACROS                                                         *
  *************************************************************************************************************************/
- 
+/* Flags of the timer */
+#define ZMOS_TIMER_FLAG_HANDLE      0x01    //!< The timer is kept for its handle.
+#define ZMOS_TIMER_FLAG_ACTIVE      0x02    //!< The timer is running.
+#if ZMOS_TIMER_PERIODIC
+/* Policy of the timer not periodic */
+#define ZMOS_TIMER_NOT_PERIODIC     0xFF
+#endif
+#if ZMOS_USE_TIME_US
+/* Max time(ms) to the next read of the microsecond count, less than 2^31 us */
+#define ZMOS_TIME_US_READ_MAX       1800000
+#endif
+#if ZMOS_TIMER_STORE == ZMOS_TIMER_STORE_WHEEL
+/* Slot of the timers due, they are in the timerListHead */
+#define ZMOS_TIMER_WHEEL_DUE        0xFF
+#endif
 /*************************************************************************************************************************
  *                                                      CONSTANTS                                                        *
  *************************************************************************************************************************/
@@ -36,20 +51,11 @@
 /*************************************************************************************************************************
  *                                                       TYPEDEFS                                                        *
  *************************************************************************************************************************/
-typedef struct zmos_timer
-{
-    uint32_t timeout;
-    uint32_t reloadTime;
-    zmos_taskHandle_t taskHandle;
-    uTaskEvent_t event;
-    struct zmos_timer *next;
-}zmos_timer_t;
+ 
 /*************************************************************************************************************************
  *                                                   GLOBAL VARIABLES                                                    *
  *************************************************************************************************************************/
-/* Timer Clock */
-static uint32_t zmos_timerClock;
-static zmos_timer_t *timerListHead = NULL;
+ 
 /*************************************************************************************************************************
  *                                                  EXTERNAL VARIABLES                                                   *
  *************************************************************************************************************************/
@@ -62,8 +68,32 @@ static zmos_timer_t *timerListHead = NULL;
  *                                                 FUNCTION DECLARATIONS                                                 *
  *************************************************************************************************************************/
 static zmos_timer_t *zmos_findTimer(zmos_taskHandle_t pTaskHandle, uTaskEvent_t event);
-static zmos_timer_t *zmos_addTimer(zmos_taskHandle_t pTaskHandle, uTaskEvent_t event, uint32_t timeout);
+static zmos_timer_t *zmos_addTimer(zmos_taskHandle_t pTaskHandle, uTaskEvent_t event);
 static void zmos_deleteTimer(zmos_timer_t *pTimer);
+static zmos_timer_t *zmos_timerAlloc(void);
+static void zmos_timerFree(zmos_timer_t *pTimer);
+static uint32_t zmos_timerReloadTime(zmos_timer_t *pTimer);
+#if ZMOS_TIMER_STORE != ZMOS_TIMER_STORE_LIST
+static void zmos_insertTimer(zmos_timer_t *pTimer, uint32_t timeout);
+static void zmos_unlinkTimer(zmos_timer_t *pTimer);
+static void zmos_taskUnlinkTimer(zmos_timer_t *pTimer);
+static void zmos_fireTimers(void);
+#endif
+#if ZMOS_TIMER_STORE == ZMOS_TIMER_STORE_WHEEL
+static void zmos_wheelPush(zmos_timer_t *pTimer, uint8_t slot);
+static void zmos_wheelAdd(zmos_timer_t *pTimer);
+static uint32_t zmos_wheelNextTick(void);
+static void zmos_wheelTick(void);
+#endif
+#if ZMOS_USE_CYCLIC
+extern uint32_t zmos_cyclicNextTimeout(void);
+#endif
+#if ZMOS_TASK_PERIODIC
+extern uint32_t zmos_taskPeriodicNextTimeout(void);
+#endif
+#if ZMOS_USE_HRTIMER
+extern uint32_t zmos_hrtimerNextTimeout(void);
+#endif
 /*************************************************************************************************************************
  *                                                   PUBLIC FUNCTIONS                                                    *
  *************************************************************************************************************************/
@@ -81,11 +111,28 @@ static void zmos_deleteTimer(zmos_timer_t *pTimer);
 * RETURNS:
 *     null
 * NOTE:
-*     null
+*     The timer clock starts at the bsp clock count, the first
+*     update doesn't see the time before the initialize as passed.
 *****************************************************************/
 void zmos_timerInit(void)
 {
-    zmos_timerClock = 0;
+    ZMOS_KERNEL->timerClock = bsp_getClockCount();
+#if ZMOS_TIMER_POOL_SIZE > 0
+    //Link all timers of the pool to the free list.
+    ZMOS_KERNEL->timerPoolFree = NULL;
+    for(uint32_t i = ZMOS_TIMER_POOL_SIZE; i > 0; i--)
+    {
+        ZMOS_KERNEL->timerPool[i - 1].next = ZMOS_KERNEL->timerPoolFree;
+        ZMOS_KERNEL->timerPoolFree = &ZMOS_KERNEL->timerPool[i - 1];
+    }
+    ZMOS_KERNEL->timerPoolUsed = 0;
+    ZMOS_KERNEL->timerPoolMaxUsed = 0;
+    ZMOS_KERNEL->timerPoolMissCount = 0;
+#endif
+#if ZMOS_TIMER_STORE == ZMOS_TIMER_STORE_WHEEL
+    //The next tick of the timer clock.
+    ZMOS_KERNEL->timerWheelTime = ZMOS_KERNEL->timerClock + 1;
+#endif
 }
 /*****************************************************************
 * FUNCTION: zmos_startSingleTimer
@@ -102,13 +149,13 @@ void zmos_timerInit(void)
 *****************************************************************/
 timerReslt_t zmos_startSingleTimer(zmos_taskHandle_t pTaskHandle, uTaskEvent_t event, uint32_t timeout)
 {
-    zmos_timer_t *newTimer;
+    timerReslt_t result;
     
     ZMOS_ENTER_CRITICAL();
-    newTimer = zmos_addTimer(pTaskHandle, event, timeout);
+    result = zmos_timerStart(zmos_addTimer(pTaskHandle, event), timeout, 0);
     ZMOS_EXIT_CRITICAL();
     
-    return (newTimer != NULL ? ZMOS_TIMER_SUCCESS : ZMOS_TIMER_FAILD);
+    return result;
 }
 
 /*****************************************************************
@@ -126,17 +173,64 @@ timerReslt_t zmos_startSingleTimer(zmos_taskHandle_t pTaskHandle, uTaskEvent_t e
 *****************************************************************/
 timerReslt_t zmos_startReloadTimer(zmos_taskHandle_t pTaskHandle, uTaskEvent_t event, uint32_t timeout)
 {
-    zmos_timer_t *newTimer;
+    timerReslt_t result;
     
     ZMOS_ENTER_CRITICAL();
-    newTimer = zmos_addTimer(pTaskHandle, event, timeout);
-    if(newTimer)
-    {
-        newTimer->reloadTime = timeout;
-    }
+    result = zmos_timerStart(zmos_addTimer(pTaskHandle, event), timeout, timeout);
+    ZMOS_EXIT_CRITICAL();
+    
+    return result;
+}
+#if ZMOS_TIMER_PERIODIC
+/*****************************************************************
+* FUNCTION: zmos_startPeriodicTimer
+*
+* DESCRIPTION:
+*     This function is called to start a periodic timer, it fires
+*     at the absolute deadlines of the period.
+* INPUTS:
+*     pTaskHandle : Which task to set event.
+*     event : What event to set.
+*     period : Timer period.
+*     policy : The overrun policy(ZMOS_TIMER_OVERRUN_xxx).
+* RETURNS:
+*     0 : success (ZMOS_TIMER_SUCCESS).
+* NOTE:
+*     The lateness of the update does not drift the deadlines, a
+*     deadline passed by the update is an overrun handled by the
+*     policy.
+*****************************************************************/
+timerReslt_t zmos_startPeriodicTimer(zmos_taskHandle_t pTaskHandle, uTaskEvent_t event, uint32_t period, uint8_t policy)
+{
+    timerReslt_t result;
+    
+    if(period == 0 || policy > ZMOS_TIMER_OVERRUN_COUNT) return ZMOS_TIMER_FAILD;
+    
+    ZMOS_ENTER_CRITICAL();
+    result = zmos_timerStartPeriodic(zmos_addTimer(pTaskHandle, event), period, policy);
     ZMOS_EXIT_CRITICAL();
-    return (newTimer != NULL ? ZMOS_TIMER_SUCCESS : ZMOS_TIMER_FAILD);
+    
+    return result;
+}
+/*****************************************************************
+* FUNCTION: zmos_getTimerMissedCount
+*
+* DESCRIPTION:
+*     Get the number of the periods missed of a periodic timer.
+* INPUTS:
+*     pTaskHandle : task handle of timer to check.
+*     event : task event of timer to check.
+* RETURNS:
+*     The periods missed since the last read.
+* NOTE:
+*     The count is cleared by the read, only the timer of
+*     ZMOS_TIMER_OVERRUN_COUNT counts.
+*****************************************************************/
+uint32_t zmos_getTimerMissedCount(zmos_taskHandle_t pTaskHandle, uTaskEvent_t event)
+{
+    return zmos_timerGetMissedCount(zmos_findTimer(pTaskHandle, event));
 }
+#endif
 /*****************************************************************
 * FUNCTION: zmos_stopTimer
 *
@@ -148,7 +242,8 @@ timerReslt_t zmos_startReloadTimer(zmos_taskHandle_t pTaskHandle, uTaskEvent_t e
 * RETURNS:
 *     0 : success (ZMOS_TIMER_SUCCESS).
 * NOTE:
-*     null
+*     The timer of a handle is stopped only, it's kept for the
+*     handle.
 *****************************************************************/
 timerReslt_t zmos_stopTimer(zmos_taskHandle_t pTaskHandle, uTaskEvent_t event)
 {
@@ -158,7 +253,12 @@ timerReslt_t zmos_stopTimer(zmos_taskHandle_t pTaskHandle, uTaskEvent_t event)
     
     if(pTimer)
     {
+        if(pTimer->flags & ZMOS_TIMER_FLAG_HANDLE)
+        {
+            return zmos_timerStop(pTimer);
+        }
         zmos_deleteTimer(pTimer);
+        ZMOS_TRACE_POINT(ZMOS_TRACE_TIMER_STOP, pTaskHandle, event, 0);
         return ZMOS_TIMER_SUCCESS;
     }
     return ZMOS_TIMER_FAILD;
@@ -179,15 +279,7 @@ timerReslt_t zmos_stopTimer(zmos_taskHandle_t pTaskHandle, uTaskEvent_t event)
 *****************************************************************/
 uint32_t zmos_getCurrentTimeout(zmos_taskHandle_t pTaskHandle, uTaskEvent_t event)
 {
-    zmos_timer_t *pTimer;
-    
-    pTimer = zmos_findTimer(pTaskHandle, event);
-    
-    if(pTimer)
-    {
-        return pTimer->timeout;
-    }
-    return 0;
+    return zmos_timerGetTimeout(zmos_findTimer(pTaskHandle, event));
 }
 /*****************************************************************
 * FUNCTION: zmos_getReloadTimeout
@@ -204,14 +296,259 @@ uint32_t zmos_getCurrentTimeout(zmos_taskHandle_t pTaskHandle, uTaskEvent_t even
 *     null
 *****************************************************************/
 uint32_t zmos_getReloadTimeout(zmos_taskHandle_t pTaskHandle, uTaskEvent_t event)
+{
+    return zmos_timerGetReloadTime(zmos_findTimer(pTaskHandle, event));
+}
+/*****************************************************************
+* FUNCTION: zmos_timerCreate
+*
+* DESCRIPTION:
+*     This function is called to create a timer handle of the
+*     task event, the timer is stopped.
+* INPUTS:
+*     pTaskHandle : Which task to set event.
+*     event : What event to set.
+* RETURNS:
+*     The timer handle.
+*     NULL : No memory or the timer already has a handle.
+* NOTE:
+*     The running timer of the event is taken by the handle. The
+*     timer is kept until zmos_timerDelete.
+*****************************************************************/
+zmos_timerHandle_t zmos_timerCreate(zmos_taskHandle_t pTaskHandle, uTaskEvent_t event)
 {
     zmos_timer_t *pTimer;
     
-    pTimer = zmos_findTimer(pTaskHandle, event);
-    
+    ZMOS_ENTER_CRITICAL();
+    pTimer = zmos_addTimer(pTaskHandle, event);
     if(pTimer)
     {
-        return pTimer->reloadTime;
+        if(pTimer->flags & ZMOS_TIMER_FLAG_HANDLE)
+        {
+            pTimer = NULL;
+        }
+        else
+        {
+            pTimer->flags |= ZMOS_TIMER_FLAG_HANDLE;
+        }
+    }
+    ZMOS_EXIT_CRITICAL();
+    
+    return pTimer;
+}
+/*****************************************************************
+* FUNCTION: zmos_timerDelete
+*
+* DESCRIPTION:
+*     This function is called to stop and delete a timer handle.
+* INPUTS:
+*     hTimer : The timer handle.
+* RETURNS:
+*     0 : success (ZMOS_TIMER_SUCCESS).
+* NOTE:
+*     The handle is invalid after the delete.
+*****************************************************************/
+timerReslt_t zmos_timerDelete(zmos_timerHandle_t hTimer)
+{
+    if(!hTimer) return ZMOS_TIMER_FAILD;
+    
+    ZMOS_ENTER_CRITICAL();
+    hTimer->flags &= ~ZMOS_TIMER_FLAG_HANDLE;
+    zmos_deleteTimer(hTimer);
+    ZMOS_EXIT_CRITICAL();
+    
+    return ZMOS_TIMER_SUCCESS;
+}
+/*****************************************************************
+* FUNCTION: zmos_timerStart
+*
+* DESCRIPTION:
+*     This function is called to start or restart a timer.
+* INPUTS:
+*     hTimer : The timer handle.
+*     timeout : Timer timeout.
+*     reloadTime : Timer reload time, 0 : single timer.
+* RETURNS:
+*     0 : success (ZMOS_TIMER_SUCCESS).
+* NOTE:
+*     The timer of a task unregistered can't be started, the list
+*     store doesn't remove the timers of the task.
+*****************************************************************/
+timerReslt_t zmos_timerStart(zmos_timerHandle_t hTimer, uint32_t timeout, uint32_t reloadTime)
+{
+    if(!hTimer) return ZMOS_TIMER_FAILD;
+    
+    ZMOS_ENTER_CRITICAL();
+    if(!hTimer->taskHandle)
+    {
+        ZMOS_EXIT_CRITICAL();
+        return ZMOS_TIMER_FAILD;
+    }
+#if ZMOS_TIMER_STORE != ZMOS_TIMER_STORE_LIST
+    if(hTimer->flags & ZMOS_TIMER_FLAG_ACTIVE)
+    {
+        //The timer is running - update time.
+        zmos_unlinkTimer(hTimer);
+    }
+    zmos_insertTimer(hTimer, timeout);
+#else
+    hTimer->timeout = timeout;
+#endif
+    hTimer->reloadTime = reloadTime;
+#if ZMOS_TIMER_PERIODIC
+    hTimer->policy = ZMOS_TIMER_NOT_PERIODIC;
+#endif
+    hTimer->flags |= ZMOS_TIMER_FLAG_ACTIVE;
+    ZMOS_EXIT_CRITICAL();
+    ZMOS_TRACE_POINT(ZMOS_TRACE_TIMER_START, hTimer->taskHandle, hTimer->event, timeout);
+    
+    return ZMOS_TIMER_SUCCESS;
+}
+#if ZMOS_TIMER_PERIODIC
+/*****************************************************************
+* FUNCTION: zmos_timerStartPeriodic
+*
+* DESCRIPTION:
+*     This function is called to start a timer as periodic timer.
+* INPUTS:
+*     hTimer : The timer handle.
+*     period : Timer period.
+*     policy : The overrun policy(ZMOS_TIMER_OVERRUN_xxx).
+* RETURNS:
+*     0 : success (ZMOS_TIMER_SUCCESS).
+* NOTE:
+*     Same as zmos_startPeriodicTimer.
+*****************************************************************/
+timerReslt_t zmos_timerStartPeriodic(zmos_timerHandle_t hTimer, uint32_t period, uint8_t policy)
+{
+    timerReslt_t result;
+    
+    if(period == 0 || policy > ZMOS_TIMER_OVERRUN_COUNT) return ZMOS_TIMER_FAILD;
+    
+    ZMOS_ENTER_CRITICAL();
+    result = zmos_timerStart(hTimer, period, period);
+    if(result == ZMOS_TIMER_SUCCESS)
+    {
+        hTimer->deadline = ZMOS_KERNEL->timerClock + period;
+        hTimer->missed = 0;
+        hTimer->policy = policy;
+    }
+    ZMOS_EXIT_CRITICAL();
+    
+    return result;
+}
+/*****************************************************************
+* FUNCTION: zmos_timerGetMissedCount
+*
+* DESCRIPTION:
+*     Get the number of the periods missed of a periodic timer.
+* INPUTS:
+*     hTimer : The timer handle.
+* RETURNS:
+*     The periods missed since the last read.
+* NOTE:
+*     Same as zmos_getTimerMissedCount.
+*****************************************************************/
+uint32_t zmos_timerGetMissedCount(zmos_timerHandle_t hTimer)
+{
+    uint32_t missed = 0;
+    
+    if(hTimer)
+    {
+        ZMOS_ENTER_CRITICAL();
+        missed = hTimer->missed;
+        hTimer->missed = 0;
+        ZMOS_EXIT_CRITICAL();
+    }
+    return missed;
+}
+#endif
+/*****************************************************************
+* FUNCTION: zmos_timerStop
+*
+* DESCRIPTION:
+*     This function to stop a timer, the handle can be started
+*     again.
+* INPUTS:
+*     hTimer : The timer handle.
+* RETURNS:
+*     0 : success (ZMOS_TIMER_SUCCESS).
+*     other : The timer isn't running.
+* NOTE:
+*     null
+*****************************************************************/
+timerReslt_t zmos_timerStop(zmos_timerHandle_t hTimer)
+{
+    if(!hTimer) return ZMOS_TIMER_FAILD;
+    
+    ZMOS_ENTER_CRITICAL();
+    if(!(hTimer->flags & ZMOS_TIMER_FLAG_ACTIVE))
+    {
+        ZMOS_EXIT_CRITICAL();
+        return ZMOS_TIMER_FAILD;
+    }
+#if ZMOS_TIMER_STORE != ZMOS_TIMER_STORE_LIST
+    zmos_unlinkTimer(hTimer);
+#else
+    hTimer->timeout = 0;
+#endif
+    hTimer->flags &= ~ZMOS_TIMER_FLAG_ACTIVE;
+    ZMOS_EXIT_CRITICAL();
+    ZMOS_TRACE_POINT(ZMOS_TRACE_TIMER_STOP, hTimer->taskHandle, hTimer->event, 0);
+    
+    return ZMOS_TIMER_SUCCESS;
+}
+/*****************************************************************
+* FUNCTION: zmos_timerGetTimeout
+*
+* DESCRIPTION:
+*     Get the current timeout of a timer.
+* INPUTS:
+*     hTimer : The timer handle.
+* RETURNS:
+*     Return the timer's tick count if running, zero otherwise.
+* NOTE:
+*     null
+*****************************************************************/
+uint32_t zmos_timerGetTimeout(zmos_timerHandle_t hTimer)
+{
+    uint32_t timeout = 0;
+    
+    if(!hTimer) return 0;
+    
+    ZMOS_ENTER_CRITICAL();
+    if(hTimer->flags & ZMOS_TIMER_FLAG_ACTIVE)
+    {
+#if ZMOS_TIMER_STORE == ZMOS_TIMER_STORE_WHEEL
+        if(hTimer->slot != ZMOS_TIMER_WHEEL_DUE)
+        {
+            timeout = hTimer->timeout - ZMOS_KERNEL->timerClock;
+        }
+#else
+        timeout = hTimer->timeout;
+#endif
+    }
+    ZMOS_EXIT_CRITICAL();
+    
+    return timeout;
+}
+/*****************************************************************
+* FUNCTION: zmos_timerGetReloadTime
+*
+* DESCRIPTION:
+*     Get the reload time of a timer.
+* INPUTS:
+*     hTimer : The timer handle.
+* RETURNS:
+*     Timer reload time, 0 : single timer.
+* NOTE:
+*     null
+*****************************************************************/
+uint32_t zmos_timerGetReloadTime(zmos_timerHandle_t hTimer)
+{
+    if(hTimer)
+    {
+        return hTimer->reloadTime;
     }
     return 0;
 }
@@ -226,22 +563,82 @@ uint32_t zmos_getReloadTimeout(zmos_taskHandle_t pTaskHandle, uTaskEvent_t event
 *     The lowest timeout value. 
 * NOTE:
 *     If the timer list is empty, then the returned timeout will 
-*     be TIMER_MAX_TIMEOUT.
+*     be TIMER_MAX_TIMEOUT. The wheel returns the time to the next
+*     expiry or the next move of the higher levels, it can be
+*     earlier than the timer.
 *****************************************************************/
 uint32_t zmos_getNextLowestTimeout(void)
 {
+#if ZMOS_TIMER_STORE == ZMOS_TIMER_STORE_WHEEL
+    uint32_t next;
+    
+    if(ZMOS_KERNEL->timerListHead) return 0;
+    
+    next = zmos_wheelNextTick();
+    if(next == TIMER_MAX_TIMEOUT) return TIMER_MAX_TIMEOUT;
+    
+    return ZMOS_KERNEL->timerWheelTime + next - ZMOS_KERNEL->timerClock;
+#else
     uint32_t timeout = TIMER_MAX_TIMEOUT;
-    zmos_timer_t *srchTimer = timerListHead;
+    zmos_timer_t *srchTimer = ZMOS_KERNEL->timerListHead;
     
     while(srchTimer)
     {
-        if(srchTimer->timeout < timeout)
+        if((srchTimer->flags & ZMOS_TIMER_FLAG_ACTIVE) && srchTimer->timeout < timeout)
         {
             timeout = srchTimer->timeout;
         }
         srchTimer = srchTimer->next;
     }
     return timeout;
+#endif
+}
+/*****************************************************************
+* FUNCTION: zmos_getNextWakeupTimeout
+*
+* DESCRIPTION:
+*     Get the time to the next work of the kernel, the lowest of
+*     the timers, the cyclic frame, the periodic release and the
+*     high resolution timers.
+* INPUTS:
+*     null
+* RETURNS:
+*     The time to the next work.
+*     TIMER_MAX_TIMEOUT : No work.
+* NOTE:
+*     Used by the idle path and the low power, must be called in
+*     critical. With ZMOS_USE_TIME_US it is at most 30 minutes,
+*     the microsecond count is read before it wraps around.
+*****************************************************************/
+uint32_t zmos_getNextWakeupTimeout(void)
+{
+    uint32_t timeout = zmos_getNextLowestTimeout();
+    
+#if ZMOS_USE_CYCLIC
+    if(zmos_cyclicNextTimeout() < timeout)
+    {
+        timeout = zmos_cyclicNextTimeout();
+    }
+#endif
+#if ZMOS_TASK_PERIODIC
+    if(zmos_taskPeriodicNextTimeout() < timeout)
+    {
+        timeout = zmos_taskPeriodicNextTimeout();
+    }
+#endif
+#if ZMOS_USE_HRTIMER
+    if(zmos_hrtimerNextTimeout() < timeout)
+    {
+        timeout = zmos_hrtimerNextTimeout();
+    }
+#endif
+#if ZMOS_USE_TIME_US
+    if(timeout > ZMOS_TIME_US_READ_MAX)
+    {
+        timeout = ZMOS_TIME_US_READ_MAX;
+    }
+#endif
+    return timeout;
 }
 /*****************************************************************
 * FUNCTION: zmos_timeTickUpdate
@@ -253,20 +650,49 @@ uint32_t zmos_getNextLowestTimeout(void)
 * RETURNS:
 *     null
 * NOTE:
-*     null
+*     The wheel only touches the timers expired, each timer
+*     expires once in an update.
 *****************************************************************/
 void zmos_timeTickUpdate(uint32_t upTime)
 {
+#if ZMOS_TIMER_STORE == ZMOS_TIMER_STORE_WHEEL
+    uint32_t next;
+    
+    ZMOS_ENTER_CRITICAL();
+    ZMOS_KERNEL->timerClock += upTime;
+    ZMOS_EXIT_CRITICAL();
+    //The timers due before the update.
+    zmos_fireTimers();
+    
+    while(upTime)
+    {
+        ZMOS_ENTER_CRITICAL();
+        next = zmos_wheelNextTick();
+        if(next >= upTime)
+        {
+            //Skip the empty ticks.
+            ZMOS_KERNEL->timerWheelTime += upTime;
+            ZMOS_EXIT_CRITICAL();
+            break;
+        }
+        ZMOS_KERNEL->timerWheelTime += next;
+        upTime -= next + 1;
+        zmos_wheelTick();
+        ZMOS_EXIT_CRITICAL();
+    
+        zmos_fireTimers();
+    }
+#else
     zmos_timer_t *srchTimer;
     zmos_timer_t *prevTimer;
     zmos_timer_t *freeTimer;
     
     ZMOS_ENTER_CRITICAL();
-    zmos_timerClock += upTime;
+    ZMOS_KERNEL->timerClock += upTime;
     ZMOS_EXIT_CRITICAL();
     
     prevTimer = NULL;
-    srchTimer = timerListHead;
+    srchTimer = ZMOS_KERNEL->timerListHead;
     
     while(srchTimer)
     {
@@ -281,15 +707,20 @@ void zmos_timeTickUpdate(uint32_t upTime)
             srchTimer->timeout = 0;
         }
         
-        if(srchTimer->timeout == 0 && srchTimer->event)
+        if(srchTimer->timeout == 0 && srchTimer->event && (srchTimer->flags & ZMOS_TIMER_FLAG_ACTIVE))
         {
+            ZMOS_TRACE_POINT(ZMOS_TRACE_TIMER_EXPIRE, srchTimer->taskHandle, srchTimer->event, srchTimer->reloadTime);
             //Set Task event.
             zmos_setTaskEvent(srchTimer->taskHandle, srchTimer->event);
             //Reload time value.
-            srchTimer->timeout = srchTimer->reloadTime;
+            srchTimer->timeout = srchTimer->reloadTime ? zmos_timerReloadTime(srchTimer) : 0;
+            if(srchTimer->timeout == 0)
+            {
+                srchTimer->flags &= ~ZMOS_TIMER_FLAG_ACTIVE;
+            }
                 
         }
-        if(srchTimer->timeout == 0 || srchTimer->event == 0)
+        if((srchTimer->timeout == 0 || srchTimer->event == 0) && !(srchTimer->flags & ZMOS_TIMER_FLAG_HANDLE))
         {
             if(prevTimer)
             {
@@ -297,7 +728,7 @@ void zmos_timeTickUpdate(uint32_t upTime)
             }
             else
             {
-                timerListHead = timerListHead->next;
+                ZMOS_KERNEL->timerListHead = ZMOS_KERNEL->timerListHead->next;
             }
             
             freeTimer = srchTimer;
@@ -311,9 +742,10 @@ void zmos_timeTickUpdate(uint32_t upTime)
         
         if(freeTimer)
         {
-            zmos_free(freeTimer);
+            zmos_timerFree(freeTimer);
         }
     }
+#endif
 }
 /*****************************************************************
 * FUNCTION: zmos_getTimerClock
@@ -329,55 +761,241 @@ void zmos_timeTickUpdate(uint32_t upTime)
 *****************************************************************/
 uint32_t zmos_getTimerClock(void)
 {
-    return zmos_timerClock;
+    return ZMOS_KERNEL->timerClock;
 }
+#if ZMOS_USE_TIME_US
 /*****************************************************************
-* FUNCTION: zmos_findTimer
+* FUNCTION: zmos_timeNowUs
 *
 * DESCRIPTION:
-*     Find a timer in timer list
+*     Get the monotonic time in microseconds.
 * INPUTS:
-*     
+*     null
 * RETURNS:
-*     
+*     The time in microseconds.
 * NOTE:
-*     null
+*     The 32-bit count of bsp_getUsCount is extended to 64 bits,
+*     it must be read once in 35 minutes, the main loop reads it
+*     at each run and the low power wakes up in 30 minutes. A count earlier than the last is taken as the
+*     last.
 *****************************************************************/
-static zmos_timer_t *zmos_findTimer(zmos_taskHandle_t pTaskHandle, uTaskEvent_t event)
+uint64_t zmos_timeNowUs(void)
 {
-    zmos_timer_t *srchTimer = timerListHead;
+    uint32_t count;
+    uint64_t now;
     
-    while(srchTimer)
+    ZMOS_ENTER_CRITICAL();
+    count = bsp_getUsCount();
+    if(count < ZMOS_KERNEL->timeUsLast)
     {
-        if(srchTimer->taskHandle == pTaskHandle && 
-           srchTimer->event == event)
+        if(ZMOS_KERNEL->timeUsLast - count > 0x80000000)
         {
-            break;
+            //The count wraps around.
+            ZMOS_KERNEL->timeUsHigh++;
+        }
+        else
+        {
+            //The count is a little behind the last one, keep monotonic.
+            count = ZMOS_KERNEL->timeUsLast;
         }
-        srchTimer = srchTimer->next;
     }
-    return srchTimer;
+    ZMOS_KERNEL->timeUsLast = count;
+    now = ((uint64_t)ZMOS_KERNEL->timeUsHigh << 32) | count;
+    ZMOS_EXIT_CRITICAL();
+    
+    return now;
 }
-
+#endif
 /*****************************************************************
-* FUNCTION: zmos_addTimer
+* FUNCTION: zmos_getTimerPoolUsed
 *
 * DESCRIPTION:
-*     Add a timer to timer list.
+*     Get the number of the timers used in the timer pool.
 * INPUTS:
-*     pTaskHandle : Which task to set event.
-*     event : What event to set.
-*     timeout : Timer timeout.
-* RETURNS:
 *     null
+* RETURNS:
+*     The timers used.
 * NOTE:
+*     If ZMOS_TIMER_POOL_SIZE is 0, It always returns 0.
+*****************************************************************/
+uint32_t zmos_getTimerPoolUsed(void)
+{
+#if ZMOS_TIMER_POOL_SIZE > 0
+    return ZMOS_KERNEL->timerPoolUsed;
+#else
+    return 0;
+#endif
+}
+/*****************************************************************
+* FUNCTION: zmos_getTimerPoolMaxUsed
+*
+* DESCRIPTION:
+*     Get the max number of the timers used in the timer pool.
+* INPUTS:
 *     null
+* RETURNS:
+*     The high water of the pool.
+* NOTE:
+*     If ZMOS_TIMER_POOL_SIZE is 0, It always returns 0.
 *****************************************************************/
-static zmos_timer_t *zmos_addTimer(zmos_taskHandle_t pTaskHandle, uTaskEvent_t event, uint32_t timeout)
+uint32_t zmos_getTimerPoolMaxUsed(void)
 {
+#if ZMOS_TIMER_POOL_SIZE > 0
+    return ZMOS_KERNEL->timerPoolMaxUsed;
+#else
+    return 0;
+#endif
+}
+/*****************************************************************
+* FUNCTION: zmos_getTimerPoolMissCount
+*
+* DESCRIPTION:
+*     Get the number of the timers allocated from the heap when the
+*     timer pool is full.
+* INPUTS:
+*     null
+* RETURNS:
+*     The number of the heap timers.
+* NOTE:
+*     If ZMOS_TIMER_POOL_SIZE is 0, It always returns 0.
+*****************************************************************/
+uint32_t zmos_getTimerPoolMissCount(void)
+{
+#if ZMOS_TIMER_POOL_SIZE > 0
+    return ZMOS_KERNEL->timerPoolMissCount;
+#else
+    return 0;
+#endif
+}
+#if ZMOS_TIMER_STORE != ZMOS_TIMER_STORE_LIST
+/*****************************************************************
+* FUNCTION: zmos_timerTaskRemove
+*
+* DESCRIPTION:
+*     Stop all timers of the task.
+* INPUTS:
+*     pTaskHandle : The task.
+* RETURNS:
+*     null
+* NOTE:
+*     Called when the task is unregistered. The timers of handles
+*     are stopped and kept, they can be deleted only.
+*****************************************************************/
+void zmos_timerTaskRemove(zmos_taskHandle_t pTaskHandle)
+{
+    zmos_timer_t *pTimer;
+    
+    ZMOS_ENTER_CRITICAL();
+    while(pTaskHandle->timerList)
+    {
+        pTimer = pTaskHandle->timerList;
+        if(pTimer->flags & ZMOS_TIMER_FLAG_HANDLE)
+        {
+            if(pTimer->flags & ZMOS_TIMER_FLAG_ACTIVE)
+            {
+                zmos_unlinkTimer(pTimer);
+            }
+            pTimer->flags &= ~ZMOS_TIMER_FLAG_ACTIVE;
+            zmos_taskUnlinkTimer(pTimer);
+            pTimer->taskHandle = NULL;
+        }
+        else
+        {
+            zmos_deleteTimer(pTimer);
+        }
+    }
+    ZMOS_EXIT_CRITICAL();
+}
+#endif
+/*****************************************************************
+* FUNCTION: zmos_findTimer
+*
+* DESCRIPTION:
+*     Find a timer in timer list
+* INPUTS:
+*     
+* RETURNS:
+*     
+* NOTE:
+*     The wheel searches the timers of the task.
+*****************************************************************/
+static zmos_timer_t *zmos_findTimer(zmos_taskHandle_t pTaskHandle, uTaskEvent_t event)
+{
+#if ZMOS_TIMER_STORE != ZMOS_TIMER_STORE_LIST
+    zmos_timer_t *srchTimer;
+    
+    if(!pTaskHandle) return NULL;
+    
+    srchTimer = pTaskHandle->timerList;
+    while(srchTimer)
+    {
+        if(srchTimer->event == event)
+        {
+            break;
+        }
+        srchTimer = srchTimer->taskNext;
+    }
+    return srchTimer;
+#else
+    zmos_timer_t *srchTimer = ZMOS_KERNEL->timerListHead;
+    
+    while(srchTimer)
+    {
+        if(srchTimer->taskHandle == pTaskHandle && 
+           srchTimer->event == event)
+        {
+            break;
+        }
+        srchTimer = srchTimer->next;
+    }
+    return srchTimer;
+#endif
+}
+
+/*****************************************************************
+* FUNCTION: zmos_addTimer
+*
+* DESCRIPTION:
+*     Get the timer of the task event, add a new one if it doesn't
+*     exist.
+* INPUTS:
+*     pTaskHandle : Which task to set event.
+*     event : What event to set.
+* RETURNS:
+*     The timer.
+*     NULL : No memory.
+* NOTE:
+*     The new timer is stopped, it's started by zmos_timerStart.
+*     Called in critical.
+*****************************************************************/
+static zmos_timer_t *zmos_addTimer(zmos_taskHandle_t pTaskHandle, uTaskEvent_t event)
+{
+#if ZMOS_TIMER_STORE != ZMOS_TIMER_STORE_LIST
+    zmos_timer_t *pTimer;
+    
+    if(!pTaskHandle) return NULL;
+    
+    pTimer = zmos_findTimer(pTaskHandle, event);
+    if(!pTimer)
+    {
+        //new timer
+        pTimer = zmos_timerAlloc();
+        if(!pTimer) return NULL;
+        pTimer->taskHandle = pTaskHandle;
+        pTimer->event = event;
+        pTimer->reloadTime = 0;
+        pTimer->flags = 0;
+        pTimer->next = NULL;
+        pTimer->prev = NULL;
+        pTimer->taskNext = pTaskHandle->timerList;
+        pTaskHandle->timerList = pTimer;
+    }
+    
+    return pTimer;
+#else
     if(pTaskHandle)
     {
-        zmos_timer_t *srchTimer = timerListHead;
+        zmos_timer_t *srchTimer = ZMOS_KERNEL->timerListHead;
         zmos_timer_t *prevTimer;
         zmos_timer_t *newTimer;
         
@@ -386,35 +1004,35 @@ static zmos_timer_t *zmos_addTimer(zmos_taskHandle_t pTaskHandle, uTaskEvent_t e
             if(srchTimer->taskHandle == pTaskHandle && 
                srchTimer->event == event)
             {
-                //The timer already exists - update time.
-                srchTimer->timeout = timeout;
-                srchTimer->reloadTime = 0;
+                //The timer already exists.
                 return srchTimer;
             }
             prevTimer = srchTimer;
             srchTimer = srchTimer->next;
         }
         //new timer
-        newTimer = (zmos_timer_t *)zmos_malloc(sizeof(zmos_timer_t));
+        newTimer = zmos_timerAlloc();
         
         if(newTimer)
         {
             newTimer->taskHandle = pTaskHandle;
             newTimer->event = event;
-            newTimer->timeout = timeout;
+            newTimer->timeout = 0;
             newTimer->reloadTime = 0;
+            newTimer->flags = 0;
             newTimer->next = NULL;
             
-            if(timerListHead)
+            if(ZMOS_KERNEL->timerListHead)
             {
                 prevTimer->next = newTimer;
             }
-            else timerListHead = newTimer;
+            else ZMOS_KERNEL->timerListHead = newTimer;
             
             return newTimer;
         }
     }
     return NULL;
+#endif
 }
 
 /*****************************************************************
@@ -427,14 +1045,454 @@ static zmos_timer_t *zmos_addTimer(zmos_taskHandle_t pTaskHandle, uTaskEvent_t e
 * RETURNS:
 *     null
 * NOTE:
-*     null
+*     The timer of a task unregistered isn't in the timers of any
+*     task.
 *****************************************************************/
 static void zmos_deleteTimer(zmos_timer_t *pTimer)
 {
     if(pTimer)
     {
+#if ZMOS_TIMER_STORE != ZMOS_TIMER_STORE_LIST
+        ZMOS_ENTER_CRITICAL();
+        if(pTimer->flags & ZMOS_TIMER_FLAG_ACTIVE)
+        {
+            zmos_unlinkTimer(pTimer);
+        }
+        if(pTimer->taskHandle)
+        {
+            zmos_taskUnlinkTimer(pTimer);
+        }
+        ZMOS_EXIT_CRITICAL();
+        zmos_timerFree(pTimer);
+#else
         //Clear event.
         pTimer->event = 0;
+#endif
+    }
+}
+/*****************************************************************
+* FUNCTION: zmos_timerAlloc
+*
+* DESCRIPTION:
+*     Allocate a timer from the timer pool, from the heap when the
+*     pool is full.
+* INPUTS:
+*     null
+* RETURNS:
+*     The timer.
+*     NULL : No memory.
+* NOTE:
+*     null
+*****************************************************************/
+static zmos_timer_t *zmos_timerAlloc(void)
+{
+#if ZMOS_TIMER_POOL_SIZE > 0
+    zmos_timer_t *pTimer;
+    
+    ZMOS_ENTER_CRITICAL();
+    pTimer = ZMOS_KERNEL->timerPoolFree;
+    if(pTimer)
+    {
+        ZMOS_KERNEL->timerPoolFree = pTimer->next;
+        ZMOS_KERNEL->timerPoolUsed++;
+        if(ZMOS_KERNEL->timerPoolUsed > ZMOS_KERNEL->timerPoolMaxUsed)
+        {
+            ZMOS_KERNEL->timerPoolMaxUsed = ZMOS_KERNEL->timerPoolUsed;
+        }
+        ZMOS_EXIT_CRITICAL();
+        return pTimer;
+    }
+    ZMOS_U32_MAX_HOLD(ZMOS_KERNEL->timerPoolMissCount);
+    ZMOS_EXIT_CRITICAL();
+#endif
+    return (zmos_timer_t *)zmos_malloc(sizeof(zmos_timer_t));
+}
+/*****************************************************************
+* FUNCTION: zmos_timerFree
+*
+* DESCRIPTION:
+*     Free a timer to the timer pool or the heap.
+* INPUTS:
+*     pTimer : timer.
+* RETURNS:
+*     null
+* NOTE:
+*     null
+*****************************************************************/
+static void zmos_timerFree(zmos_timer_t *pTimer)
+{
+#if ZMOS_TIMER_POOL_SIZE > 0
+    if(pTimer >= &ZMOS_KERNEL->timerPool[0] && pTimer < &ZMOS_KERNEL->timerPool[ZMOS_TIMER_POOL_SIZE])
+    {
+        ZMOS_ENTER_CRITICAL();
+        pTimer->next = ZMOS_KERNEL->timerPoolFree;
+        ZMOS_KERNEL->timerPoolFree = pTimer;
+        ZMOS_KERNEL->timerPoolUsed--;
+        ZMOS_EXIT_CRITICAL();
+        return;
+    }
+#endif
+    zmos_free(pTimer);
+}
+/*****************************************************************
+* FUNCTION: zmos_timerReloadTime
+*
+* DESCRIPTION:
+*     Get the time to the next expiry of a timer fired.
+* INPUTS:
+*     pTimer : timer.
+* RETURNS:
+*     The time to the next expiry.
+* NOTE:
+*     The periodic timer moves its deadline by the period, the
+*     deadlines passed are handled by the policy. The clock is
+*     updated before. Called in critical.
+*****************************************************************/
+static uint32_t zmos_timerReloadTime(zmos_timer_t *pTimer)
+{
+#if ZMOS_TIMER_PERIODIC
+    uint32_t clock = ZMOS_KERNEL->timerClock;
+    uint32_t missed;
+    
+    if(pTimer->policy == ZMOS_TIMER_NOT_PERIODIC) return pTimer->reloadTime;
+    
+    pTimer->deadline += pTimer->reloadTime;
+    if((int32_t)(clock - pTimer->deadline) >= 0)
+    {
+        if(pTimer->policy == ZMOS_TIMER_OVERRUN_ONCE)
+        {
+            //Fire the next period at the next tick.
+            return 1;
+        }
+        //Skip to the first deadline after the clock.
+        missed = (clock - pTimer->deadline) / pTimer->reloadTime + 1;
+        pTimer->deadline += missed * pTimer->reloadTime;
+        if(pTimer->policy == ZMOS_TIMER_OVERRUN_COUNT)
+        {
+            pTimer->missed = (pTimer->missed + missed < pTimer->missed) ? 0xFFFFFFFF : pTimer->missed + missed;
+        }
+    }
+    return pTimer->deadline - clock;
+#else
+    return pTimer->reloadTime;
+#endif
+}
+#if ZMOS_TIMER_STORE != ZMOS_TIMER_STORE_LIST
+/*****************************************************************
+* FUNCTION: zmos_taskUnlinkTimer
+*
+* DESCRIPTION:
+*     Remove a timer from the timers of its task.
+* INPUTS:
+*     pTimer : timer.
+* RETURNS:
+*     null
+* NOTE:
+*     Called in critical.
+*****************************************************************/
+static void zmos_taskUnlinkTimer(zmos_timer_t *pTimer)
+{
+    zmos_timer_t **ppTimer = &pTimer->taskHandle->timerList;
+    
+    while(*ppTimer)
+    {
+        if(*ppTimer == pTimer)
+        {
+            *ppTimer = pTimer->taskNext;
+            break;
+        }
+        ppTimer = &(*ppTimer)->taskNext;
+    }
+}
+/*****************************************************************
+* FUNCTION: zmos_fireTimers
+*
+* DESCRIPTION:
+*     Set the events of the timers due and reload them.
+* INPUTS:
+*     null
+* RETURNS:
+*     null
+* NOTE:
+*     The timers due are in the due list of the wheel. The reload timer is put back
+*     before its event is set, the timer of a handle is kept.
+*****************************************************************/
+static void zmos_fireTimers(void)
+{
+    zmos_timer_t *pTimer;
+    zmos_timer_t *freeTimer;
+    zmos_taskHandle_t taskHandle;
+    uTaskEvent_t event;
+    uint32_t reloadTime;
+    
+    while(1)
+    {
+        ZMOS_ENTER_CRITICAL();
+        pTimer = ZMOS_KERNEL->timerListHead;
+        if(!pTimer)
+        {
+            ZMOS_EXIT_CRITICAL();
+            break;
+        }
+        taskHandle = pTimer->taskHandle;
+        event = pTimer->event;
+        reloadTime = pTimer->reloadTime;
+        freeTimer = NULL;
+        zmos_unlinkTimer(pTimer);
+        if(reloadTime)
+        {
+            //Reload time value.
+            zmos_insertTimer(pTimer, zmos_timerReloadTime(pTimer));
+        }
+        else
+        {
+            pTimer->flags &= ~ZMOS_TIMER_FLAG_ACTIVE;
+            if(!(pTimer->flags & ZMOS_TIMER_FLAG_HANDLE))
+            {
+                zmos_taskUnlinkTimer(pTimer);
+                freeTimer = pTimer;
+            }
+        }
+        ZMOS_EXIT_CRITICAL();
+    
+        ZMOS_TRACE_POINT(ZMOS_TRACE_TIMER_EXPIRE, taskHandle, event, reloadTime);
+        //Set Task event.
+        zmos_setTaskEvent(taskHandle, event);
+        if(freeTimer)
+        {
+            zmos_timerFree(freeTimer);
+        }
+    }
+}
+#endif
+#if ZMOS_TIMER_STORE == ZMOS_TIMER_STORE_WHEEL
+/*****************************************************************
+* FUNCTION: zmos_insertTimer
+*
+* DESCRIPTION:
+*     Insert a timer to the wheel.
+* INPUTS:
+*     pTimer : timer.
+*     timeout : Timer timeout.
+* RETURNS:
+*     null
+* NOTE:
+*     The timer of timeout 0 is due at once. Called in critical.
+*****************************************************************/
+static void zmos_insertTimer(zmos_timer_t *pTimer, uint32_t timeout)
+{
+    //Expiry time
+    pTimer->timeout = ZMOS_KERNEL->timerClock + timeout;
+    if(timeout == 0)
+    {
+        zmos_wheelPush(pTimer, ZMOS_TIMER_WHEEL_DUE);
+    }
+    else
+    {
+        zmos_wheelAdd(pTimer);
+    }
+}
+/*****************************************************************
+* FUNCTION: zmos_unlinkTimer
+*
+* DESCRIPTION:
+*     Remove a timer from its wheel slot.
+* INPUTS:
+*     pTimer : timer.
+* RETURNS:
+*     null
+* NOTE:
+*     Called in critical.
+*****************************************************************/
+static void zmos_unlinkTimer(zmos_timer_t *pTimer)
+{
+    uint8_t slot = pTimer->slot;
+    zmos_timer_t **ppHead;
+    
+    ppHead = (slot == ZMOS_TIMER_WHEEL_DUE) ? &ZMOS_KERNEL->timerListHead : &ZMOS_KERNEL->timerWheel[slot];
+    if(pTimer->next)
+    {
+        pTimer->next->prev = pTimer->prev;
+    }
+    if(pTimer->prev)
+    {
+        pTimer->prev->next = pTimer->next;
+    }
+    else
+    {
+        *ppHead = pTimer->next;
+        if(!*ppHead && slot != ZMOS_TIMER_WHEEL_DUE)
+        {
+            ZMOS_KERNEL->timerWheelMap[slot / ZMOS_TIMER_WHEEL_SLOTS] &= ~(1UL << (slot % ZMOS_TIMER_WHEEL_SLOTS));
+        }
+    }
+    pTimer->next = NULL;
+    pTimer->prev = NULL;
+}
+/*****************************************************************
+* FUNCTION: zmos_wheelPush
+*
+* DESCRIPTION:
+*     Put a timer to the head of a wheel slot.
+* INPUTS:
+*     pTimer : timer.
+*     slot : Index of the slot, ZMOS_TIMER_WHEEL_DUE : the due list.
+* RETURNS:
+*     null
+* NOTE:
+*     Called in critical.
+*****************************************************************/
+static void zmos_wheelPush(zmos_timer_t *pTimer, uint8_t slot)
+{
+    zmos_timer_t **ppHead;
+    
+    if(slot == ZMOS_TIMER_WHEEL_DUE)
+    {
+        ppHead = &ZMOS_KERNEL->timerListHead;
+    }
+    else
+    {
+        ppHead = &ZMOS_KERNEL->timerWheel[slot];
+        ZMOS_KERNEL->timerWheelMap[slot / ZMOS_TIMER_WHEEL_SLOTS] |= 1UL << (slot % ZMOS_TIMER_WHEEL_SLOTS);
+    }
+    pTimer->slot = slot;
+    pTimer->prev = NULL;
+    pTimer->next = *ppHead;
+    if(*ppHead)
+    {
+        (*ppHead)->prev = pTimer;
+    }
+    *ppHead = pTimer;
+}
+/*****************************************************************
+* FUNCTION: zmos_wheelAdd
+*
+* DESCRIPTION:
+*     Put a timer to the slot of its expiry time.
+* INPUTS:
+*     pTimer : timer, its timeout is the expiry time.
+* RETURNS:
+*     null
+* NOTE:
+*     The level is selected by the ticks to the expiry, level n
+*     holds the timers of less than 32^(n+1) ticks. Called in
+*     critical.
+*****************************************************************/
+static void zmos_wheelAdd(zmos_timer_t *pTimer)
+{
+    uint32_t ticks = pTimer->timeout - ZMOS_KERNEL->timerWheelTime;
+    uint8_t level = 0;
+    
+    if(ticks >= ZMOS_TIMER_WHEEL_SLOTS)
+    {
+        level = ZMOS_HIGHEST_BIT(ticks) / ZMOS_TIMER_WHEEL_BITS;
+    }
+    zmos_wheelPush(pTimer, level * ZMOS_TIMER_WHEEL_SLOTS +
+                   ((pTimer->timeout >> (level * ZMOS_TIMER_WHEEL_BITS)) & (ZMOS_TIMER_WHEEL_SLOTS - 1)));
+}
+/*****************************************************************
+* FUNCTION: zmos_wheelNextTick
+*
+* DESCRIPTION:
+*     Get the ticks from the wheel time to the next tick to work,
+*     the expiry of the level 0 or the move of a higher level.
+* INPUTS:
+*     null
+* RETURNS:
+*     The ticks to the next tick to work.
+*     TIMER_MAX_TIMEOUT : The wheel is empty.
+* NOTE:
+*     Find the next slot of each level by the bitmap. Called in
+*     critical.
+*****************************************************************/
+static uint32_t zmos_wheelNextTick(void)
+{
+    uint32_t time = ZMOS_KERNEL->timerWheelTime;
+    uint32_t next = TIMER_MAX_TIMEOUT;
+    uint32_t ticks;
+    uint32_t lower;
+    uint32_t map;
+    uint8_t shift;
+    uint8_t index;
+    
+    for(uint8_t level = 0; level < ZMOS_TIMER_WHEEL_LEVELS; level++)
+    {
+        map = ZMOS_KERNEL->timerWheelMap[level];
+        if(!map) continue;
+    
+        shift = level * ZMOS_TIMER_WHEEL_BITS;
+        index = (time >> shift) & (ZMOS_TIMER_WHEEL_SLOTS - 1);
+        lower = time & ((1UL << shift) - 1);
+        //Rotate the current slot to bit 0.
+        if(index)
+        {
+            map = (map >> index) | (map << (ZMOS_TIMER_WHEEL_SLOTS - index));
+        }
+        //The current slot has been passed, it comes after a round.
+        if(lower && (map & 1UL) && !(map & ~1UL))
+        {
+            ticks = ((uint32_t)ZMOS_TIMER_WHEEL_SLOTS << shift) - lower;
+        }
+        else
+        {
+            if(lower) map &= ~1UL;
+            ticks = ((uint32_t)ZMOS_CTZ(map) << shift) - lower;
+        }
+        if(ticks < next)
+        {
+            next = ticks;
+        }
+    }
+    return next;
+}
+/*****************************************************************
+* FUNCTION: zmos_wheelTick
+*
+* DESCRIPTION:
+*     Run the tick of the wheel time, move the timers of the
+*     higher levels down and the timers expired to the due list.
+* INPUTS:
+*     null
+* RETURNS:
+*     null
+* NOTE:
+*     Called in critical.
+*****************************************************************/
+static void zmos_wheelTick(void)
+{
+    uint32_t time = ZMOS_KERNEL->timerWheelTime;
+    zmos_timer_t *pTimer;
+    zmos_timer_t *pNext;
+    uint8_t slot;
+    
+    //The lower levels are at slot 0, move the slot of the level.
+    for(uint8_t level = 1; level < ZMOS_TIMER_WHEEL_LEVELS; level++)
+    {
+        if(time & ((1UL << (level * ZMOS_TIMER_WHEEL_BITS)) - 1)) break;
+    
+        slot = level * ZMOS_TIMER_WHEEL_SLOTS + ((time >> (level * ZMOS_TIMER_WHEEL_BITS)) & (ZMOS_TIMER_WHEEL_SLOTS - 1));
+        pTimer = ZMOS_KERNEL->timerWheel[slot];
+        ZMOS_KERNEL->timerWheel[slot] = NULL;
+        ZMOS_KERNEL->timerWheelMap[level] &= ~(1UL << (slot % ZMOS_TIMER_WHEEL_SLOTS));
+        while(pTimer)
+        {
+            pNext = pTimer->next;
+            zmos_wheelAdd(pTimer);
+            pTimer = pNext;
+        }
+    }
+    //Expired
+    slot = time & (ZMOS_TIMER_WHEEL_SLOTS - 1);
+    pTimer = ZMOS_KERNEL->timerWheel[slot];
+    ZMOS_KERNEL->timerWheel[slot] = NULL;
+    ZMOS_KERNEL->timerWheelMap[0] &= ~(1UL << slot);
+    while(pTimer)
+    {
+        pNext = pTimer->next;
+        zmos_wheelPush(pTimer, ZMOS_TIMER_WHEEL_DUE);
+        pTimer = pNext;
     }
+    ZMOS_KERNEL->timerWheelTime = time + 1;
 }
+#endif
 /****************************************************** END OF FILE ******************************************************/
@@ -0,0 +1,261 @@
+/*****************************************************************
+* Copyright (C) 2026 zm. All rights reserved.                    *
+******************************************************************
+* ZMOS_Topic.c
+*
+* DESCRIPTION:
+*     ZMOS topic publish/subscribe.
+* AUTHOR:
+*     zm
+* CREATED DATE:
+*     2026/10/17
+* REVISION:
+*     v0.1
+*
+* MODIFICATION HISTORY
+* --------------------
+* $Log:$
+*
+*****************************************************************/
+ 
+/*************************************************************************************************************************
+ *                                                       INCLUDES                                                        *
+ *************************************************************************************************************************/
+#include "ZMOS_Common.h"
+#include "ZMOS_Tasks.h"
+#include "ZMOS_Topic.h"
+#include "ZMOS.h"
+
+#if ZMOS_USE_TOPIC
+/*************************************************************************************************************************
+ *                                                        MACROS                                                         *
+ *************************************************************************************************************************/
+#if (ZMOS_TOPIC_SUBSCRIBER_MAX > 32) || (ZMOS_TOPIC_SUBSCRIBER_MAX == 0)
+#error "ZMOS_TOPIC_SUBSCRIBER_MAX must be 1 ~ 32!"
+#endif
+#if (ZMOS_TOPIC_NUM > 255) || (ZMOS_TOPIC_NUM == 0)
+#error "ZMOS_TOPIC_NUM must be 1 ~ 255!"
+#endif
+/*************************************************************************************************************************
+ *                                                      CONSTANTS                                                        *
+ *************************************************************************************************************************/
+ 
+/*************************************************************************************************************************
+ *                                                       TYPEDEFS                                                        *
+ *************************************************************************************************************************/
+ 
+/*************************************************************************************************************************
+ *                                                   GLOBAL VARIABLES                                                    *
+ *************************************************************************************************************************/
+ 
+/*************************************************************************************************************************
+ *                                                  EXTERNAL VARIABLES                                                   *
+ *************************************************************************************************************************/
+ 
+/*************************************************************************************************************************
+ *                                                    LOCAL VARIABLES                                                    *
+ *************************************************************************************************************************/
+ 
+/*************************************************************************************************************************
+ *                                                 FUNCTION DECLARATIONS                                                 *
+ *************************************************************************************************************************/
+static void zmos_topicSubscriberFree(uint32_t subscribers);
+/*************************************************************************************************************************
+ *                                                   PUBLIC FUNCTIONS                                                    *
+ *************************************************************************************************************************/
+/*****************************************************************
+* FUNCTION: zmos_subscribe
+*
+* DESCRIPTION:
+*     This function to subscribe the task event to the topic.
+* INPUTS:
+*     pTaskHandle : The handle of the task, NULL is the current task.
+*     topic : The topic id(0 ~ ZMOS_TOPIC_NUM - 1).
+*     event : The event set to the task when the topic is published.
+* RETURNS:
+*     0 : Success (ZMOS_TASK_SUCCESS).
+*     other : ref ZMOS task return cordes.
+* NOTE:
+*     The same task and event subscribed to many topics takes one
+*     subscriber. Return ZMOS_TASK_FAILD when the subscribers are
+*     more than ZMOS_TOPIC_SUBSCRIBER_MAX.
+*****************************************************************/
+taskReslt_t zmos_subscribe(zmos_taskHandle_t pTaskHandle, topicId_t topic, uTaskEvent_t event)
+{
+    zmos_topicSubscriber_t *pSubscriber;
+    uint8_t freeIndex = ZMOS_TOPIC_SUBSCRIBER_MAX;
+    uint8_t i;
+    
+    if(pTaskHandle == NULL)
+    {
+        pTaskHandle = ZMOS_KERNEL->activeTask;
+    }
+    if(!pTaskHandle || !event || topic >= ZMOS_TOPIC_NUM) return ZMOS_TASK_ERROR_PARAM;
+    
+    ZMOS_ENTER_CRITICAL();
+    for(i = 0; i < ZMOS_TOPIC_SUBSCRIBER_MAX; i++)
+    {
+        pSubscriber = &ZMOS_KERNEL->topicSubscribers[i];
+        if(pSubscriber->taskHandle == pTaskHandle && pSubscriber->event == event)
+        {
+            break;
+        }
+        if(!pSubscriber->taskHandle && freeIndex == ZMOS_TOPIC_SUBSCRIBER_MAX)
+        {
+            freeIndex = i;
+        }
+    }
+    if(i == ZMOS_TOPIC_SUBSCRIBER_MAX)
+    {
+        if(freeIndex == ZMOS_TOPIC_SUBSCRIBER_MAX)
+        {
+            ZMOS_EXIT_CRITICAL();
+            return ZMOS_TASK_FAILD;
+        }
+        i = freeIndex;
+        ZMOS_KERNEL->topicSubscribers[i].taskHandle = pTaskHandle;
+        ZMOS_KERNEL->topicSubscribers[i].event = event;
+    }
+    ZMOS_KERNEL->topicMaps[topic] |= (uint32_t)1 << i;
+    ZMOS_EXIT_CRITICAL();
+    
+    return ZMOS_TASK_SUCCESS;
+}
+/*****************************************************************
+* FUNCTION: zmos_unsubscribe
+*
+* DESCRIPTION:
+*     This function to unsubscribe the task from the topic.
+* INPUTS:
+*     pTaskHandle : The handle of the task, NULL is the current task.
+*     topic : The topic id(0 ~ ZMOS_TOPIC_NUM - 1).
+* RETURNS:
+*     0 : Success (ZMOS_TASK_SUCCESS).
+*     other : ref ZMOS task return cordes.
+* NOTE:
+*     The unregistered task is unsubscribed from all topics.
+*****************************************************************/
+taskReslt_t zmos_unsubscribe(zmos_taskHandle_t pTaskHandle, topicId_t topic)
+{
+    uint32_t subscribers = 0;
+    
+    if(pTaskHandle == NULL)
+    {
+        pTaskHandle = ZMOS_KERNEL->activeTask;
+    }
+    if(!pTaskHandle || topic >= ZMOS_TOPIC_NUM) return ZMOS_TASK_ERROR_PARAM;
+    
+    ZMOS_ENTER_CRITICAL();
+    for(uint8_t i = 0; i < ZMOS_TOPIC_SUBSCRIBER_MAX; i++)
+    {
+        if(ZMOS_KERNEL->topicSubscribers[i].taskHandle == pTaskHandle)
+        {
+            subscribers |= (uint32_t)1 << i;
+        }
+    }
+    ZMOS_KERNEL->topicMaps[topic] &= ~subscribers;
+    zmos_topicSubscriberFree(subscribers);
+    ZMOS_EXIT_CRITICAL();
+    
+    return ZMOS_TASK_SUCCESS;
+}
+/*****************************************************************
+* FUNCTION: zmos_publish
+*
+* DESCRIPTION:
+*     This function to publish the topic, the subscribed event
+*     is set to all subscribers.
+* INPUTS:
+*     topic : The topic id(0 ~ ZMOS_TOPIC_NUM - 1).
+* RETURNS:
+*     0 : Success (ZMOS_TASK_SUCCESS).
+*     other : ref ZMOS task return cordes.
+* NOTE:
+*     All subscribers are set in one critical section, it can be
+*     called in the interrupt.
+*****************************************************************/
+taskReslt_t zmos_publish(topicId_t topic)
+{
+    zmos_topicSubscriber_t *pSubscriber;
+    uint32_t subscribers;
+    
+    if(topic >= ZMOS_TOPIC_NUM) return ZMOS_TASK_ERROR_PARAM;
+    
+    ZMOS_ENTER_CRITICAL();
+    subscribers = ZMOS_KERNEL->topicMaps[topic];
+    while(subscribers)
+    {
+        pSubscriber = &ZMOS_KERNEL->topicSubscribers[ZMOS_CTZ(subscribers)];
+        zmos_setTaskEvent(pSubscriber->taskHandle, pSubscriber->event);
+        subscribers &= subscribers - 1;
+    }
+    ZMOS_EXIT_CRITICAL();
+    
+    return ZMOS_TASK_SUCCESS;
+}
+/*****************************************************************
+* FUNCTION: zmos_topicTaskRemove
+*
+* DESCRIPTION:
+*     Unsubscribe the task from all topics.
+* INPUTS:
+*     pTaskHandle : The handle of the task.
+* RETURNS:
+*     null
+* NOTE:
+*     Called when the task is unregistered.
+*****************************************************************/
+void zmos_topicTaskRemove(zmos_taskHandle_t pTaskHandle)
+{
+    uint32_t subscribers = 0;
+    
+    ZMOS_ENTER_CRITICAL();
+    for(uint8_t i = 0; i < ZMOS_TOPIC_SUBSCRIBER_MAX; i++)
+    {
+        if(ZMOS_KERNEL->topicSubscribers[i].taskHandle == pTaskHandle)
+        {
+            subscribers |= (uint32_t)1 << i;
+        }
+    }
+    for(uint16_t i = 0; i < ZMOS_TOPIC_NUM; i++)
+    {
+        ZMOS_KERNEL->topicMaps[i] &= ~subscribers;
+    }
+    zmos_topicSubscriberFree(subscribers);
+    ZMOS_EXIT_CRITICAL();
+}
+/*************************************************************************************************************************
+ *                                                    LOCAL FUNCTIONS                                                    *
+ *************************************************************************************************************************/
+/*****************************************************************
+* FUNCTION: zmos_topicSubscriberFree
+*
+* DESCRIPTION:
+*     Free the subscribers not used by any topic.
+* INPUTS:
+*     subscribers : The subscribers to check.
+* RETURNS:
+*     null
+* NOTE:
+*     Must be called in critical.
+*****************************************************************/
+static void zmos_topicSubscriberFree(uint32_t subscribers)
+{
+    for(uint16_t i = 0; i < ZMOS_TOPIC_NUM; i++)
+    {
+        subscribers &= ~ZMOS_KERNEL->topicMaps[i];
+    }
+    while(subscribers)
+    {
+        ZMOS_KERNEL->topicSubscribers[ZMOS_CTZ(subscribers)].taskHandle = NULL;
+        subscribers &= subscribers - 1;
+    }
+}
+
+#else
+taskReslt_t zmos_subscribe(zmos_taskHandle_t pTaskHandle, topicId_t topic, uTaskEvent_t event) {return ZMOS_TASK_FAILD;}
+taskReslt_t zmos_unsubscribe(zmos_taskHandle_t pTaskHandle, topicId_t topic) {return ZMOS_TASK_FAILD;}
+taskReslt_t zmos_publish(topicId_t topic) {return ZMOS_TASK_FAILD;}
+void zmos_topicTaskRemove(zmos_taskHandle_t pTaskHandle) {}
+#endif
+/****************************************************** END OF FILE ******************************************************/
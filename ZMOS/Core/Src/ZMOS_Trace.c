@@ -0,0 +1,186 @@
+/*****************************************************************
+* Copyright (C) 2026 zm. All rights reserved.                    *
+******************************************************************
+* ZMOS_Trace.c
+*
+* DESCRIPTION:
+*     ZMOS binary trace recorder.
+* AUTHOR:
+*     zm
+* CREATED DATE:
+*     2026/10/17
+* REVISION:
+*     v0.1
+*
+* MODIFICATION HISTORY
+* --------------------
+* $Log:$
+*
+*****************************************************************/
+ 
+/*************************************************************************************************************************
+ *                                                       INCLUDES                                                        *
+ *************************************************************************************************************************/
+#include "ZMOS_Common.h"
+#include "ZMOS_Trace.h"
+#include "ZMOS.h"
+#include "bsp_clock.h"
+
+#if ZMOS_TRACE
+/*************************************************************************************************************************
+ *                                                        MACROS                                                         *
+ *************************************************************************************************************************/
+#if (ZMOS_TRACE_BUFFER_SIZE & (ZMOS_TRACE_BUFFER_SIZE - 1)) || (ZMOS_TRACE_BUFFER_SIZE > 0x8000) || (ZMOS_TRACE_BUFFER_SIZE == 0)
+#error "ZMOS_TRACE_BUFFER_SIZE must be power of 2!"
+#endif
+#define ZMOS_TRACE_BUFFER_MASK      (ZMOS_TRACE_BUFFER_SIZE - 1)
+/*************************************************************************************************************************
+ *                                                      CONSTANTS                                                        *
+ *************************************************************************************************************************/
+ 
+/*************************************************************************************************************************
+ *                                                       TYPEDEFS                                                        *
+ *************************************************************************************************************************/
+ 
+/*************************************************************************************************************************
+ *                                                   GLOBAL VARIABLES                                                    *
+ *************************************************************************************************************************/
+ 
+/*************************************************************************************************************************
+ *                                                  EXTERNAL VARIABLES                                                   *
+ *************************************************************************************************************************/
+ 
+/*************************************************************************************************************************
+ *                                                    LOCAL VARIABLES                                                    *
+ *************************************************************************************************************************/
+ 
+/*************************************************************************************************************************
+ *                                                 FUNCTION DECLARATIONS                                                 *
+ *************************************************************************************************************************/
+ 
+/*************************************************************************************************************************
+ *                                                   PUBLIC FUNCTIONS                                                    *
+ *************************************************************************************************************************/
+/*****************************************************************
+* FUNCTION: zmos_traceInit
+*
+* DESCRIPTION:
+*     This function to initialize the trace buffer and start the
+*     trace recording.
+* INPUTS:
+*     null
+* RETURNS:
+*     null
+* NOTE:
+*     null
+*****************************************************************/
+void zmos_traceInit(void)
+{
+    zmos_traceBuffer_t *pBuffer = &ZMOS_KERNEL->traceBuffer;
+    
+    pBuffer->magic = ZMOS_TRACE_MAGIC;
+    pBuffer->recordSize = sizeof(zmos_traceRecord_t);
+    pBuffer->recordNum = ZMOS_TRACE_BUFFER_SIZE;
+    pBuffer->index = 0;
+    pBuffer->cycleFreq = ZMOS_TRACE_CYCLE_FREQ;
+    ZMOS_KERNEL->traceEnable = 1;
+}
+/*****************************************************************
+* FUNCTION: zmos_traceRecord
+*
+* DESCRIPTION:
+*     This function to write a record to the trace buffer.
+* INPUTS:
+*     type : ref ZMOS trace record types.
+*     id : Task handle, memory address or user id.
+*     value : Events, size or user value.
+*     param : Timeout or other param.
+* RETURNS:
+*     null
+* NOTE:
+*     Use ZMOS_TRACE_POINT or ZMOS_TRACE_USER instead.
+*****************************************************************/
+void zmos_traceRecord(uint8_t type, uint32_t id, uint32_t value, uint32_t param)
+{
+    zmos_traceRecord_t *pRecord;
+    uint32_t time;
+    
+    if(!ZMOS_KERNEL->traceEnable) return;
+    
+    ZMOS_ENTER_CRITICAL();
+    //Take the time with the index, the records keep the time order.
+    time = bsp_getCycleCount();
+    pRecord = &ZMOS_KERNEL->traceBuffer.records[ZMOS_KERNEL->traceBuffer.index++ & ZMOS_TRACE_BUFFER_MASK];
+    pRecord->type = type;
+    pRecord->time = time;
+    pRecord->id = id;
+    pRecord->value = value;
+    pRecord->param = param;
+    ZMOS_EXIT_CRITICAL();
+}
+/*****************************************************************
+* FUNCTION: zmos_traceEnable
+*
+* DESCRIPTION:
+*     This function to start or stop the trace recording.
+* INPUTS:
+*     enable : 1 is start, 0 is stop.
+* RETURNS:
+*     null
+* NOTE:
+*     The trace starts after zmos_system_init, stop it to keep
+*     the records of a fault.
+*****************************************************************/
+void zmos_traceEnable(uint8_t enable)
+{
+    ZMOS_KERNEL->traceEnable = enable ? 1 : 0;
+}
+/*****************************************************************
+* FUNCTION: zmos_traceReset
+*
+* DESCRIPTION:
+*     This function to discard all records of the trace buffer.
+* INPUTS:
+*     null
+* RETURNS:
+*     null
+* NOTE:
+*     null
+*****************************************************************/
+void zmos_traceReset(void)
+{
+    ZMOS_ENTER_CRITICAL();
+    ZMOS_KERNEL->traceBuffer.index = 0;
+    ZMOS_EXIT_CRITICAL();
+}
+/*****************************************************************
+* FUNCTION: zmos_traceGetBuffer
+*
+* DESCRIPTION:
+*     This function to get the trace buffer to dump.
+* INPUTS:
+*     pSize : Return the size of the buffer in bytes.
+* RETURNS:
+*     The trace buffer, NULL if the trace is disabled.
+* NOTE:
+*     Stop the trace before dumping, the converter reads the
+*     buffer(zmos_traceBuffer_t) as a binary file.
+*****************************************************************/
+const void *zmos_traceGetBuffer(zm_size_t *pSize)
+{
+    if(pSize) *pSize = sizeof(zmos_traceBuffer_t);
+    
+    return &ZMOS_KERNEL->traceBuffer;
+}
+/*************************************************************************************************************************
+ *                                                    LOCAL FUNCTIONS                                                    *
+ *************************************************************************************************************************/
+
+#else
+void zmos_traceInit(void) {}
+void zmos_traceRecord(uint8_t type, uint32_t id, uint32_t value, uint32_t param) {}
+void zmos_traceEnable(uint8_t enable) {}
+void zmos_traceReset(void) {}
+const void *zmos_traceGetBuffer(zm_size_t *pSize) {if(pSize) *pSize = 0; return NULL;}
+#endif
+/****************************************************** END OF FILE ******************************************************/
@@ -33,7 +33,19 @@ extern "C"
 #include "ZMOS_Tasks.h"
 #include "ZMOS_LowPwr.h"
 #include "ZMOS_Memory.h"
-#if (defined ZMOS_INIT_SECTION) && (ZMOS_INIT_SECTION)
+#include "ZMOS_Msg.h"
+#include "ZMOS_Isr.h"
+#include "ZMOS_Topic.h"
+#include "ZMOS_Thread.h"
+#include "ZMOS_Cyclic.h"
+#include "ZMOS_Job.h"
+#include "ZMOS_Idle.h"
+#include "ZMOS_Hrtimer.h"
+#include "ZMOS_Kernel.h"
+#include "ZMOS_Trace.h"
+#include "ZMOS_Coroutine.h"
+#if ((defined ZMOS_INIT_SECTION) && (ZMOS_INIT_SECTION)) || \
+    ((defined ZMOS_TASK_SECTION) && (ZMOS_TASK_SECTION))
 #include "ZMOS_Section.h"
 #endif
 /*************************************************************************************************************************
@@ -71,6 +83,67 @@ extern "C"
                                  zmos_funcInit const CONCAT_3(zmos_, funcInit, _fn)) = funcInit
 #endif
     
+#if (defined ZMOS_TASK_SECTION) && (ZMOS_TASK_SECTION)
+
+/**
+ * @brief ZMOS task section name.
+ */
+#define ZMOS_TASK_SECTION_NAME      zmos_task
+    
+/**
+ * @brief Define a static ZMOS task in the task section.
+ *
+ * @param[in] name : The task name, used to get the task handle(@ref ZMOS_TASK_HANDLE).
+ * @param[in] func : Task function(@ref taskFunction_t).
+ * @param[in] prio : Task priority(0 ~ ZMOS_TASK_PRIORITY_HIGHEST).
+ */
+#define ZMOS_TASK_DEFINE(name, func, prio)                                                       \
+        STATIC_ASSERT((prio) <= ZMOS_TASK_PRIORITY_HIGHEST, "ZMOS task priority out of range"); \
+        ZM_SECTION_ITEM_REGISTER(ZMOS_TASK_SECTION_NAME, zmos_task_t CONCAT_2(zmos_task_, name)) = \
+        { .event = 0, .taskFunc = (func), .priority = (prio) }
+    
+/**
+ * @brief Define a static ZMOS task with an event handler table in the task section.
+ *
+ * @param[in] name : The task name, used to get the task handle(@ref ZMOS_TASK_HANDLE).
+ * @param[in] table : Event handler array(@ref taskEventHandler_t) indexed by event bit.
+ * @param[in] prio : Task priority(0 ~ ZMOS_TASK_PRIORITY_HIGHEST).
+ */
+#define ZMOS_TASK_TABLE_DEFINE(name, table, prio)                                                \
+        STATIC_ASSERT((prio) <= ZMOS_TASK_PRIORITY_HIGHEST, "ZMOS task priority out of range"); \
+        ZM_SECTION_ITEM_REGISTER(ZMOS_TASK_SECTION_NAME, zmos_task_t CONCAT_2(zmos_task_, name)) = \
+        { .event = 0, .eventTable = (table), .eventTableNum = ARRAY_SIZE(table), .priority = (prio) }
+    
+#if ZMOS_TASK_CONTEXT
+/**
+ * @brief Define a static ZMOS task with user context in the task section.
+ *
+ * @param[in] name : The task name, used to get the task handle(@ref ZMOS_TASK_HANDLE).
+ * @param[in] func : Task function with context(@ref taskContextFunction_t).
+ * @param[in] ctx : The context passed to the task function.
+ * @param[in] prio : Task priority(0 ~ ZMOS_TASK_PRIORITY_HIGHEST).
+ */
+#define ZMOS_TASK_CONTEXT_DEFINE(name, func, ctx, prio)                                          \
+        STATIC_ASSERT((prio) <= ZMOS_TASK_PRIORITY_HIGHEST, "ZMOS task priority out of range"); \
+        ZM_SECTION_ITEM_REGISTER(ZMOS_TASK_SECTION_NAME, zmos_task_t CONCAT_2(zmos_task_, name)) = \
+        { .event = 0, .contextFunc = (func), .context = (ctx), .priority = (prio) }
+#endif
+    
+/**
+ * @brief Declare a static ZMOS task defined in another file.
+ *
+ * @param[in] name : The task name.
+ */
+#define ZMOS_TASK_DECLARE(name)     extern zmos_task_t CONCAT_2(zmos_task_, name)
+    
+/**
+ * @brief Get the handle of a static ZMOS task.
+ *
+ * @param[in] name : The task name.
+ */
+#define ZMOS_TASK_HANDLE(name)      ((zmos_taskHandle_t)&CONCAT_2(zmos_task_, name))
+#endif
+    
     
 #define ZMOS_ENTER_CRITICAL()   zmos_sysEnterCritical()
 #define ZMOS_EXIT_CRITICAL()    zmos_sysExitCritical()
@@ -121,23 +194,833 @@ typedef void (* zmos_funcInit)(void);
 *****************************************************************/
 void zmos_sysEnterCritical(void);
 /*****************************************************************
-* FUNCTION: zmos_sysExitCritical
+* FUNCTION: zmos_sysExitCritical
+*
+* DESCRIPTION:
+*     System exit critical.
+* INPUTS:
+*     null
+* RETURNS:
+*     null
+* NOTE:
+*     null
+*****************************************************************/
+void zmos_sysExitCritical(void);
+/*****************************************************************
+* FUNCTION: zmos_system_init
+*
+* DESCRIPTION:
+*     ZMOS system initialize.
+* INPUTS:
+*     null
+* RETURNS:
+*     null
+* NOTE:
+*     null
+*****************************************************************/
+void zmos_system_init(void);
+/*****************************************************************
+* FUNCTION: zmos_system_start
+*
+* DESCRIPTION:
+*     ZMOS system run start
+* INPUTS:
+*     null
+* RETURNS:
+*     null
+* NOTE:
+*     This function is the main loop function of the task system. 
+*     This Function doesn't return.
+*****************************************************************/
+void zmos_system_start(void);
+/*****************************************************************
+* FUNCTION: zmos_system_run
+*
+* DESCRIPTION:
+*     This function is used to schedule once tasks.
+* INPUTS:
+*     null
+* RETURNS:
+*     null
+* NOTE:
+*     null
+*****************************************************************/
+void zmos_system_run(void);
+
+/*********************************** ZMOS kernel interface *************************************************************/
+
+/*****************************************************************
+* FUNCTION: zmos_kernelInit
+*
+* DESCRIPTION:
+*     This function to initialize a kernel instance and select it.
+* INPUTS:
+*     pKernel : The kernel instance.
+* RETURNS:
+*     null
+* NOTE:
+*     Call zmos_system_init after it to initialize the system
+*     of the kernel.
+*****************************************************************/
+void zmos_kernelInit(zmos_kernel_t *pKernel);
+/*****************************************************************
+* FUNCTION: zmos_kernelSelect
+*
+* DESCRIPTION:
+*     This function to select the kernel used by the calling thread.
+* INPUTS:
+*     pKernel : The kernel instance, NULL is the default kernel.
+* RETURNS:
+*     The kernel selected before.
+* NOTE:
+*     All ZMOS functions called by the thread work on the selected
+*     kernel. A thread can run many kernels in turn, and other
+*     threads set events to the kernel by select it first, the
+*     critical section of the bsp protects the kernel.
+*****************************************************************/
+zmos_kernel_t *zmos_kernelSelect(zmos_kernel_t *pKernel);
+/*****************************************************************
+* FUNCTION: zmos_getKernel
+*
+* DESCRIPTION:
+*     This function to get the kernel used by the calling thread.
+* INPUTS:
+*     null
+* RETURNS:
+*     The kernel instance.
+* NOTE:
+*     null
+*****************************************************************/
+zmos_kernel_t *zmos_getKernel(void);
+/*********************************** ZMOS task interface ***************************************************************/
+
+/*****************************************************************
+* FUNCTION: zmos_taskThreadRegister
+*
+* DESCRIPTION:
+*     Register task thread to ZMOS.
+* INPUTS:
+*     pTaskHandle : The handle of the task.
+*     taskFunc : Task function.
+* RETURNS:
+*     0 : Success (ZMOS_TASK_SUCCESS).
+*     other : ref ZMOS task return cordes.
+* NOTE:
+*     It supports a maximum of 255 tasks.
+*****************************************************************/
+taskReslt_t zmos_taskThreadRegister(zmos_taskHandle_t * const pTaskHandle, taskFunction_t taskFunc);
+/*****************************************************************
+* FUNCTION: zmos_taskThreadRegisterPriority
+*
+* DESCRIPTION:
+*     Register task thread to ZMOS with priority.
+* INPUTS:
+*     pTaskHandle : The handle of the task.
+*     taskFunc : Task function.
+*     priority : Task priority(0 ~ ZMOS_TASK_PRIORITY_HIGHEST).
+* RETURNS:
+*     0 : Success (ZMOS_TASK_SUCCESS).
+*     other : ref ZMOS task return cordes.
+* NOTE:
+*     If the task is registered, the priority will not be changed.
+*****************************************************************/
+taskReslt_t zmos_taskThreadRegisterPriority(zmos_taskHandle_t * const pTaskHandle, taskFunction_t taskFunc, taskPriority_t priority);
+/*****************************************************************
+* FUNCTION: zmos_taskThreadRegisterTable
+*
+* DESCRIPTION:
+*     Register task thread to ZMOS with an event handler table.
+* INPUTS:
+*     pTaskHandle : The handle of the task.
+*     eventTable : Event handlers indexed by event bit.
+*     tableNum : Number of the event handlers.
+*     priority : Task priority(0 ~ ZMOS_TASK_PRIORITY_HIGHEST).
+* RETURNS:
+*     0 : Success (ZMOS_TASK_SUCCESS).
+*     other : ref ZMOS task return cordes.
+* NOTE:
+*     All pending events are handled within one dispatch, the 
+*     order is set by ZMOS_TASK_EVENT_TABLE_MSB_FIRST. Events 
+*     without handler are discarded.
+*****************************************************************/
+taskReslt_t zmos_taskThreadRegisterTable(zmos_taskHandle_t * const pTaskHandle, const taskEventHandler_t *eventTable, 
+                                         uint8_t tableNum, taskPriority_t priority);
+#if ZMOS_TASK_CONTEXT
+/*****************************************************************
+* FUNCTION: zmos_taskThreadRegisterContext
+*
+* DESCRIPTION:
+*     Register task thread to ZMOS with a user context.
+* INPUTS:
+*     pTaskHandle : The handle of the task(can't be NULL).
+*     taskFunc : Task function with context.
+*     context : The context passed to the task function.
+*     priority : Task priority(0 ~ ZMOS_TASK_PRIORITY_HIGHEST).
+* RETURNS:
+*     0 : Success (ZMOS_TASK_SUCCESS).
+*     other : ref ZMOS task return cordes.
+* NOTE:
+*     The task is identified by the handle, one task function can 
+*     be registered many times with different handles. If the 
+*     handle is a registered task, it's not registered again.
+*****************************************************************/
+taskReslt_t zmos_taskThreadRegisterContext(zmos_taskHandle_t * const pTaskHandle, taskContextFunction_t taskFunc, 
+                                           void *context, taskPriority_t priority);
+#endif
+/*****************************************************************
+* FUNCTION: zmos_setTaskPriority
+*
+* DESCRIPTION:
+*     This function to change the task priority.
+* INPUTS:
+*     pTaskHandle : The handle of the task.
+*     priority : New priority(0 ~ ZMOS_TASK_PRIORITY_HIGHEST).
+* RETURNS:
+*     0 : Success (ZMOS_TASK_SUCCESS).
+*     other : ref ZMOS task return cordes.
+* NOTE:
+*     null
+*****************************************************************/
+taskReslt_t zmos_setTaskPriority(zmos_taskHandle_t pTaskHandle, taskPriority_t priority);
+/*****************************************************************
+* FUNCTION: zmos_setTaskEvent
+*
+* DESCRIPTION:
+*     This function to set task event.
+* INPUTS:
+*     pTaskHandle : The handle of the task to set event.
+*     events : what event to set.
+* RETURNS:
+*     0 : Success (ZMOS_TASK_SUCCESS).
+*     other : ref ZMOS task return cordes.
+* NOTE:
+*     null
+*****************************************************************/
+taskReslt_t zmos_setTaskEvent(zmos_taskHandle_t pTaskHandle, uTaskEvent_t events);
+/*****************************************************************
+* FUNCTION: zmos_clearTaskEvent
+*
+* DESCRIPTION:
+*     This function to clear task event.
+* INPUTS:
+*     pTaskHandle : The handle of the task to clear event.
+*     events : what event to clear.
+* RETURNS:
+*     0 : Success (ZMOS_TASK_SUCCESS).
+*     other : ref ZMOS task return cordes.
+* NOTE:
+*     null
+*****************************************************************/
+taskReslt_t zmos_clearTaskEvent(zmos_taskHandle_t pTaskHandle, uTaskEvent_t events);
+/*****************************************************************
+* FUNCTION: zmos_setTaskEventCounter
+*
+* DESCRIPTION:
+*     This function to enable counting of task events.
+* INPUTS:
+*     pTaskHandle : The handle of the task.
+*     events : The events to count.
+*     counters : Counter array of ZMOS_TASK_EVENT_NUM_MAX, indexed
+*                  by event bit. NULL to disable counting.
+* RETURNS:
+*     0 : Success (ZMOS_TASK_SUCCESS).
+*     other : ref ZMOS task return cordes.
+* NOTE:
+*     Each zmos_setTaskEvent of a counted event increases its
+*     counter, the counter saturates at 255.
+*****************************************************************/
+taskReslt_t zmos_setTaskEventCounter(zmos_taskHandle_t pTaskHandle, uTaskEvent_t events, uint8_t *counters);
+/*****************************************************************
+* FUNCTION: zmos_takeTaskEventCount
+*
+* DESCRIPTION:
+*     This function to read and clear the count of a task event.
+* INPUTS:
+*     pTaskHandle : The handle of the task, NULL is the current task.
+*     event : The event to read(only one bit).
+* RETURNS:
+*     The number of times the event was set since last taken.
+* NOTE:
+*     null
+*****************************************************************/
+uint8_t zmos_takeTaskEventCount(zmos_taskHandle_t pTaskHandle, uTaskEvent_t event);
+/*****************************************************************
+* FUNCTION: zmos_getTaskMergedEvents
+*
+* DESCRIPTION:
+*     This function to get the number of merged event signals.
+* INPUTS:
+*     pTaskHandle : The handle of the task.
+* RETURNS:
+*     The number of times an event was set while it was still pending.
+* NOTE:
+*     null
+*****************************************************************/
+uint32_t zmos_getTaskMergedEvents(zmos_taskHandle_t pTaskHandle);
+#if ZMOS_TASK_STATS
+/*****************************************************************
+* FUNCTION: zmos_getTaskStats
+*
+* DESCRIPTION:
+*     This function to get a snapshot of the task statistics.
+* INPUTS:
+*     pTaskHandle : The handle of the task.
+*     pStats : Return the statistics.
+* RETURNS:
+*     0 : Success (ZMOS_TASK_SUCCESS).
+*     other : ref ZMOS task return cordes.
+* NOTE:
+*     Only valid when ZMOS_TASK_STATS is enabled.
+*****************************************************************/
+taskReslt_t zmos_getTaskStats(zmos_taskHandle_t pTaskHandle, zmos_taskStats_t *pStats);
+/*****************************************************************
+* FUNCTION: zmos_getIdleStats
+*
+* DESCRIPTION:
+*     This function to get a snapshot of the idle function statistics.
+* INPUTS:
+*     pStats : Return the statistics.
+* RETURNS:
+*     0 : Success (ZMOS_TASK_SUCCESS).
+*     other : ref ZMOS task return cordes.
+* NOTE:
+*     dispatchCount is the number of times the idle function was run.
+*****************************************************************/
+taskReslt_t zmos_getIdleStats(zmos_taskStats_t *pStats);
+/*****************************************************************
+* FUNCTION: zmos_resetTaskStats
+*
+* DESCRIPTION:
+*     This function to reset the task statistics.
+* INPUTS:
+*     pTaskHandle : The handle of the task, NULL to reset all tasks and idle.
+* RETURNS:
+*     0 : Success (ZMOS_TASK_SUCCESS).
+*     other : ref ZMOS task return cordes.
+* NOTE:
+*     null
+*****************************************************************/
+taskReslt_t zmos_resetTaskStats(zmos_taskHandle_t pTaskHandle);
+#endif
+#if ZMOS_TASK_LATENCY
+/*****************************************************************
+* FUNCTION: zmos_setTaskLatencyRecord
+*
+* DESCRIPTION:
+*     This function to attach the latency record to the task.
+* INPUTS:
+*     pTaskHandle : The handle of the task.
+*     pLatency : The latency record, NULL to stop recording.
+* RETURNS:
+*     0 : Success (ZMOS_TASK_SUCCESS).
+*     other : ref ZMOS task return cordes.
+* NOTE:
+*     The latency from the first set of a pending event to the
+*     dispatch of the event is recorded.
+*****************************************************************/
+taskReslt_t zmos_setTaskLatencyRecord(zmos_taskHandle_t pTaskHandle, zmos_taskLatency_t *pLatency);
+/*****************************************************************
+* FUNCTION: zmos_resetTaskLatency
+*
+* DESCRIPTION:
+*     This function to reset the latency record of the task.
+* INPUTS:
+*     pTaskHandle : The handle of the task.
+* RETURNS:
+*     0 : Success (ZMOS_TASK_SUCCESS).
+*     other : ref ZMOS task return cordes.
+* NOTE:
+*     null
+*****************************************************************/
+taskReslt_t zmos_resetTaskLatency(zmos_taskHandle_t pTaskHandle);
+/*****************************************************************
+* FUNCTION: zmos_getTaskLatencyPercentile
+*
+* DESCRIPTION:
+*     This function to get the latency percentile of the task.
+* INPUTS:
+*     pTaskHandle : The handle of the task.
+*     percent : The percentile(1 ~ 100).
+* RETURNS:
+*     The upper bound of the histogram bucket of the percentile.
+* NOTE:
+*     Minimum and maximum are read from the latency record.
+*****************************************************************/
+uint32_t zmos_getTaskLatencyPercentile(zmos_taskHandle_t pTaskHandle, uint8_t percent);
+#endif
+#if ZMOS_TASK_BUDGET
+/*****************************************************************
+* FUNCTION: zmos_setTaskBudget
+*
+* DESCRIPTION:
+*     This function to set the execution budget of the task.
+* INPUTS:
+*     pTaskHandle : The handle of the task, NULL to set the default
+*                   budget of all tasks.
+*     budget : The budget in bsp_getCycleCount unit, 0 of the task
+*              uses the default budget, 0 of the default is no budget.
+* RETURNS:
+*     0 : Success (ZMOS_TASK_SUCCESS).
+*     other : ref ZMOS task return cordes.
+* NOTE:
+*     The default budget is ZMOS_TASK_BUDGET_DEFAULT.
+*****************************************************************/
+taskReslt_t zmos_setTaskBudget(zmos_taskHandle_t pTaskHandle, uint32_t budget);
+/*****************************************************************
+* FUNCTION: zmos_setTaskBudgetHook
+*
+* DESCRIPTION:
+*     This function to set the hooks called when a task is over
+*     the budget.
+* INPUTS:
+*     overrunHook : Called on each overrun, NULL is none.
+*     escalateHook : Called when a task is over the budget
+*                    ZMOS_TASK_BUDGET_ESCALATE times in a row, NULL is none.
+* RETURNS:
+*     null
+* NOTE:
+*     The hooks are called by the scheduler after the dispatch,
+*     the escalate hook may log the fault and reset the system
+*     or stop feeding the watchdog.
+*****************************************************************/
+void zmos_setTaskBudgetHook(zmosBudgetHook_t overrunHook, zmosBudgetHook_t escalateHook);
+/*****************************************************************
+* FUNCTION: zmos_getTaskBudgetStats
+*
+* DESCRIPTION:
+*     This function to get a snapshot of the task budget statistics.
+* INPUTS:
+*     pTaskHandle : The handle of the task.
+*     pStats : Return the statistics.
+* RETURNS:
+*     0 : Success (ZMOS_TASK_SUCCESS).
+*     other : ref ZMOS task return cordes.
+* NOTE:
+*     null
+*****************************************************************/
+taskReslt_t zmos_getTaskBudgetStats(zmos_taskHandle_t pTaskHandle, zmos_taskBudgetStats_t *pStats);
+/*****************************************************************
+* FUNCTION: zmos_resetTaskBudgetStats
+*
+* DESCRIPTION:
+*     This function to reset the task budget statistics.
+* INPUTS:
+*     pTaskHandle : The handle of the task, NULL to reset all tasks.
+* RETURNS:
+*     0 : Success (ZMOS_TASK_SUCCESS).
+*     other : ref ZMOS task return cordes.
+* NOTE:
+*     null
+*****************************************************************/
+taskReslt_t zmos_resetTaskBudgetStats(zmos_taskHandle_t pTaskHandle);
+#endif
+#if ZMOS_TASK_PERIODIC
+/*****************************************************************
+* FUNCTION: zmos_setTaskPeriodic
+*
+* DESCRIPTION:
+*     This function to make the task periodic, the event is set to
+*     the task as a job each period.
+* INPUTS:
+*     pTaskHandle : The handle of the task, NULL is the current task.
+*     period : The period in timer clock(ms), 0 to stop.
+*     deadline : The deadline from the release, 0 is the period.
+*     offset : The first release from now.
+*     event : The event of the job.
+* RETURNS:
+*     0 : Success (ZMOS_TASK_SUCCESS).
+*     other : ref ZMOS task return cordes.
+* NOTE:
+*     The releases are at fixed times of the period, the job is
+*     done when the task returns with the event cleared. Setting
+*     again restarts the releases and resets the statistics.
+*****************************************************************/
+taskReslt_t zmos_setTaskPeriodic(zmos_taskHandle_t pTaskHandle, uint32_t period, uint32_t deadline, 
+                                 uint32_t offset, uTaskEvent_t event);
+/*****************************************************************
+* FUNCTION: zmos_getTaskDeadlineStats
+*
+* DESCRIPTION:
+*     This function to get a snapshot of the task deadline statistics.
+* INPUTS:
+*     pTaskHandle : The handle of the task.
+*     pStats : Return the statistics.
+* RETURNS:
+*     0 : Success (ZMOS_TASK_SUCCESS).
+*     other : ref ZMOS task return cordes.
+* NOTE:
+*     null
+*****************************************************************/
+taskReslt_t zmos_getTaskDeadlineStats(zmos_taskHandle_t pTaskHandle, zmos_taskDeadlineStats_t *pStats);
+/*****************************************************************
+* FUNCTION: zmos_resetTaskDeadlineStats
+*
+* DESCRIPTION:
+*     This function to reset the task deadline statistics.
+* INPUTS:
+*     pTaskHandle : The handle of the task, NULL to reset all tasks.
+* RETURNS:
+*     0 : Success (ZMOS_TASK_SUCCESS).
+*     other : ref ZMOS task return cordes.
+* NOTE:
+*     null
+*****************************************************************/
+taskReslt_t zmos_resetTaskDeadlineStats(zmos_taskHandle_t pTaskHandle);
+#endif
+/*****************************************************************
+* FUNCTION: zmos_setIdleTaskFunction
+*
+* DESCRIPTION:
+*     This function to set the idle task function.
+* INPUTS:
+*     func : idle task function.
+* RETURNS:
+*     null
+* NOTE:
+*     null
+*****************************************************************/
+void zmos_setIdleTaskFunction(idleTaskFunc func);
+/*****************************************************************
+* FUNCTION: zmos_getCurrentTaskHandle
+*
+* DESCRIPTION:
+*     This function to gets the handle to the current task.
+* INPUTS:
+*     null
+* RETURNS:
+*     Current task handle.
+*     NULL : No tasks are currently running.
+* NOTE:
+*     null
+*****************************************************************/
+zmos_taskHandle_t zmos_getCurrentTaskHandle(void);
+#if ZMOS_TASK_CONTEXT
+/*****************************************************************
+* FUNCTION: zmos_getCurrentTaskContext
+*
+* DESCRIPTION:
+*     This function to get the context of the current task.
+* INPUTS:
+*     null
+* RETURNS:
+*     The context of the current task.
+*     NULL : No tasks are currently running or no context.
+* NOTE:
+*     null
+*****************************************************************/
+void *zmos_getCurrentTaskContext(void);
+#endif
+/*****************************************************************
+* FUNCTION: zmos_checkTaskIsIdle
+*
+* DESCRIPTION:
+*     This function to check task is idle.
+* INPUTS:
+*     null
+* RETURNS:
+*     0:task idle
+*     1:task busy
+* NOTE:
+*     null
+*****************************************************************/
+uint8_t zmos_checkTaskIsIdle(void);
+/*****************************************************************
+* FUNCTION: zmos_getStaticTaskNum
+*
+* DESCRIPTION:
+*     This function to get the number of static tasks.
+* INPUTS:
+*     null
+* RETURNS:
+*     Number of tasks defined by ZMOS_TASK_DEFINE.
+* NOTE:
+*     null
+*****************************************************************/
+uint16_t zmos_getStaticTaskNum(void);
+/*****************************************************************
+* FUNCTION: zmos_getTaskIndex
+*
+* DESCRIPTION:
+*     This function to get the index of a static task.
+* INPUTS:
+*     pTaskHandle : The handle of the task.
+* RETURNS:
+*     The index of the task in the task section.
+*     ZMOS_TASK_INVALID_INDEX : Not a static task.
+* NOTE:
+*     null
+*****************************************************************/
+uint16_t zmos_getTaskIndex(zmos_taskHandle_t pTaskHandle);
+/*****************************************************************
+* FUNCTION: zmos_getTaskHandleByIndex
+*
+* DESCRIPTION:
+*     This function to get the handle of a static task by index.
+* INPUTS:
+*     index : The index of the task in the task section.
+* RETURNS:
+*     Task handle.
+*     NULL : Index out of range.
+* NOTE:
+*     null
+*****************************************************************/
+zmos_taskHandle_t zmos_getTaskHandleByIndex(uint16_t index);
+
+
+/*********************************** ZMOS message interface *************************************************************/
+
+/*****************************************************************
+* FUNCTION: zmos_msgAlloc
+*
+* DESCRIPTION:
+*     Allocate a message buffer from the ZMOS heap.
+* INPUTS:
+*     len : Message payload length.
+* RETURNS:
+*     Pointer to the message payload.
+*     NULL : Out of memory.
+* NOTE:
+*     Don't call it in the interrupt.
+*****************************************************************/
+void *zmos_msgAlloc(uint16_t len);
+/*****************************************************************
+* FUNCTION: zmos_msgSend
+*
+* DESCRIPTION:
+*     Send a message to the task, the message is linked
+*     into the task message queue without copying.
+* INPUTS:
+*     pTaskHandle : The handle of the task to receive.
+*     pMsg : The message allocated by zmos_msgAlloc.
+* RETURNS:
+*     0 : Success (ZMOS_TASK_SUCCESS).
+*     other : ref ZMOS task return cordes.
+* NOTE:
+*     The ZMOS_TASK_MSG_EVENT will be set to the task.
+*****************************************************************/
+taskReslt_t zmos_msgSend(zmos_taskHandle_t pTaskHandle, void *pMsg);
+/*****************************************************************
+* FUNCTION: zmos_msgReceive
+*
+* DESCRIPTION:
+*     Receive a message from the task message queue.
+* INPUTS:
+*     pTaskHandle : The handle of the task, NULL is the current task.
+* RETURNS:
+*     Pointer to the message payload.
+*     NULL : No message.
+* NOTE:
+*     The message must be freed by zmos_msgFree.
+*****************************************************************/
+void *zmos_msgReceive(zmos_taskHandle_t pTaskHandle);
+/*****************************************************************
+* FUNCTION: zmos_msgFree
+*
+* DESCRIPTION:
+*     Free a message.
+* INPUTS:
+*     pMsg : The message to free.
+* RETURNS:
+*     null
+* NOTE:
+*     null
+*****************************************************************/
+void zmos_msgFree(void *pMsg);
+/*****************************************************************
+* FUNCTION: zmos_msgGetLength
+*
+* DESCRIPTION:
+*     Get the payload length of a message.
+* INPUTS:
+*     pMsg : The message.
+* RETURNS:
+*     The message payload length.
+* NOTE:
+*     null
+*****************************************************************/
+uint16_t zmos_msgGetLength(void *pMsg);
+
+/*********************************** ZMOS interrupt interface ***********************************************************/
+
+/*****************************************************************
+* FUNCTION: zmos_setTaskEventFromISR
+*
+* DESCRIPTION:
+*     This function to set task event in the interrupt.
+* INPUTS:
+*     pTaskHandle : The handle of the task to set event.
+*     events : what event to set.
+* RETURNS:
+*     0 : Success (ZMOS_TASK_SUCCESS).
+*     other : ref ZMOS task return cordes.
+* NOTE:
+*     The interrupts are not disabled, the events are passed to
+*     the task by the next schedule. The task posted by the 
+*     interrupt shouldn't be unregistered.
+*****************************************************************/
+taskReslt_t zmos_setTaskEventFromISR(zmos_taskHandle_t pTaskHandle, uTaskEvent_t events);
+/*****************************************************************
+* FUNCTION: zmos_deferCallFromISR
+*
+* DESCRIPTION:
+*     This function to defer a function call from the interrupt to
+*     the task context.
+* INPUTS:
+*     func : The function to call.
+*     arg : The param of the function.
+* RETURNS:
+*     0 : Success (ZMOS_TASK_SUCCESS).
+*     other : ref ZMOS task return cordes.
+* NOTE:
+*     Single producer, only one interrupt(or the interrupts of the
+*     same priority) can call it. Return ZMOS_TASK_FAILD when
+*     the ring is full.
+*****************************************************************/
+taskReslt_t zmos_deferCallFromISR(zmosDeferFunc_t func, void *arg);
+/*********************************** ZMOS topic interface ***************************************************************/
+
+/*****************************************************************
+* FUNCTION: zmos_subscribe
+*
+* DESCRIPTION:
+*     This function to subscribe the task event to the topic.
+* INPUTS:
+*     pTaskHandle : The handle of the task, NULL is the current task.
+*     topic : The topic id(0 ~ ZMOS_TOPIC_NUM - 1).
+*     event : The event set to the task when the topic is published.
+* RETURNS:
+*     0 : Success (ZMOS_TASK_SUCCESS).
+*     other : ref ZMOS task return cordes.
+* NOTE:
+*     The same task and event subscribed to many topics takes one
+*     subscriber. Return ZMOS_TASK_FAILD when the subscribers are
+*     more than ZMOS_TOPIC_SUBSCRIBER_MAX.
+*****************************************************************/
+taskReslt_t zmos_subscribe(zmos_taskHandle_t pTaskHandle, topicId_t topic, uTaskEvent_t event);
+/*****************************************************************
+* FUNCTION: zmos_unsubscribe
+*
+* DESCRIPTION:
+*     This function to unsubscribe the task from the topic.
+* INPUTS:
+*     pTaskHandle : The handle of the task, NULL is the current task.
+*     topic : The topic id(0 ~ ZMOS_TOPIC_NUM - 1).
+* RETURNS:
+*     0 : Success (ZMOS_TASK_SUCCESS).
+*     other : ref ZMOS task return cordes.
+* NOTE:
+*     The unregistered task is unsubscribed from all topics.
+*****************************************************************/
+taskReslt_t zmos_unsubscribe(zmos_taskHandle_t pTaskHandle, topicId_t topic);
+/*****************************************************************
+* FUNCTION: zmos_publish
+*
+* DESCRIPTION:
+*     This function to publish the topic, the subscribed event
+*     is set to all subscribers.
+* INPUTS:
+*     topic : The topic id(0 ~ ZMOS_TOPIC_NUM - 1).
+* RETURNS:
+*     0 : Success (ZMOS_TASK_SUCCESS).
+*     other : ref ZMOS task return cordes.
+* NOTE:
+*     All subscribers are set in one critical section, it can be
+*     called in the interrupt.
+*****************************************************************/
+taskReslt_t zmos_publish(topicId_t topic);
+    
+/*********************************** ZMOS thread interface **************************************************************/
+
+/*****************************************************************
+* FUNCTION: zmos_threadCreate
+*
+* DESCRIPTION:
+*     This function to create a preemptive thread.
+* INPUTS:
+*     pThread : The thread.
+*     func : The thread function.
+*     arg : The param of the thread function.
+*     stack : The stack of the thread.
+*     stackSize : The stack size in bytes.
+*     priority : Thread priority(0 ~ ZMOS_THREAD_PRIORITY_NUM - 1).
+* RETURNS:
+*     0 : Success (ZMOS_TASK_SUCCESS).
+*     other : ref ZMOS task return cordes.
+* NOTE:
+*     Call it after zmos_system_init. All threads preempt the
+*     tasks, one thread of each priority, return ZMOS_TASK_FAILD
+*     when the priority is used.
+*****************************************************************/
+taskReslt_t zmos_threadCreate(zmos_thread_t *pThread, zmosThreadFunc_t func, void *arg,
+                              void *stack, zm_size_t stackSize, uint8_t priority);
+/*****************************************************************
+* FUNCTION: zmos_threadSetEvent
+*
+* DESCRIPTION:
+*     This function to set the events of the thread.
+* INPUTS:
+*     pThread : The thread.
+*     events : What events to set.
+* RETURNS:
+*     0 : Success (ZMOS_TASK_SUCCESS).
+*     other : ref ZMOS task return cordes.
+* NOTE:
+*     It can be called by the tasks, threads and interrupts, the
+*     waiting thread preempts at once if it's the highest.
+*****************************************************************/
+taskReslt_t zmos_threadSetEvent(zmos_thread_t *pThread, uTaskEvent_t events);
+/*****************************************************************
+* FUNCTION: zmos_threadWaitEvent
+*
+* DESCRIPTION:
+*     This function to wait any of the events by the current thread.
+* INPUTS:
+*     events : What events to wait.
+* RETURNS:
+*     The events received, they are cleared.
+* NOTE:
+*     Only the thread can wait, it returns 0 at once in the tasks.
+*     The thread signals the tasks by zmos_setTaskEvent.
+*****************************************************************/
+uTaskEvent_t zmos_threadWaitEvent(uTaskEvent_t events);
+/*****************************************************************
+* FUNCTION: zmos_threadSelf
+*
+* DESCRIPTION:
+*     This function to get the current thread.
+* INPUTS:
+*     null
+* RETURNS:
+*     The current thread.
+*     NULL : Run in the tasks.
+* NOTE:
+*     null
+*****************************************************************/
+zmos_thread_t *zmos_threadSelf(void);
+    
+/*********************************** ZMOS cyclic interface **************************************************************/
+
+/*****************************************************************
+* FUNCTION: zmos_cyclicStart
 *
 * DESCRIPTION:
-*     System exit critical.
+*     This function to start the cyclic executive with the schedule table.
 * INPUTS:
-*     null
+*     pTable : The schedule table, it must be kept until stopped.
 * RETURNS:
-*     null
+*     0 : Success (ZMOS_TASK_SUCCESS).
+*     other : ref ZMOS task return cordes.
 * NOTE:
-*     null
+*     The first minor frame starts at once, the frames are aligned
+*     to the timer clock(zmos_getTimerClock). Starting again
+*     replaces the table and resets the statistics.
 *****************************************************************/
-void zmos_sysExitCritical(void);
+taskReslt_t zmos_cyclicStart(const zmos_cyclicTable_t *pTable);
 /*****************************************************************
-* FUNCTION: zmos_system_init
+* FUNCTION: zmos_cyclicStop
 *
 * DESCRIPTION:
-*     ZMOS system initialize.
+*     This function to stop the cyclic executive.
 * INPUTS:
 *     null
 * RETURNS:
@@ -145,26 +1028,26 @@ void zmos_sysExitCritical(void);
 * NOTE:
 *     null
 *****************************************************************/
-void zmos_system_init(void);
+void zmos_cyclicStop(void);
 /*****************************************************************
-* FUNCTION: zmos_system_start
+* FUNCTION: zmos_cyclicGetStats
 *
 * DESCRIPTION:
-*     ZMOS system run start
+*     This function to get the statistics of the cyclic executive.
 * INPUTS:
-*     null
+*     pStats : Return the statistics.
 * RETURNS:
-*     null
+*     0 : Success (ZMOS_TASK_SUCCESS).
+*     other : ref ZMOS task return cordes.
 * NOTE:
-*     This function is the main loop function of the task system. 
-*     This Function doesn't return.
+*     null
 *****************************************************************/
-void zmos_system_start(void);
+taskReslt_t zmos_cyclicGetStats(zmos_cyclicStats_t *pStats);
 /*****************************************************************
-* FUNCTION: zmos_system_run
+* FUNCTION: zmos_cyclicResetStats
 *
 * DESCRIPTION:
-*     This function is used to schedule once tasks.
+*     This function to reset the statistics of the cyclic executive.
 * INPUTS:
 *     null
 * RETURNS:
@@ -172,98 +1055,123 @@ void zmos_system_start(void);
 * NOTE:
 *     null
 *****************************************************************/
-void zmos_system_run(void);
-
-/*********************************** ZMOS task interface ***************************************************************/
+void zmos_cyclicResetStats(void);
+    
+/*********************************** ZMOS job interface *****************************************************************/
 
 /*****************************************************************
-* FUNCTION: zmos_taskThreadRegister
+* FUNCTION: zmos_jobSubmit
 *
 * DESCRIPTION:
-*     Register task thread to ZMOS.
+*     This function to submit a background job.
 * INPUTS:
-*     pTaskHandle : The handle of the task.
-*     taskFunc : Task function.
+*     pJob : The job, it must be kept until done.
+*     step : The step function of the job.
+*     state : The state passed to the step function.
+*     pTaskHandle : The task to notify, NULL is none.
+*     progressEvent : Set to the task when the progress changes, 0 is none.
+*     doneEvent : Set to the task when the job is done, 0 is none.
 * RETURNS:
 *     0 : Success (ZMOS_TASK_SUCCESS).
 *     other : ref ZMOS task return cordes.
 * NOTE:
-*     It supports a maximum of 255 tasks.
+*     The steps run only when no task is ready, in slices of
+*     the budget(zmos_jobSetSlice). Return ZMOS_TASK_FAILD when
+*     the job is queued already.
 *****************************************************************/
-taskReslt_t zmos_taskThreadRegister(zmos_taskHandle_t * const pTaskHandle, taskFunction_t taskFunc);
+taskReslt_t zmos_jobSubmit(zmos_job_t *pJob, zmosJobStep_t step, void *state, 
+                           zmos_taskHandle_t pTaskHandle, uTaskEvent_t progressEvent, uTaskEvent_t doneEvent);
 /*****************************************************************
-* FUNCTION: zmos_setTaskEvent
+* FUNCTION: zmos_jobCancel
 *
 * DESCRIPTION:
-*     This function to set task event.
+*     This function to cancel a background job.
 * INPUTS:
-*     pTaskHandle : The handle of the task to set event.
-*     events : what event to set.
+*     pJob : The job.
 * RETURNS:
 *     0 : Success (ZMOS_TASK_SUCCESS).
 *     other : ref ZMOS task return cordes.
 * NOTE:
-*     null
+*     No event is set to the task of the cancelled job.
 *****************************************************************/
-taskReslt_t zmos_setTaskEvent(zmos_taskHandle_t pTaskHandle, uTaskEvent_t events);
+taskReslt_t zmos_jobCancel(zmos_job_t *pJob);
 /*****************************************************************
-* FUNCTION: zmos_clearTaskEvent
+* FUNCTION: zmos_jobGetProgress
 *
 * DESCRIPTION:
-*     This function to clear task event.
+*     This function to get the progress of a background job.
 * INPUTS:
-*     pTaskHandle : The handle of the task to clear event.
-*     events : what event to clear.
+*     pJob : The job.
 * RETURNS:
-*     0 : Success (ZMOS_TASK_SUCCESS).
-*     other : ref ZMOS task return cordes.
+*     The progress returned by the last step(0 ~ 100).
 * NOTE:
 *     null
 *****************************************************************/
-taskReslt_t zmos_clearTaskEvent(zmos_taskHandle_t pTaskHandle, uTaskEvent_t events);
+uint8_t zmos_jobGetProgress(const zmos_job_t *pJob);
 /*****************************************************************
-* FUNCTION: zmos_setIdleTaskFunction
+* FUNCTION: zmos_jobGetStatus
 *
 * DESCRIPTION:
-*     This function to set the idle task function.
+*     This function to get the status of a background job.
 * INPUTS:
-*     func : idle task function.
+*     pJob : The job.
 * RETURNS:
-*     null
+*     ref ZMOS job status.
 * NOTE:
 *     null
 *****************************************************************/
-void zmos_setIdleTaskFunction(idleTaskFunc func);
+uint8_t zmos_jobGetStatus(const zmos_job_t *pJob);
 /*****************************************************************
-* FUNCTION: zmos_getCurrentTaskHandle
+* FUNCTION: zmos_jobSetSlice
 *
 * DESCRIPTION:
-*     This function to gets the handle to the current task.
+*     This function to set the time budget of a slice of the jobs.
 * INPUTS:
+*     slice : The budget in bsp_getCycleCount unit, 0 is one step.
+* RETURNS:
 *     null
+* NOTE:
+*     The runner stops at once when a task is ready, the budget
+*     bounds the delay by the step in progress.
+*****************************************************************/
+void zmos_jobSetSlice(uint32_t slice);
+    
+/*********************************** ZMOS idle hook interface ***********************************************************/
+
+/*****************************************************************
+* FUNCTION: zmos_idleHookRegister
+*
+* DESCRIPTION:
+*     This function to register an idle hook.
+* INPUTS:
+*     pHook : The idle hook, it must be kept until unregistered.
+*     func : The hook function.
+*     priority : The higher priority hook runs first.
+*     maxTime : The max run time in timer clock(ms).
 * RETURNS:
-*     Current task handle.
-*     NULL : No tasks are currently running.
+*     0 : Success (ZMOS_TASK_SUCCESS).
+*     other : ref ZMOS task return cordes.
 * NOTE:
-*     null
+*     The hook runs in the idle path only when the time to the
+*     next timer is more than maxTime. Return ZMOS_TASK_FAILD
+*     when the hook is registered already.
 *****************************************************************/
-zmos_taskHandle_t zmos_getCurrentTaskHandle(void);
+taskReslt_t zmos_idleHookRegister(zmos_idleHook_t *pHook, zmosIdleHookFunc_t func, uint8_t priority, uint32_t maxTime);
 /*****************************************************************
-* FUNCTION: zmos_checkTaskIsIdle
+* FUNCTION: zmos_idleHookUnregister
 *
 * DESCRIPTION:
-*     This function to check task is idle.
+*     This function to unregister an idle hook.
 * INPUTS:
-*     null
+*     pHook : The idle hook.
 * RETURNS:
-*     0:task idle
-*     1:task busy
+*     0 : Success (ZMOS_TASK_SUCCESS).
+*     other : ref ZMOS task return cordes.
 * NOTE:
 *     null
 *****************************************************************/
-uint8_t zmos_checkTaskIsIdle(void);
-
-
+taskReslt_t zmos_idleHookUnregister(zmos_idleHook_t *pHook);
+    
 /*********************************** ZMOS timer interface ***************************************************************/
 
 /*****************************************************************
@@ -296,6 +1204,27 @@ timerReslt_t zmos_startSingleTimer(zmos_taskHandle_t pTaskHandle, uTaskEvent_t e
 *     null
 *****************************************************************/
 timerReslt_t zmos_startReloadTimer(zmos_taskHandle_t pTaskHandle, uTaskEvent_t event, uint32_t timeout);
+#if ZMOS_TIMER_PERIODIC
+/*****************************************************************
+* FUNCTION: zmos_startPeriodicTimer
+*
+* DESCRIPTION:
+*     This function is called to start a periodic timer, it fires
+*     at the absolute deadlines of the period.
+* INPUTS:
+*     pTaskHandle : Which task to set event.
+*     event : What event to set.
+*     period : Timer period.
+*     policy : The overrun policy(ZMOS_TIMER_OVERRUN_xxx).
+* RETURNS:
+*     0 : success (ZMOS_TIMER_SUCCESS).
+* NOTE:
+*     The lateness of the update does not drift the deadlines, a
+*     deadline passed by the update is an overrun handled by the
+*     policy.
+*****************************************************************/
+timerReslt_t zmos_startPeriodicTimer(zmos_taskHandle_t pTaskHandle, uTaskEvent_t event, uint32_t period, uint8_t policy);
+#endif
 /*****************************************************************
 * FUNCTION: zmos_stopTimer
 *
@@ -338,6 +1267,140 @@ uint32_t zmos_getCurrentTimeout(zmos_taskHandle_t pTaskHandle, uTaskEvent_t even
 *     null
 *****************************************************************/
 uint32_t zmos_getReloadTimeout(zmos_taskHandle_t pTaskHandle, uTaskEvent_t event);
+#if ZMOS_TIMER_PERIODIC
+/*****************************************************************
+* FUNCTION: zmos_getTimerMissedCount
+*
+* DESCRIPTION:
+*     Get the number of the periods missed of a periodic timer.
+* INPUTS:
+*     pTaskHandle : task handle of timer to check.
+*     event : task event of timer to check.
+* RETURNS:
+*     The periods missed since the last read.
+* NOTE:
+*     The count is cleared by the read, only the timer of
+*     ZMOS_TIMER_OVERRUN_COUNT counts.
+*****************************************************************/
+uint32_t zmos_getTimerMissedCount(zmos_taskHandle_t pTaskHandle, uTaskEvent_t event);
+#endif
+/*****************************************************************
+* FUNCTION: zmos_timerCreate
+*
+* DESCRIPTION:
+*     This function is called to create a timer handle of the
+*     task event, the timer is stopped.
+* INPUTS:
+*     pTaskHandle : Which task to set event.
+*     event : What event to set.
+* RETURNS:
+*     The timer handle.
+*     NULL : No memory or the timer already has a handle.
+* NOTE:
+*     The running timer of the event is taken by the handle. The
+*     timer is kept until zmos_timerDelete.
+*****************************************************************/
+zmos_timerHandle_t zmos_timerCreate(zmos_taskHandle_t pTaskHandle, uTaskEvent_t event);
+/*****************************************************************
+* FUNCTION: zmos_timerDelete
+*
+* DESCRIPTION:
+*     This function is called to stop and delete a timer handle.
+* INPUTS:
+*     hTimer : The timer handle.
+* RETURNS:
+*     0 : success (ZMOS_TIMER_SUCCESS).
+* NOTE:
+*     The handle is invalid after the delete.
+*****************************************************************/
+timerReslt_t zmos_timerDelete(zmos_timerHandle_t hTimer);
+/*****************************************************************
+* FUNCTION: zmos_timerStart
+*
+* DESCRIPTION:
+*     This function is called to start or restart a timer.
+* INPUTS:
+*     hTimer : The timer handle.
+*     timeout : Timer timeout.
+*     reloadTime : Timer reload time, 0 : single timer.
+* RETURNS:
+*     0 : success (ZMOS_TIMER_SUCCESS).
+* NOTE:
+*     The timer of a task unregistered can't be started, the list
+*     store doesn't remove the timers of the task.
+*****************************************************************/
+timerReslt_t zmos_timerStart(zmos_timerHandle_t hTimer, uint32_t timeout, uint32_t reloadTime);
+#if ZMOS_TIMER_PERIODIC
+/*****************************************************************
+* FUNCTION: zmos_timerStartPeriodic
+*
+* DESCRIPTION:
+*     This function is called to start a timer as periodic timer.
+* INPUTS:
+*     hTimer : The timer handle.
+*     period : Timer period.
+*     policy : The overrun policy(ZMOS_TIMER_OVERRUN_xxx).
+* RETURNS:
+*     0 : success (ZMOS_TIMER_SUCCESS).
+* NOTE:
+*     Same as zmos_startPeriodicTimer.
+*****************************************************************/
+timerReslt_t zmos_timerStartPeriodic(zmos_timerHandle_t hTimer, uint32_t period, uint8_t policy);
+/*****************************************************************
+* FUNCTION: zmos_timerGetMissedCount
+*
+* DESCRIPTION:
+*     Get the number of the periods missed of a periodic timer.
+* INPUTS:
+*     hTimer : The timer handle.
+* RETURNS:
+*     The periods missed since the last read.
+* NOTE:
+*     Same as zmos_getTimerMissedCount.
+*****************************************************************/
+uint32_t zmos_timerGetMissedCount(zmos_timerHandle_t hTimer);
+#endif
+/*****************************************************************
+* FUNCTION: zmos_timerStop
+*
+* DESCRIPTION:
+*     This function to stop a timer, the handle can be started
+*     again.
+* INPUTS:
+*     hTimer : The timer handle.
+* RETURNS:
+*     0 : success (ZMOS_TIMER_SUCCESS).
+*     other : The timer isn't running.
+* NOTE:
+*     null
+*****************************************************************/
+timerReslt_t zmos_timerStop(zmos_timerHandle_t hTimer);
+/*****************************************************************
+* FUNCTION: zmos_timerGetTimeout
+*
+* DESCRIPTION:
+*     Get the current timeout of a timer.
+* INPUTS:
+*     hTimer : The timer handle.
+* RETURNS:
+*     Return the timer's tick count if running, zero otherwise.
+* NOTE:
+*     null
+*****************************************************************/
+uint32_t zmos_timerGetTimeout(zmos_timerHandle_t hTimer);
+/*****************************************************************
+* FUNCTION: zmos_timerGetReloadTime
+*
+* DESCRIPTION:
+*     Get the reload time of a timer.
+* INPUTS:
+*     hTimer : The timer handle.
+* RETURNS:
+*     Timer reload time, 0 : single timer.
+* NOTE:
+*     null
+*****************************************************************/
+uint32_t zmos_timerGetReloadTime(zmos_timerHandle_t hTimer);
 /*****************************************************************
 * FUNCTION: zmos_getNextLowestTimeout
 *
@@ -365,8 +1428,104 @@ uint32_t zmos_getNextLowestTimeout(void);
 *     null
 *****************************************************************/
 uint32_t zmos_getTimerClock(void);
+#if ZMOS_USE_TIME_US
+/*****************************************************************
+* FUNCTION: zmos_timeNowUs
+*
+* DESCRIPTION:
+*     Get the monotonic time in microseconds.
+* INPUTS:
+*     null
+* RETURNS:
+*     The time in microseconds.
+* NOTE:
+*     The 32-bit count of bsp_getUsCount is extended to 64 bits,
+*     it must be read once in 35 minutes, the main loop reads it
+*     at each run. A count earlier than the last is taken as the
+*     last.
+*****************************************************************/
+uint64_t zmos_timeNowUs(void);
+#endif
+/*****************************************************************
+* FUNCTION: zmos_getTimerPoolUsed
+*
+* DESCRIPTION:
+*     Get the number of the timers used in the timer pool.
+* INPUTS:
+*     null
+* RETURNS:
+*     The timers used.
+* NOTE:
+*     If ZMOS_TIMER_POOL_SIZE is 0, It always returns 0.
+*****************************************************************/
+uint32_t zmos_getTimerPoolUsed(void);
+/*****************************************************************
+* FUNCTION: zmos_getTimerPoolMaxUsed
+*
+* DESCRIPTION:
+*     Get the max number of the timers used in the timer pool.
+* INPUTS:
+*     null
+* RETURNS:
+*     The high water of the pool.
+* NOTE:
+*     If ZMOS_TIMER_POOL_SIZE is 0, It always returns 0.
+*****************************************************************/
+uint32_t zmos_getTimerPoolMaxUsed(void);
+/*****************************************************************
+* FUNCTION: zmos_getTimerPoolMissCount
+*
+* DESCRIPTION:
+*     Get the number of the timers allocated from the heap when the
+*     timer pool is full.
+* INPUTS:
+*     null
+* RETURNS:
+*     The number of the heap timers.
+* NOTE:
+*     If ZMOS_TIMER_POOL_SIZE is 0, It always returns 0.
+*****************************************************************/
+uint32_t zmos_getTimerPoolMissCount(void);
 
 
+/*********************************** ZMOS hrtimer interface ***************************************************************/
+
+/*****************************************************************
+* FUNCTION: zmos_hrtimerStart
+*
+* DESCRIPTION:
+*     This function to start a high resolution timer.
+* INPUTS:
+*     pTimer : The timer, it must be kept until stopped or expired.
+*     timeoutUs : The timeout in microseconds.
+*     periodUs : The period in microseconds, 0 is single.
+*     func : The timer function.
+*     param : Param to be passed in to the timer function.
+* RETURNS:
+*     0 : success (ZMOS_TIMER_SUCCESS).
+* NOTE:
+*     The running timer is restarted. The function is called by
+*     the main loop(zmos_system_run), a long task delays it. The
+*     periodic timer keeps its deadlines, the periods missed are
+*     skipped and counted.
+*****************************************************************/
+timerReslt_t zmos_hrtimerStart(zmos_hrtimer_t *pTimer, uint32_t timeoutUs, uint32_t periodUs,
+                               zmosHrtimerFunc_t func, void *param);
+/*****************************************************************
+* FUNCTION: zmos_hrtimerStop
+*
+* DESCRIPTION:
+*     This function to stop a high resolution timer.
+* INPUTS:
+*     pTimer : The timer.
+* RETURNS:
+*     0 : success (ZMOS_TIMER_SUCCESS).
+*     other : The timer isn't running.
+* NOTE:
+*     null
+*****************************************************************/
+timerReslt_t zmos_hrtimerStop(zmos_hrtimer_t *pTimer);
+    
 /*********************************** ZMOS cbtimer interface ***************************************************************/
 
 /*****************************************************************
@@ -563,6 +1722,66 @@ void zmos_lowPwrSetEvent(uint8_t event);
 *****************************************************************/
 void zmos_lowPwrClearEvent(uint8_t event);
 
+/*********************************** ZMOS trace interface ***************************************************************/
+
+/*****************************************************************
+* FUNCTION: zmos_traceRecord
+*
+* DESCRIPTION:
+*     This function to write a record to the trace buffer.
+* INPUTS:
+*     type : ref ZMOS trace record types.
+*     id : Task handle, memory address or user id.
+*     value : Events, size or user value.
+*     param : Timeout or other param.
+* RETURNS:
+*     null
+* NOTE:
+*     Use ZMOS_TRACE_POINT or ZMOS_TRACE_USER instead.
+*****************************************************************/
+void zmos_traceRecord(uint8_t type, uint32_t id, uint32_t value, uint32_t param);
+/*****************************************************************
+* FUNCTION: zmos_traceEnable
+*
+* DESCRIPTION:
+*     This function to start or stop the trace recording.
+* INPUTS:
+*     enable : 1 is start, 0 is stop.
+* RETURNS:
+*     null
+* NOTE:
+*     The trace starts after zmos_system_init, stop it to keep
+*     the records of a fault.
+*****************************************************************/
+void zmos_traceEnable(uint8_t enable);
+/*****************************************************************
+* FUNCTION: zmos_traceReset
+*
+* DESCRIPTION:
+*     This function to discard all records of the trace buffer.
+* INPUTS:
+*     null
+* RETURNS:
+*     null
+* NOTE:
+*     null
+*****************************************************************/
+void zmos_traceReset(void);
+/*****************************************************************
+* FUNCTION: zmos_traceGetBuffer
+*
+* DESCRIPTION:
+*     This function to get the trace buffer to dump.
+* INPUTS:
+*     pSize : Return the size of the buffer in bytes.
+* RETURNS:
+*     The trace buffer, NULL if the trace is disabled.
+* NOTE:
+*     Stop the trace before dumping, the converter reads the
+*     buffer(zmos_traceBuffer_t) as a binary file.
+*****************************************************************/
+const void *zmos_traceGetBuffer(zm_size_t *pSize);
+
 
 
 
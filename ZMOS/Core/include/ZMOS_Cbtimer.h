@@ -47,6 +47,15 @@ typedef void (* cbTimerFunction)(void *param);
  * Callback timer id type.
  */
 typedef uint8_t cbTimerId_t;
+/**
+ * Callback timer struct.
+ */
+typedef struct
+{
+    cbTimerFunction timerFunc;
+    void *param;
+    zmos_timerHandle_t timer;
+}zmos_cbTimer_t;
 /*************************************************************************************************************************
  *                                                   PUBLIC FUNCTIONS                                                    *
  *************************************************************************************************************************/
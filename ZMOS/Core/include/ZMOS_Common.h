@@ -148,7 +148,41 @@ extern "C"
  * ZMOS Get the minimin form a and b.
  */
 #define ZMOS_GET_MIN(a, b)            ((a) < (b) ? (a) : (b))
-   
+
+/**
+ * ZMOS Count leading zeros of a 32-bit value.
+ * ZMOS Count trailing zeros of a 32-bit value.
+ *
+ * @note The value must not be 0.
+ */
+#if defined(__GNUC__)
+#if (__SIZEOF_INT__ >= 4)
+#define ZMOS_CLZ(val)                 ((unsigned char)__builtin_clz((unsigned int)(val)))
+#define ZMOS_CTZ(val)                 ((unsigned char)__builtin_ctz((unsigned int)(val)))
+#else
+#define ZMOS_CLZ(val)                 ((unsigned char)__builtin_clzl((unsigned long)(val)))
+#define ZMOS_CTZ(val)                 ((unsigned char)__builtin_ctzl((unsigned long)(val)))
+#endif
+#elif defined(__CC_ARM)
+#define ZMOS_CLZ(val)                 ((unsigned char)__clz((unsigned int)(val)))
+#define ZMOS_CTZ(val)                 ((unsigned char)__clz(__rbit((unsigned int)(val))))
+#elif defined(__ICCARM__)
+#include <intrinsics.h>
+#define ZMOS_CLZ(val)                 ((unsigned char)__CLZ((unsigned long)(val)))
+#define ZMOS_CTZ(val)                 ((unsigned char)__CLZ(__RBIT((unsigned long)(val))))
+#else
+extern unsigned char zmos_clz32(unsigned long val);
+extern unsigned char zmos_ctz32(unsigned long val);
+#define ZMOS_CLZ(val)                 zmos_clz32((unsigned long)(val))
+#define ZMOS_CTZ(val)                 zmos_ctz32((unsigned long)(val))
+#endif
+/**
+ * ZMOS Get the index of the highest set bit of a 32-bit value.
+ *
+ * @note The value must not be 0.
+ */
+#define ZMOS_HIGHEST_BIT(val)         (31 - ZMOS_CLZ(val))
+
         
 /**
  * ZMOS_ALIGN(size, align)
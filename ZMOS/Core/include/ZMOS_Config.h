@@ -45,6 +45,30 @@ extern "C"
 #define ZMOS_INIT_SECTION           1
 #endif
      
+/**
+ * @brief ZMOS use task section(@ref ZMOS_TASK_DEFINE).
+ *        1 : enable
+ *        0 : disable
+ *
+ * @note The task section holds writable task control blocks, the linker
+ *       must place it in the initialized RAM data region.
+ */
+#ifndef ZMOS_TASK_SECTION
+#define ZMOS_TASK_SECTION           0
+#endif
+     
+/**
+ * @brief ZMOS kernel instance.
+ *        1 : enable, many kernels(zmos_kernel_t) can run in one process, each 
+ *            thread selects the kernel to use by zmos_kernelSelect.
+ *        0 : disable, only the default kernel.
+ *
+ * @note Used by the host simulation, the compiler must support thread local storage.
+ */
+#ifndef ZMOS_KERNEL_INSTANCE
+#define ZMOS_KERNEL_INSTANCE        0
+#endif
+     
 /**
  * @brief ZMOS use memory management.
  *        1 : enable
@@ -121,6 +145,362 @@ extern "C"
 #define ZMOS_TASK_EVENT_NUM_MAX     32
 #endif
     
+/**
+ * @brief ZMOS task priority levels is the number.
+ *        the value is 1 ~ 32.
+ *
+ * @note The larger the priority value, the higher the priority.
+ *       Tasks of the same priority are scheduled in ready order.
+ */
+#ifndef ZMOS_TASK_PRIORITY_NUM
+#define ZMOS_TASK_PRIORITY_NUM      8
+#endif
+    
+/**
+ * @brief ZMOS tasks of the same priority use round-robin scheduling.
+ *        1 : enable, a task moves to the tail of its priority after each dispatch.
+ *        0 : disable, a task keeps running while it still has events.
+ */
+#ifndef ZMOS_TASK_ROUND_ROBIN
+#define ZMOS_TASK_ROUND_ROBIN       0
+#endif
+    
+/**
+ * @brief ZMOS task aging time(ms).
+ *        0 : disable.
+ *
+ * @note A ready task that has waited longer than this time is dispatched
+ *       before the tasks of higher priority.
+ */
+#ifndef ZMOS_TASK_AGING_TIME
+#define ZMOS_TASK_AGING_TIME        0
+#endif
+    
+/**
+ * @brief ZMOS task event table dispatch order.
+ *        1 : The highest event bit is handled first.
+ *        0 : The lowest event bit is handled first.
+ */
+#ifndef ZMOS_TASK_EVENT_TABLE_MSB_FIRST
+#define ZMOS_TASK_EVENT_TABLE_MSB_FIRST     0
+#endif
+    
+/**
+ * @brief ZMOS task with user context(@ref zmos_taskThreadRegisterContext).
+ *        1 : enable
+ *        0 : disable
+ */
+#ifndef ZMOS_TASK_CONTEXT
+#define ZMOS_TASK_CONTEXT           0
+#endif
+    
+/**
+ * @brief ZMOS task counting events.
+ *        1 : enable
+ *        0 : disable
+ *
+ * @note Each task can enable the counting of some events by 
+ *       zmos_setTaskEventCounter.
+ */
+#ifndef ZMOS_TASK_EVENT_COUNT
+#define ZMOS_TASK_EVENT_COUNT       0
+#endif
+    
+/**
+ * @brief ZMOS task CPU time and dispatch statistics.
+ *        1 : enable
+ *        0 : disable
+ *
+ * @note The execution time is measured by bsp_getCycleCount.
+ */
+#ifndef ZMOS_TASK_STATS
+#define ZMOS_TASK_STATS             0
+#endif
+
+/**
+ * @brief ZMOS task event-to-dispatch latency histograms.
+ *        1 : enable
+ *        0 : disable
+ *
+ * @note Each task can attach the latency record by zmos_setTaskLatencyRecord,
+ *       the latency is measured by bsp_getCycleCount.
+ */
+#ifndef ZMOS_TASK_LATENCY
+#define ZMOS_TASK_LATENCY           0
+#endif
+
+/**
+ * @brief ZMOS task execution budget, the dispatch longer than the budget
+ *        is recorded and reported by the hook.
+ *        1 : enable
+ *        0 : disable
+ *
+ * @note The execution time is measured by bsp_getCycleCount.
+ */
+#ifndef ZMOS_TASK_BUDGET
+#define ZMOS_TASK_BUDGET            0
+#endif
+
+/**
+ * @brief Default execution budget of the tasks in bsp_getCycleCount unit.
+ *        0 : no budget.
+ */
+#ifndef ZMOS_TASK_BUDGET_DEFAULT
+#define ZMOS_TASK_BUDGET_DEFAULT    0
+#endif
+
+/**
+ * @brief Number of consecutive overruns of a task to call the escalate hook.
+ *        0 : disable.
+ */
+#ifndef ZMOS_TASK_BUDGET_ESCALATE
+#define ZMOS_TASK_BUDGET_ESCALATE   3
+#endif
+
+/**
+ * @brief ZMOS periodic tasks, a job is released to the task each period
+ *        and should be done before its deadline.
+ *        1 : enable
+ *        0 : disable
+ */
+#ifndef ZMOS_TASK_PERIODIC
+#define ZMOS_TASK_PERIODIC          0
+#endif
+
+/**
+ * @brief ZMOS earliest deadline first dispatch of the periodic jobs, the
+ *        jobs are ahead of the other ready tasks of the same priority by
+ *        the nearest deadline.
+ *        1 : enable
+ *        0 : disable
+ *
+ * @note Only used when ZMOS_TASK_PERIODIC is enabled.
+ */
+#ifndef ZMOS_TASK_EDF
+#define ZMOS_TASK_EDF               1
+#endif
+
+/**
+ * @brief ZMOS use task message queue.
+ *        1 : enable
+ *        0 : disable
+ *
+ * @note The highest task event bit is reserved for messages(ZMOS_TASK_MSG_EVENT).
+ */
+#ifndef ZMOS_USE_MSG
+#define ZMOS_USE_MSG                0
+#endif
+
+/**
+ * @brief ZMOS interrupt event posting and deferred call.
+ *        1 : enable
+ *        0 : disable
+ *
+ * @note The ISR posts events by zmos_setTaskEventFromISR without 
+ *       disabling the interrupts.
+ */
+#ifndef ZMOS_USE_ISR
+#define ZMOS_USE_ISR                0
+#endif
+
+/**
+ * @brief ZMOS interrupt posting use atomic instructions.
+ *        1 : atomic read-modify-write
+ *        0 : critical section
+ *
+ * @note Set 0 for the MCU without atomic instructions(such as MSP430, Cortex-M0).
+ *       The critical section is used when GCC has no lock-free atomics
+ *       of the event or the pointer width.
+ */
+#ifndef ZMOS_ISR_USE_ATOMIC
+#define ZMOS_ISR_USE_ATOMIC         1
+#endif
+
+/**
+ * @brief Size of the interrupt deferred call ring.
+ *        0 : disable.
+ *
+ * @note Must be power of 2.
+ */
+#ifndef ZMOS_ISR_DEFER_RING_SIZE
+#define ZMOS_ISR_DEFER_RING_SIZE    8
+#endif
+
+/**
+ * @brief ZMOS topic publish/subscribe.
+ *        1 : enable
+ *        0 : disable
+ *
+ */
+#ifndef ZMOS_USE_TOPIC
+#define ZMOS_USE_TOPIC              0
+#endif
+
+/**
+ * @brief Number of the topics(1 ~ 255), the topic id is 0 ~ (ZMOS_TOPIC_NUM - 1).
+ */
+#ifndef ZMOS_TOPIC_NUM
+#define ZMOS_TOPIC_NUM              16
+#endif
+
+/**
+ * @brief Maximum number of the subscribers(task and event pairs).
+ *
+ * @note No more than 32.
+ */
+#ifndef ZMOS_TOPIC_SUBSCRIBER_MAX
+#define ZMOS_TOPIC_SUBSCRIBER_MAX   16
+#endif
+
+/**
+ * @brief ZMOS preemptive threads, the tasks run in the lowest priority context.
+ *        1 : enable
+ *        0 : disable
+ *
+ * @note The bsp implements the context switch(bsp_thread.h).
+ */
+#ifndef ZMOS_USE_THREAD
+#define ZMOS_USE_THREAD             0
+#endif
+
+/**
+ * @brief Number of the thread priorities, one thread of each priority.
+ *
+ * @note No more than 32.
+ */
+#ifndef ZMOS_THREAD_PRIORITY_NUM
+#define ZMOS_THREAD_PRIORITY_NUM    4
+#endif
+
+/**
+ * @brief ZMOS time-triggered cyclic executive, the task slots of the
+ *        schedule table run at the minor frame boundaries.
+ *        1 : enable
+ *        0 : disable
+ */
+#ifndef ZMOS_USE_CYCLIC
+#define ZMOS_USE_CYCLIC             0
+#endif
+
+/**
+ * @brief ZMOS background jobs, the steps run when no task is ready.
+ *        1 : enable
+ *        0 : disable
+ */
+#ifndef ZMOS_USE_JOB
+#define ZMOS_USE_JOB                0
+#endif
+
+/**
+ * @brief Default time budget of a slice of the jobs in bsp_getCycleCount unit.
+ *        0 : one step each slice.
+ */
+#ifndef ZMOS_JOB_SLICE
+#define ZMOS_JOB_SLICE              0
+#endif
+
+/**
+ * @brief ZMOS idle hooks, run by priority when the next timer leaves
+ *        enough time.
+ *        1 : enable
+ *        0 : disable
+ */
+#ifndef ZMOS_USE_IDLE_HOOK
+#define ZMOS_USE_IDLE_HOOK          0
+#endif
+
+/**
+ * @brief ZMOS binary trace recorder.
+ *        1 : enable
+ *        0 : disable
+ *
+ * @note The trace points of the scheduler, timers, memory and low power
+ *       write fixed-size records into a RAM ring buffer.
+ */
+#ifndef ZMOS_TRACE
+#define ZMOS_TRACE                  0
+#endif
+
+/**
+ * @brief Number of records of the trace ring buffer.
+ *
+ * @note Must be power of 2, the oldest records are overwritten.
+ */
+#ifndef ZMOS_TRACE_BUFFER_SIZE
+#define ZMOS_TRACE_BUFFER_SIZE      256
+#endif
+
+/**
+ * @brief Frequency of the trace time(bsp_getCycleCount) in Hz.
+ *        0 : unknown, set by the converter.
+ */
+#ifndef ZMOS_TRACE_CYCLE_FREQ
+#define ZMOS_TRACE_CYCLE_FREQ       0
+#endif
+    
+/**
+ * @brief ZMOS timer stores.
+ */
+#define ZMOS_TIMER_STORE_LIST       0
+#define ZMOS_TIMER_STORE_WHEEL      1
+/**
+ * @brief ZMOS timer store.
+ *        ZMOS_TIMER_STORE_LIST : unsorted list, each update walks
+ *            all timers.
+ *        ZMOS_TIMER_STORE_WHEEL : hierarchical timing wheel, the
+ *            start and the stop are constant time, the update
+ *            skips the empty ticks. It takes the RAM of 7 * 32
+ *            slots.
+ *
+ * @note Tools/zmos_timer_bench.c compares them. Use the timing
+ *       wheel for many timers if the RAM allows.
+ */
+#ifndef ZMOS_TIMER_STORE
+#define ZMOS_TIMER_STORE            ZMOS_TIMER_STORE_LIST
+#endif
+
+/**
+ * @brief Number of the ZMOS timers in the timer pool.
+ *        0 : disable, the timers are from the heap.
+ *
+ * @note The timers are from the heap when the pool is full.
+ */
+#ifndef ZMOS_TIMER_POOL_SIZE
+#define ZMOS_TIMER_POOL_SIZE        0
+#endif
+
+/**
+ * @brief ZMOS periodic timers of the absolute deadlines.
+ *        1 : enable
+ *        0 : disable
+ */
+#ifndef ZMOS_TIMER_PERIODIC
+#define ZMOS_TIMER_PERIODIC         0
+#endif
+
+/**
+ * @brief ZMOS 64-bit microsecond time(zmos_timeNowUs).
+ *        1 : enable
+ *        0 : disable
+ *
+ * @note The bsp provides the microsecond count(bsp_getUsCount).
+ */
+#ifndef ZMOS_USE_TIME_US
+#define ZMOS_USE_TIME_US            0
+#endif
+
+/**
+ * @brief ZMOS high resolution timers of microseconds, polled by the
+ *        main loop.
+ *        1 : enable
+ *        0 : disable
+ *
+ * @note It needs ZMOS_USE_TIME_US.
+ */
+#ifndef ZMOS_USE_HRTIMER
+#define ZMOS_USE_HRTIMER            0
+#endif
+
 /**
  * @brief Number of ZMOS callback timers used.
  *        0 : disable.
@@ -0,0 +1,146 @@
+/*****************************************************************
+* Copyright (C) 2026 zm. All rights reserved.                    *
+******************************************************************
+* ZMOS_Coroutine.h
+*
+* DESCRIPTION:
+*     ZMOS stackless coroutine task.
+* AUTHOR:
+*     zm
+* CREATED DATE:
+*     2026/10/17
+* REVISION:
+*     v0.1
+*
+* MODIFICATION HISTORY
+* --------------------
+* $Log:$
+*
+*****************************************************************/
+#ifndef __ZMOS_COROUTINE_H__
+#define __ZMOS_COROUTINE_H__
+ 
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+/*************************************************************************************************************************
+ *                                                       INCLUDES                                                        *
+ *************************************************************************************************************************/
+#include "ZMOS_Tasks.h"
+#include "ZMOS_Timers.h"
+/*************************************************************************************************************************
+ *                                                        MACROS                                                         *
+ *************************************************************************************************************************/
+/**
+ * Usage:
+ * @code
+   static zmos_co_t sensorCo;
+   uTaskEvent_t sensorTask(uTaskEvent_t event)
+   {
+       ZMOS_CO_BEGIN(&sensorCo, event);
+       sensor_powerOn();
+       ZMOS_CO_DELAY(&sensorCo, SENSOR_TIMER_EVENT, 10);
+       sensor_startConvert();
+       ZMOS_CO_WAIT_EVENT_TIMEOUT(&sensorCo, SENSOR_READY_EVENT, SENSOR_TIMER_EVENT, 100);
+       if(ZMOS_CO_WAKE_EVENT(&sensorCo) & SENSOR_READY_EVENT) sensor_read();
+       ZMOS_CO_END(&sensorCo);
+   }
+ * @endcode
+ *
+ * @note
+ * The coroutine resumes with a switch on the line number, so local variables
+ * are not kept across a wait(use static variables) and the coroutine body
+ * can't use switch statement itself.
+ * Events received while the coroutine waits other events are discarded.
+ */
+
+/**
+ * Initialize the coroutine, it will start from ZMOS_CO_BEGIN on next event.
+ */
+#define ZMOS_CO_INIT(co)                  do{ (co)->line = 0; (co)->wake = 0; }while(0)
+
+/**
+ * Start the coroutine body, event is the param of the task function.
+ */
+#define ZMOS_CO_BEGIN(co, event)          { uTaskEvent_t zmosCoEvent = (event); \
+                                            (void)zmosCoEvent; \
+                                            switch((co)->line) { case 0:
+
+/**
+ * End the coroutine body, the coroutine restarts on next event.
+ */
+#define ZMOS_CO_END(co)                   } (co)->line = 0; return 0; }
+
+/**
+ * Exit the coroutine, the coroutine restarts on next event.
+ */
+#define ZMOS_CO_EXIT(co)                  do{ (co)->line = 0; return 0; }while(0)
+
+/**
+ * Wait for any of the waitEvent to be set to the task.
+ */
+#define ZMOS_CO_WAIT_EVENT(co, waitEvent) do{ (co)->line = __LINE__; return 0; case __LINE__: \
+                                              if(!(zmosCoEvent & (waitEvent))) return 0; \
+                                              (co)->wake = zmosCoEvent & (waitEvent); }while(0)
+
+/**
+ * Delay ms milliseconds, timerEvent is the task event used by the timer.
+ */
+#define ZMOS_CO_DELAY(co, timerEvent, ms)                                             \
+    do{                                                                               \
+        zmos_startSingleTimer(zmos_getCurrentTaskHandle(), (timerEvent), (ms));       \
+        ZMOS_CO_WAIT_EVENT(co, timerEvent);                                           \
+    }while(0)
+
+/**
+ * Wait for the waitEvent no more than ms milliseconds, check ZMOS_CO_WAKE_EVENT
+ * for the timerEvent to know whether timeout.
+ */
+#define ZMOS_CO_WAIT_EVENT_TIMEOUT(co, waitEvent, timerEvent, ms)                     \
+    do{                                                                               \
+        zmos_startSingleTimer(zmos_getCurrentTaskHandle(), (timerEvent), (ms));       \
+        ZMOS_CO_WAIT_EVENT(co, (waitEvent) | (timerEvent));                           \
+        if((co)->wake & (waitEvent))                                                  \
+        {                                                                             \
+            (co)->wake &= ~(timerEvent);                                              \
+            zmos_stopTimer(zmos_getCurrentTaskHandle(), (timerEvent));                \
+        }                                                                             \
+    }while(0)
+
+/**
+ * Give up the CPU to other tasks, yieldEvent is the task event used to resume.
+ */
+#define ZMOS_CO_YIELD(co, yieldEvent)                                                 \
+    do{                                                                               \
+        zmos_setTaskEvent(zmos_getCurrentTaskHandle(), (yieldEvent));                 \
+        ZMOS_CO_WAIT_EVENT(co, yieldEvent);                                           \
+    }while(0)
+
+/**
+ * The events that woke the coroutine from the last wait.
+ */
+#define ZMOS_CO_WAKE_EVENT(co)            ((co)->wake)
+/*************************************************************************************************************************
+ *                                                      CONSTANTS                                                        *
+ *************************************************************************************************************************/
+ 
+/*************************************************************************************************************************
+ *                                                       TYPEDEFS                                                        *
+ *************************************************************************************************************************/
+/**
+ * ZMOS coroutine continuation.
+ */
+typedef struct
+{
+    uint16_t line;
+    uTaskEvent_t wake;
+}zmos_co_t;
+/*************************************************************************************************************************
+ *                                                   PUBLIC FUNCTIONS                                                    *
+ *************************************************************************************************************************/
+ 
+#ifdef __cplusplus
+}
+#endif
+#endif /* ZMOS_Coroutine.h */
@@ -0,0 +1,152 @@
+/*****************************************************************
+* Copyright (C) 2026 zm. All rights reserved.                    *
+******************************************************************
+* ZMOS_Cyclic.h
+*
+* DESCRIPTION:
+*     ZMOS time-triggered cyclic executive.
+* AUTHOR:
+*     zm
+* CREATED DATE:
+*     2026/10/17
+* REVISION:
+*     v0.1
+*
+* MODIFICATION HISTORY
+* --------------------
+* $Log:$
+*
+*****************************************************************/
+#ifndef __ZMOS_CYCLIC_H__
+#define __ZMOS_CYCLIC_H__
+ 
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+/*************************************************************************************************************************
+ *                                                       INCLUDES                                                        *
+ *************************************************************************************************************************/
+#include "ZMOS_Tasks.h"
+/*************************************************************************************************************************
+ *                                                        MACROS                                                         *
+ *************************************************************************************************************************/
+ 
+/*************************************************************************************************************************
+ *                                                      CONSTANTS                                                        *
+ *************************************************************************************************************************/
+ 
+/*************************************************************************************************************************
+ *                                                       TYPEDEFS                                                        *
+ *************************************************************************************************************************/
+/**
+ * ZMOS cyclic task slot, the event is dispatched to the task at the
+ * start of the minor frame.
+ */
+typedef struct
+{
+    /* Handle variable of the task, so the table can be const */
+    zmos_taskHandle_t *pTaskHandle;
+    uTaskEvent_t event;
+}zmos_cyclicSlot_t;
+/**
+ * ZMOS cyclic minor frame, the slots run in order.
+ */
+typedef struct
+{
+    const zmos_cyclicSlot_t *slots;
+    uint8_t slotNum;
+}zmos_cyclicFrame_t;
+/**
+ * ZMOS cyclic schedule table, the major frame is
+ * (minorFrame * frameNum).
+ */
+typedef struct
+{
+    /* Minor frame length in timer clock(ms) */
+    uint32_t minorFrame;
+    const zmos_cyclicFrame_t *frames;
+    uint16_t frameNum;
+}zmos_cyclicTable_t;
+/**
+ * ZMOS cyclic executive statistics.
+ */
+typedef struct
+{
+    /* Minor frames run */
+    uint32_t frameCount;
+    /* Major frames completed */
+    uint32_t majorCount;
+    /* Frames whose slots didn't finish before the next boundary */
+    uint32_t overrunCount;
+    /* Frames skipped to keep the alignment after an overrun */
+    uint32_t skipCount;
+    /* Max start delay of a frame from its boundary(ms) */
+    uint32_t maxJitter;
+    /* Max run time of the slots of a frame(bsp_getCycleCount) */
+    uint32_t maxFrameTime;
+}zmos_cyclicStats_t;
+/*************************************************************************************************************************
+ *                                                   PUBLIC FUNCTIONS                                                    *
+ *************************************************************************************************************************/
+/*****************************************************************
+* FUNCTION: zmos_cyclicStart
+*
+* DESCRIPTION:
+*     This function to start the cyclic executive with the schedule table.
+* INPUTS:
+*     pTable : The schedule table, it must be kept until stopped.
+* RETURNS:
+*     0 : Success (ZMOS_TASK_SUCCESS).
+*     other : ref ZMOS task return cordes.
+* NOTE:
+*     The first minor frame starts at once, the frames are aligned
+*     to the timer clock(zmos_getTimerClock). Starting again
+*     replaces the table and resets the statistics.
+*****************************************************************/
+taskReslt_t zmos_cyclicStart(const zmos_cyclicTable_t *pTable);
+/*****************************************************************
+* FUNCTION: zmos_cyclicStop
+*
+* DESCRIPTION:
+*     This function to stop the cyclic executive.
+* INPUTS:
+*     null
+* RETURNS:
+*     null
+* NOTE:
+*     null
+*****************************************************************/
+void zmos_cyclicStop(void);
+/*****************************************************************
+* FUNCTION: zmos_cyclicGetStats
+*
+* DESCRIPTION:
+*     This function to get the statistics of the cyclic executive.
+* INPUTS:
+*     pStats : Return the statistics.
+* RETURNS:
+*     0 : Success (ZMOS_TASK_SUCCESS).
+*     other : ref ZMOS task return cordes.
+* NOTE:
+*     null
+*****************************************************************/
+taskReslt_t zmos_cyclicGetStats(zmos_cyclicStats_t *pStats);
+/*****************************************************************
+* FUNCTION: zmos_cyclicResetStats
+*
+* DESCRIPTION:
+*     This function to reset the statistics of the cyclic executive.
+* INPUTS:
+*     null
+* RETURNS:
+*     null
+* NOTE:
+*     null
+*****************************************************************/
+void zmos_cyclicResetStats(void);
+
+#ifdef __cplusplus
+}
+#endif
+#endif /* ZMOS_Cyclic.h */
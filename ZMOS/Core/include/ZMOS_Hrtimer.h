@@ -0,0 +1,105 @@
+/*****************************************************************
+* Copyright (C) 2026 zm. All rights reserved.                    *
+******************************************************************
+* ZMOS_Hrtimer.h
+*
+* DESCRIPTION:
+*     ZMOS high resolution timers.
+* AUTHOR:
+*     zm
+* CREATED DATE:
+*     2026/10/17
+* REVISION:
+*     v0.1
+*
+* MODIFICATION HISTORY
+* --------------------
+* $Log:$
+*
+*****************************************************************/
+#ifndef __ZMOS_HRTIMER_H__
+#define __ZMOS_HRTIMER_H__
+ 
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+/*************************************************************************************************************************
+ *                                                       INCLUDES                                                        *
+ *************************************************************************************************************************/
+#include "ZMOS_Timers.h"
+/*************************************************************************************************************************
+ *                                                        MACROS                                                         *
+ *************************************************************************************************************************/
+ 
+/*************************************************************************************************************************
+ *                                                      CONSTANTS                                                        *
+ *************************************************************************************************************************/
+ 
+/*************************************************************************************************************************
+ *                                                       TYPEDEFS                                                        *
+ *************************************************************************************************************************/
+/**
+ * ZMOS high resolution timer function.
+ */
+typedef void (*zmosHrtimerFunc_t)(void *param);
+/**
+ * ZMOS high resolution timer, the counters are read only.
+ */
+typedef struct zmos_hrtimer
+{
+    zmosHrtimerFunc_t func;
+    void *param;
+    /* Deadline in zmos_timeNowUs */
+    uint64_t deadline;
+    /* Period in microseconds, 0 is single */
+    uint32_t period;
+    /* Number of the periods missed */
+    uint32_t overrunCount;
+    /* Max lateness of the runs in microseconds */
+    uint32_t maxLateness;
+    struct zmos_hrtimer *next;
+}zmos_hrtimer_t;
+/*************************************************************************************************************************
+ *                                                   PUBLIC FUNCTIONS                                                    *
+ *************************************************************************************************************************/
+/*****************************************************************
+* FUNCTION: zmos_hrtimerStart
+*
+* DESCRIPTION:
+*     This function to start a high resolution timer.
+* INPUTS:
+*     pTimer : The timer, it must be kept until stopped or expired.
+*     timeoutUs : The timeout in microseconds.
+*     periodUs : The period in microseconds, 0 is single.
+*     func : The timer function.
+*     param : Param to be passed in to the timer function.
+* RETURNS:
+*     0 : success (ZMOS_TIMER_SUCCESS).
+* NOTE:
+*     The running timer is restarted. The function is called by
+*     the main loop(zmos_system_run), a long task delays it. The
+*     periodic timer keeps its deadlines, the periods missed are
+*     skipped and counted.
+*****************************************************************/
+timerReslt_t zmos_hrtimerStart(zmos_hrtimer_t *pTimer, uint32_t timeoutUs, uint32_t periodUs,
+                               zmosHrtimerFunc_t func, void *param);
+/*****************************************************************
+* FUNCTION: zmos_hrtimerStop
+*
+* DESCRIPTION:
+*     This function to stop a high resolution timer.
+* INPUTS:
+*     pTimer : The timer.
+* RETURNS:
+*     0 : success (ZMOS_TIMER_SUCCESS).
+*     other : The timer isn't running.
+* NOTE:
+*     null
+*****************************************************************/
+timerReslt_t zmos_hrtimerStop(zmos_hrtimer_t *pTimer);
+
+#ifdef __cplusplus
+}
+#endif
+#endif /* ZMOS_Hrtimer.h */
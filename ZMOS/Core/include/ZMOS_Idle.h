@@ -0,0 +1,103 @@
+/*****************************************************************
+* Copyright (C) 2026 zm. All rights reserved.                    *
+******************************************************************
+* ZMOS_Idle.h
+*
+* DESCRIPTION:
+*     ZMOS idle hooks.
+* AUTHOR:
+*     zm
+* CREATED DATE:
+*     2026/10/17
+* REVISION:
+*     v0.1
+*
+* MODIFICATION HISTORY
+* --------------------
+* $Log:$
+*
+*****************************************************************/
+#ifndef __ZMOS_IDLE_H__
+#define __ZMOS_IDLE_H__
+ 
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+/*************************************************************************************************************************
+ *                                                       INCLUDES                                                        *
+ *************************************************************************************************************************/
+#include "ZMOS_Tasks.h"
+/*************************************************************************************************************************
+ *                                                        MACROS                                                         *
+ *************************************************************************************************************************/
+ 
+/*************************************************************************************************************************
+ *                                                      CONSTANTS                                                        *
+ *************************************************************************************************************************/
+ 
+/*************************************************************************************************************************
+ *                                                       TYPEDEFS                                                        *
+ *************************************************************************************************************************/
+/**
+ * ZMOS idle hook function.
+ */
+typedef void (*zmosIdleHookFunc_t)(void);
+/**
+ * ZMOS idle hook, the counters are read only.
+ */
+typedef struct zmos_idleHook
+{
+    zmosIdleHookFunc_t func;
+    /* Max run time in timer clock(ms) */
+    uint32_t maxTime;
+    /* Number of runs */
+    uint32_t runCount;
+    /* Number of idle passes skipped for the lack of time */
+    uint32_t skipCount;
+    /* Number of runs longer than maxTime */
+    uint32_t overrunCount;
+    uint8_t priority;
+    struct zmos_idleHook *next;
+}zmos_idleHook_t;
+/*************************************************************************************************************************
+ *                                                   PUBLIC FUNCTIONS                                                    *
+ *************************************************************************************************************************/
+/*****************************************************************
+* FUNCTION: zmos_idleHookRegister
+*
+* DESCRIPTION:
+*     This function to register an idle hook.
+* INPUTS:
+*     pHook : The idle hook, it must be kept until unregistered.
+*     func : The hook function.
+*     priority : The higher priority hook runs first.
+*     maxTime : The max run time in timer clock(ms).
+* RETURNS:
+*     0 : Success (ZMOS_TASK_SUCCESS).
+*     other : ref ZMOS task return cordes.
+* NOTE:
+*     The hook runs in the idle path only when the time to the
+*     next timer is more than maxTime. Return ZMOS_TASK_FAILD
+*     when the hook is registered already.
+*****************************************************************/
+taskReslt_t zmos_idleHookRegister(zmos_idleHook_t *pHook, zmosIdleHookFunc_t func, uint8_t priority, uint32_t maxTime);
+/*****************************************************************
+* FUNCTION: zmos_idleHookUnregister
+*
+* DESCRIPTION:
+*     This function to unregister an idle hook.
+* INPUTS:
+*     pHook : The idle hook.
+* RETURNS:
+*     0 : Success (ZMOS_TASK_SUCCESS).
+*     other : ref ZMOS task return cordes.
+* NOTE:
+*     null
+*****************************************************************/
+taskReslt_t zmos_idleHookUnregister(zmos_idleHook_t *pHook);
+
+#ifdef __cplusplus
+}
+#endif
+#endif /* ZMOS_Idle.h */
@@ -0,0 +1,98 @@
+/*****************************************************************
+* Copyright (C) 2026 zm. All rights reserved.                    *
+******************************************************************
+* ZMOS_Isr.h
+*
+* DESCRIPTION:
+*     ZMOS interrupt event posting and deferred call.
+* AUTHOR:
+*     zm
+* CREATED DATE:
+*     2026/10/17
+* REVISION:
+*     v0.1
+*
+* MODIFICATION HISTORY
+* --------------------
+* $Log:$
+*
+*****************************************************************/
+#ifndef __ZMOS_ISR_H__
+#define __ZMOS_ISR_H__
+ 
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+/*************************************************************************************************************************
+ *                                                       INCLUDES                                                        *
+ *************************************************************************************************************************/
+#include "ZMOS_Tasks.h"
+/*************************************************************************************************************************
+ *                                                        MACROS                                                         *
+ *************************************************************************************************************************/
+ 
+/*************************************************************************************************************************
+ *                                                      CONSTANTS                                                        *
+ *************************************************************************************************************************/
+ 
+/*************************************************************************************************************************
+ *                                                       TYPEDEFS                                                        *
+ *************************************************************************************************************************/
+/**
+ * Deferred call function prototype.
+ *
+ * @param arg : The param passed to zmos_deferCallFromISR.
+ */
+typedef void (*zmosDeferFunc_t)(void *arg);
+/**
+ * Deferred call.
+ */
+typedef struct
+{
+    zmosDeferFunc_t func;
+    void *arg;
+}zmos_deferCall_t;
+/*************************************************************************************************************************
+ *                                                   PUBLIC FUNCTIONS                                                    *
+ *************************************************************************************************************************/
+/*****************************************************************
+* FUNCTION: zmos_setTaskEventFromISR
+*
+* DESCRIPTION:
+*     This function to set task event in the interrupt.
+* INPUTS:
+*     pTaskHandle : The handle of the task to set event.
+*     events : what event to set.
+* RETURNS:
+*     0 : Success (ZMOS_TASK_SUCCESS).
+*     other : ref ZMOS task return cordes.
+* NOTE:
+*     The interrupts are not disabled, the events are passed to
+*     the task by the next schedule. The task posted by the 
+*     interrupt shouldn't be unregistered.
+*****************************************************************/
+taskReslt_t zmos_setTaskEventFromISR(zmos_taskHandle_t pTaskHandle, uTaskEvent_t events);
+/*****************************************************************
+* FUNCTION: zmos_deferCallFromISR
+*
+* DESCRIPTION:
+*     This function to defer a function call from the interrupt to
+*     the task context.
+* INPUTS:
+*     func : The function to call.
+*     arg : The param of the function.
+* RETURNS:
+*     0 : Success (ZMOS_TASK_SUCCESS).
+*     other : ref ZMOS task return cordes.
+* NOTE:
+*     Single producer, only one interrupt(or the interrupts of the
+*     same priority) can call it. Return ZMOS_TASK_FAILD when
+*     the ring is full.
+*****************************************************************/
+taskReslt_t zmos_deferCallFromISR(zmosDeferFunc_t func, void *arg);
+
+#ifdef __cplusplus
+}
+#endif
+#endif /* ZMOS_Isr.h */
@@ -0,0 +1,157 @@
+/*****************************************************************
+* Copyright (C) 2026 zm. All rights reserved.                    *
+******************************************************************
+* ZMOS_Job.h
+*
+* DESCRIPTION:
+*     ZMOS budgeted background jobs.
+* AUTHOR:
+*     zm
+* CREATED DATE:
+*     2026/10/17
+* REVISION:
+*     v0.1
+*
+* MODIFICATION HISTORY
+* --------------------
+* $Log:$
+*
+*****************************************************************/
+#ifndef __ZMOS_JOB_H__
+#define __ZMOS_JOB_H__
+ 
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+/*************************************************************************************************************************
+ *                                                       INCLUDES                                                        *
+ *************************************************************************************************************************/
+#include "ZMOS_Tasks.h"
+/*************************************************************************************************************************
+ *                                                        MACROS                                                         *
+ *************************************************************************************************************************/
+ 
+/*************************************************************************************************************************
+ *                                                      CONSTANTS                                                        *
+ *************************************************************************************************************************/
+/**
+ * ZMOS job status.
+ */
+#define ZMOS_JOB_IDLE               0
+#define ZMOS_JOB_QUEUED             1
+#define ZMOS_JOB_DONE               2
+#define ZMOS_JOB_CANCELLED          3
+/**
+ * Progress of the job done.
+ */
+#define ZMOS_JOB_PROGRESS_DONE      100
+/*************************************************************************************************************************
+ *                                                       TYPEDEFS                                                        *
+ *************************************************************************************************************************/
+/**
+ * ZMOS job step function, do a short part of the job.
+ *
+ * @param state : The state of the job.
+ *
+ * @return The progress(0 ~ 100), ZMOS_JOB_PROGRESS_DONE when the job is done.
+ */
+typedef uint8_t (*zmosJobStep_t)(void *state);
+/**
+ * ZMOS background job.
+ */
+typedef struct zmos_job
+{
+    zmosJobStep_t step;
+    void *state;
+    zmos_taskHandle_t taskHandle;
+    uTaskEvent_t progressEvent;
+    uTaskEvent_t doneEvent;
+    uint8_t progress;
+    uint8_t status;
+    struct zmos_job *next;
+}zmos_job_t;
+/*************************************************************************************************************************
+ *                                                   PUBLIC FUNCTIONS                                                    *
+ *************************************************************************************************************************/
+/*****************************************************************
+* FUNCTION: zmos_jobSubmit
+*
+* DESCRIPTION:
+*     This function to submit a background job.
+* INPUTS:
+*     pJob : The job, it must be kept until done.
+*     step : The step function of the job.
+*     state : The state passed to the step function.
+*     pTaskHandle : The task to notify, NULL is none.
+*     progressEvent : Set to the task when the progress changes, 0 is none.
+*     doneEvent : Set to the task when the job is done, 0 is none.
+* RETURNS:
+*     0 : Success (ZMOS_TASK_SUCCESS).
+*     other : ref ZMOS task return cordes.
+* NOTE:
+*     The steps run only when no task is ready, in slices of
+*     the budget(zmos_jobSetSlice). Return ZMOS_TASK_FAILD when
+*     the job is queued already.
+*****************************************************************/
+taskReslt_t zmos_jobSubmit(zmos_job_t *pJob, zmosJobStep_t step, void *state, 
+                           zmos_taskHandle_t pTaskHandle, uTaskEvent_t progressEvent, uTaskEvent_t doneEvent);
+/*****************************************************************
+* FUNCTION: zmos_jobCancel
+*
+* DESCRIPTION:
+*     This function to cancel a background job.
+* INPUTS:
+*     pJob : The job.
+* RETURNS:
+*     0 : Success (ZMOS_TASK_SUCCESS).
+*     other : ref ZMOS task return cordes.
+* NOTE:
+*     No event is set to the task of the cancelled job.
+*****************************************************************/
+taskReslt_t zmos_jobCancel(zmos_job_t *pJob);
+/*****************************************************************
+* FUNCTION: zmos_jobGetProgress
+*
+* DESCRIPTION:
+*     This function to get the progress of a background job.
+* INPUTS:
+*     pJob : The job.
+* RETURNS:
+*     The progress returned by the last step(0 ~ 100).
+* NOTE:
+*     null
+*****************************************************************/
+uint8_t zmos_jobGetProgress(const zmos_job_t *pJob);
+/*****************************************************************
+* FUNCTION: zmos_jobGetStatus
+*
+* DESCRIPTION:
+*     This function to get the status of a background job.
+* INPUTS:
+*     pJob : The job.
+* RETURNS:
+*     ref ZMOS job status.
+* NOTE:
+*     null
+*****************************************************************/
+uint8_t zmos_jobGetStatus(const zmos_job_t *pJob);
+/*****************************************************************
+* FUNCTION: zmos_jobSetSlice
+*
+* DESCRIPTION:
+*     This function to set the time budget of a slice of the jobs.
+* INPUTS:
+*     slice : The budget in bsp_getCycleCount unit, 0 is one step.
+* RETURNS:
+*     null
+* NOTE:
+*     The runner stops at once when a task is ready, the budget
+*     bounds the delay by the step in progress.
+*****************************************************************/
+void zmos_jobSetSlice(uint32_t slice);
+
+#ifdef __cplusplus
+}
+#endif
+#endif /* ZMOS_Job.h */
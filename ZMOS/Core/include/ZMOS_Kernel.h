@@ -0,0 +1,277 @@
+/*****************************************************************
+* Copyright (C) 2026 zm. All rights reserved.                    *
+******************************************************************
+* ZMOS_Kernel.h
+*
+* DESCRIPTION:
+*     ZMOS kernel instance.
+* AUTHOR:
+*     zm
+* CREATED DATE:
+*     2026/10/17
+* REVISION:
+*     v0.1
+*
+* MODIFICATION HISTORY
+* --------------------
+* $Log:$
+*
+*****************************************************************/
+#ifndef __ZMOS_KERNEL_H__
+#define __ZMOS_KERNEL_H__
+ 
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+/*************************************************************************************************************************
+ *                                                       INCLUDES                                                        *
+ *************************************************************************************************************************/
+#include "ZMOS_Types.h"
+#include "ZMOS_Tasks.h"
+#include "ZMOS_Timers.h"
+#include "ZMOS_Cbtimer.h"
+#include "ZMOS_Isr.h"
+#include "ZMOS_Topic.h"
+#include "ZMOS_Thread.h"
+#include "ZMOS_Cyclic.h"
+#include "ZMOS_Job.h"
+#include "ZMOS_Idle.h"
+#include "ZMOS_Hrtimer.h"
+#include "ZMOS_Memory.h"
+#include "ZMOS_Trace.h"
+/*************************************************************************************************************************
+ *                                                        MACROS                                                         *
+ *************************************************************************************************************************/
+#if ZMOS_KERNEL_INSTANCE
+#if defined(__STDC_VERSION__) && (__STDC_VERSION__ >= 201112L) && !defined(__STDC_NO_THREADS__)
+#define ZMOS_THREAD_LOCAL           _Thread_local
+#elif defined(__GNUC__)
+#define ZMOS_THREAD_LOCAL           __thread
+#else
+#error "ZMOS_KERNEL_INSTANCE requires thread local storage!"
+#endif
+
+#if (defined ZMOS_TASK_SECTION) && (ZMOS_TASK_SECTION)
+#error "ZMOS_TASK_SECTION can't be shared by the kernel instances!"
+#endif
+#if ZMOS_USE_MEM_MGR && ZMOS_MEM_USE_HEAP
+#error "ZMOS_MEM_USE_HEAP can't be shared by the kernel instances!"
+#endif
+#endif
+
+/**
+ * The kernel used by the calling thread.
+ */
+#if ZMOS_KERNEL_INSTANCE
+#define ZMOS_KERNEL                 (zmosCurrentKernel)
+#else
+#define ZMOS_KERNEL                 (&zmosDefaultKernel)
+#endif
+/*************************************************************************************************************************
+ *                                                      CONSTANTS                                                        *
+ *************************************************************************************************************************/
+ 
+/*************************************************************************************************************************
+ *                                                       TYPEDEFS                                                        *
+ *************************************************************************************************************************/
+/**
+ * ZMOS kernel, all states of the system.
+ */
+typedef struct zmos_kernel
+{
+    /* Critical nesting */
+    uint16_t criticalNesting;
+    /* The system is initialized, the interrupts are not enabled before */
+    uint8_t systemInit;
+    /* Task list head */
+    struct zmosTaskList_T *taskListHead;
+    /* Active task */
+    zmos_taskHandle_t activeTask;
+    /* Ready priority map, bit n is set when priority n has ready task */
+    uint32_t readyPriorityMap;
+    /* Ready task list of each priority */
+    zmos_taskHandle_t readyListHead[ZMOS_TASK_PRIORITY_NUM];
+    zmos_taskHandle_t readyListTail[ZMOS_TASK_PRIORITY_NUM];
+    /* Idle task function */
+    idleTaskFunc idleFunc;
+#if ZMOS_TASK_STATS
+    /* Idle function statistics */
+    zmos_taskStats_t idleStats;
+#endif
+#if ZMOS_TASK_BUDGET
+    /* Default execution budget of the tasks */
+    uint32_t budgetDefault;
+    /* Budget overrun and escalate hooks */
+    zmosBudgetHook_t budgetHook;
+    zmosBudgetHook_t budgetEscalateHook;
+#endif
+#if ZMOS_TASK_PERIODIC
+    /* Periodic tasks */
+    zmos_taskHandle_t periodicList;
+#endif
+    /* Timer clock */
+    uint32_t timerClock;
+    struct zmos_timer *timerListHead;
+#if ZMOS_TIMER_STORE == ZMOS_TIMER_STORE_WHEEL
+    /* Next tick of the wheel */
+    uint32_t timerWheelTime;
+    /* Bitmap of the slots not empty of each level */
+    uint32_t timerWheelMap[ZMOS_TIMER_WHEEL_LEVELS];
+    struct zmos_timer *timerWheel[ZMOS_TIMER_WHEEL_LEVELS * ZMOS_TIMER_WHEEL_SLOTS];
+#endif
+#if ZMOS_TIMER_POOL_SIZE > 0
+    /* Timer pool and its free list */
+    zmos_timer_t timerPool[ZMOS_TIMER_POOL_SIZE];
+    zmos_timer_t *timerPoolFree;
+    uint32_t timerPoolUsed;
+    uint32_t timerPoolMaxUsed;
+    /* Timers from the heap when the pool is full */
+    uint32_t timerPoolMissCount;
+#endif
+#if ZMOS_USE_TIME_US
+    /* The last microsecond count and the count of its wraps */
+    uint32_t timeUsLast;
+    uint32_t timeUsHigh;
+#endif
+#if ZMOS_USE_HRTIMER
+    /* High resolution timers by the deadline */
+    zmos_hrtimer_t *hrtimerHead;
+#endif
+#if ZMOS_USE_CBTIMERS_NUM > 0
+    /* Callback timer task handle */
+    zmos_taskHandle_t cbTimerTaskHandle;
+    /* Callback timer table */
+    zmos_cbTimer_t cbTimers[ZMOS_USE_CBTIMERS_NUM];
+#endif
+#if ZMOS_USE_ISR
+    /* Tasks posted by the interrupts, push by the interrupts and take all by the scheduler */
+    zmos_taskHandle_t isrTaskStack;
+#if ZMOS_ISR_DEFER_RING_SIZE > 0
+    /* Deferred call ring */
+    zmos_deferCall_t deferRing[ZMOS_ISR_DEFER_RING_SIZE];
+    /* Write index of the ring, only the interrupt update it */
+    uint16_t deferHead;
+    /* Read index of the ring, only the scheduler update it */
+    uint16_t deferTail;
+#endif
+#endif
+#if ZMOS_USE_TOPIC
+    /* Topic subscribers */
+    zmos_topicSubscriber_t topicSubscribers[ZMOS_TOPIC_SUBSCRIBER_MAX];
+    /* Subscriber bitmap of each topic */
+    uint32_t topicMaps[ZMOS_TOPIC_NUM];
+#endif
+#if ZMOS_USE_THREAD
+    /* The main context runs the tasks, the lowest priority */
+    zmos_thread_t threadMain;
+    zmos_thread_t *threadCurrent;
+    zmos_thread_t *threads[ZMOS_THREAD_PRIORITY_NUM];
+    /* Ready bitmap of the threads */
+    uint32_t threadReadyMap;
+#endif
+#if ZMOS_USE_CYCLIC
+    /* Cyclic schedule table, NULL is stopped */
+    const zmos_cyclicTable_t *cyclicTable;
+    /* Timer clock of the next frame boundary */
+    uint32_t cyclicBoundary;
+    /* Next minor frame */
+    uint16_t cyclicFrame;
+    zmos_cyclicStats_t cyclicStats;
+#endif
+#if ZMOS_USE_JOB
+    /* Background job queue */
+    zmos_job_t *jobHead;
+    zmos_job_t *jobTail;
+    /* Time budget of a slice */
+    uint32_t jobSlice;
+#endif
+#if ZMOS_USE_IDLE_HOOK
+    /* Idle hooks by priority */
+    zmos_idleHook_t *idleHookHead;
+#endif
+#if ZMOS_USE_LOW_POWER
+    /* Low power hold events */
+    uint32_t lowPwrEvents;
+#endif
+#if ZMOS_TRACE
+    /* Trace recording, 1 is on */
+    uint8_t traceEnable;
+    /* Trace ring buffer */
+    zmos_traceBuffer_t traceBuffer;
+#endif
+#if ZMOS_USE_MEM_MGR
+#if !ZMOS_MEM_USE_HEAP
+    /* Memory pool */
+    zm_uint8_t memPool[ZMOS_MEM_SIZE];
+#endif
+    /* Pointer to the heap */
+    zm_uint8_t *memHeap;
+    /* The last entry, always unused */
+    struct zmosMem *memEnd;
+    /* Pointer to the lowest free block */
+    struct zmosMem *memLfree;
+    zm_size_t memSize;
+#if ZMOS_MEM_STATS
+    zmosMemStats_t memStats;
+#endif
+#endif
+    /* Bsp private data of the kernel */
+    void *bspData;
+}zmos_kernel_t;
+/*************************************************************************************************************************
+ *                                                   PUBLIC FUNCTIONS                                                    *
+ *************************************************************************************************************************/
+#if ZMOS_KERNEL_INSTANCE
+extern ZMOS_THREAD_LOCAL zmos_kernel_t *zmosCurrentKernel;
+#else
+extern zmos_kernel_t zmosDefaultKernel;
+#endif
+/*****************************************************************
+* FUNCTION: zmos_kernelInit
+*
+* DESCRIPTION:
+*     This function to initialize a kernel instance and select it.
+* INPUTS:
+*     pKernel : The kernel instance.
+* RETURNS:
+*     null
+* NOTE:
+*     Call zmos_system_init after it to initialize the system
+*     of the kernel.
+*****************************************************************/
+void zmos_kernelInit(zmos_kernel_t *pKernel);
+/*****************************************************************
+* FUNCTION: zmos_kernelSelect
+*
+* DESCRIPTION:
+*     This function to select the kernel used by the calling thread.
+* INPUTS:
+*     pKernel : The kernel instance, NULL is the default kernel.
+* RETURNS:
+*     The kernel selected before.
+* NOTE:
+*     All ZMOS functions called by the thread work on the selected
+*     kernel. A thread can run many kernels in turn, and other
+*     threads set events to the kernel by select it first, the
+*     critical section of the bsp protects the kernel.
+*****************************************************************/
+zmos_kernel_t *zmos_kernelSelect(zmos_kernel_t *pKernel);
+/*****************************************************************
+* FUNCTION: zmos_getKernel
+*
+* DESCRIPTION:
+*     This function to get the kernel used by the calling thread.
+* INPUTS:
+*     null
+* RETURNS:
+*     The kernel instance.
+* NOTE:
+*     null
+*****************************************************************/
+zmos_kernel_t *zmos_getKernel(void);
+
+#ifdef __cplusplus
+}
+#endif
+#endif /* ZMOS_Kernel.h */
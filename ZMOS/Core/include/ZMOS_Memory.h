@@ -46,6 +46,15 @@ extern int __bss_end;
 /*************************************************************************************************************************
  *                                                       TYPEDEFS                                                        *
  *************************************************************************************************************************/
+/**
+ * ZMOS memory statistics.
+ */
+typedef struct
+{
+    //zm_size_t surpSize;
+    zm_size_t usedSize;
+    zm_size_t maxSize;
+}zmosMemStats_t;
 
 /*************************************************************************************************************************
  *                                                   PUBLIC FUNCTIONS                                                    *
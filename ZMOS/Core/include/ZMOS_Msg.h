@@ -0,0 +1,120 @@
+/*****************************************************************
+* Copyright (C) 2026 zm. All rights reserved.                    *
+******************************************************************
+* ZMOS_Msg.h
+*
+* DESCRIPTION:
+*     ZMOS task message queue.
+* AUTHOR:
+*     zm
+* CREATED DATE:
+*     2026/10/17
+* REVISION:
+*     v0.1
+*
+* MODIFICATION HISTORY
+* --------------------
+* $Log:$
+*
+*****************************************************************/
+#ifndef __ZMOS_MSG_H__
+#define __ZMOS_MSG_H__
+ 
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+/*************************************************************************************************************************
+ *                                                       INCLUDES                                                        *
+ *************************************************************************************************************************/
+#include "ZMOS_Tasks.h"
+/*************************************************************************************************************************
+ *                                                        MACROS                                                         *
+ *************************************************************************************************************************/
+ 
+/*************************************************************************************************************************
+ *                                                      CONSTANTS                                                        *
+ *************************************************************************************************************************/
+ 
+/*************************************************************************************************************************
+ *                                                       TYPEDEFS                                                        *
+ *************************************************************************************************************************/
+
+/*************************************************************************************************************************
+ *                                                   PUBLIC FUNCTIONS                                                    *
+ *************************************************************************************************************************/
+/*****************************************************************
+* FUNCTION: zmos_msgAlloc
+*
+* DESCRIPTION:
+*     Allocate a message buffer from the ZMOS heap.
+* INPUTS:
+*     len : Message payload length.
+* RETURNS:
+*     Pointer to the message payload.
+*     NULL : Out of memory.
+* NOTE:
+*     Don't call it in the interrupt.
+*****************************************************************/
+void *zmos_msgAlloc(uint16_t len);
+/*****************************************************************
+* FUNCTION: zmos_msgSend
+*
+* DESCRIPTION:
+*     Send a message to the task, the message is linked
+*     into the task message queue without copying.
+* INPUTS:
+*     pTaskHandle : The handle of the task to receive.
+*     pMsg : The message allocated by zmos_msgAlloc.
+* RETURNS:
+*     0 : Success (ZMOS_TASK_SUCCESS).
+*     other : ref ZMOS task return cordes.
+* NOTE:
+*     The ZMOS_TASK_MSG_EVENT will be set to the task.
+*****************************************************************/
+taskReslt_t zmos_msgSend(zmos_taskHandle_t pTaskHandle, void *pMsg);
+/*****************************************************************
+* FUNCTION: zmos_msgReceive
+*
+* DESCRIPTION:
+*     Receive a message from the task message queue.
+* INPUTS:
+*     pTaskHandle : The handle of the task, NULL is the current task.
+* RETURNS:
+*     Pointer to the message payload.
+*     NULL : No message.
+* NOTE:
+*     The message must be freed by zmos_msgFree.
+*****************************************************************/
+void *zmos_msgReceive(zmos_taskHandle_t pTaskHandle);
+/*****************************************************************
+* FUNCTION: zmos_msgFree
+*
+* DESCRIPTION:
+*     Free a message.
+* INPUTS:
+*     pMsg : The message to free.
+* RETURNS:
+*     null
+* NOTE:
+*     null
+*****************************************************************/
+void zmos_msgFree(void *pMsg);
+/*****************************************************************
+* FUNCTION: zmos_msgGetLength
+*
+* DESCRIPTION:
+*     Get the payload length of a message.
+* INPUTS:
+*     pMsg : The message.
+* RETURNS:
+*     The message payload length.
+* NOTE:
+*     null
+*****************************************************************/
+uint16_t zmos_msgGetLength(void *pMsg);
+
+#ifdef __cplusplus
+}
+#endif
+#endif /* ZMOS_Msg.h */
@@ -37,6 +37,33 @@ extern "C"
 #define ZMOS_TASK_SUCCESS           0
 #define ZMOS_TASK_FAILD             1
 #define ZMOS_TASK_ERROR_PARAM       2
+
+/* ZMOS task priority */
+#define ZMOS_TASK_PRIORITY_LOWEST   0
+#define ZMOS_TASK_PRIORITY_HIGHEST  (ZMOS_TASK_PRIORITY_NUM - 1)
+#define ZMOS_TASK_PRIORITY_DEFAULT  (ZMOS_TASK_PRIORITY_NUM / 2)
+
+#if ZMOS_USE_MSG
+/* ZMOS system reserved event, the task has messages */
+#define ZMOS_TASK_MSG_EVENT         ((uTaskEvent_t)1 << (ZMOS_TASK_EVENT_NUM_MAX - 1))
+#endif
+
+#if ZMOS_TASK_LATENCY
+/* Number of latency histogram buckets, bucket n counts latency 2^(n-1) ~ 2^n-1 */
+#define ZMOS_TASK_LATENCY_BUCKET_NUM    32
+#endif
+
+/* ZMOS invalid static task index */
+#define ZMOS_TASK_INVALID_INDEX     0xFFFF
+#if ZMOS_TASK_PERIODIC
+/* ZMOS task job states */
+#define ZMOS_TASK_JOB_ACTIVE        0x01
+#define ZMOS_TASK_JOB_MISSED        0x02
+#endif
+
+#if (ZMOS_TASK_PRIORITY_NUM < 1) || (ZMOS_TASK_PRIORITY_NUM > 32)
+#error "ZMOS_TASK_PRIORITY_NUM must be 1 ~ 32!"
+#endif
      
 /*************************************************************************************************************************
  *                                                      CONSTANTS                                                        *
@@ -51,6 +78,11 @@ extern "C"
  * @ref ZMOS task return cordes.
  */
 typedef uint8_t taskReslt_t;
+/**
+ * ZMOS task priority type.
+ * ZMOS_TASK_PRIORITY_LOWEST ~ ZMOS_TASK_PRIORITY_HIGHEST.
+ */
+typedef uint8_t taskPriority_t;
 /**
  * Zmos task handle.
  */
@@ -62,6 +94,76 @@ typedef struct zmos_task*  zmos_taskHandle_t;
  * @param event : task event.
  */
 typedef uTaskEvent_t (*taskFunction_t)(uTaskEvent_t event);
+/**
+ * Event table handler function prototype.
+ *
+ * @param event : The task event to handle(only one bit is set).
+ * @return The events to set again.
+ */
+typedef uTaskEvent_t (*taskEventHandler_t)(uTaskEvent_t event);
+#if ZMOS_TASK_CONTEXT
+/**
+ * ZMOS task function with user context, one function can serve many tasks.
+ *
+ * @param context : The context of the task.
+ * @param event : The task events.
+ * @return The events not handled.
+ */
+typedef uTaskEvent_t (*taskContextFunction_t)(void *context, uTaskEvent_t event);
+#endif
+#if ZMOS_TASK_STATS
+/**
+ * ZMOS task statistics, the time unit is bsp_getCycleCount.
+ */
+typedef struct
+{
+    uint32_t dispatchCount;     //!< Number of times the task was run.
+    uint32_t unprocessedCount;  //!< Number of times the task returned unprocessed events.
+    uint32_t lastTime;          //!< Execution time of the last run.
+    uint32_t maxTime;           //!< Maximum execution time.
+    uint64_t totalTime;         //!< Total execution time.
+}zmos_taskStats_t;
+#endif
+#if ZMOS_TASK_LATENCY
+/**
+ * ZMOS task latency record, the time unit is bsp_getCycleCount.
+ */
+typedef struct
+{
+    uint32_t setTime[ZMOS_TASK_EVENT_NUM_MAX];         //!< Time of each pending event was set.
+    uint32_t bucket[ZMOS_TASK_LATENCY_BUCKET_NUM];     //!< Log2 histogram of the latency.
+    uint32_t count;                                    //!< Number of the latency samples.
+    uint32_t minLatency;                               //!< Minimum latency.
+    uint32_t maxLatency;                               //!< Maximum latency.
+}zmos_taskLatency_t;
+#endif
+#if ZMOS_TASK_BUDGET
+/**
+ * ZMOS task budget statistics, the time unit is bsp_getCycleCount.
+ */
+typedef struct
+{
+    uint32_t overrunCount;      //!< Number of dispatches over the budget.
+    uint32_t consecutiveCount;  //!< Number of consecutive overruns until now.
+    uint32_t escalateCount;     //!< Number of times the escalate hook was called.
+    uint32_t lastOverrun;       //!< Time over the budget of the last overrun.
+    uint32_t maxOverrun;        //!< Maximum time over the budget.
+    uTaskEvent_t lastEvents;    //!< Events handled by the last overrun dispatch.
+}zmos_taskBudgetStats_t;
+#endif
+#if ZMOS_TASK_PERIODIC
+/**
+ * ZMOS task deadline statistics, the time unit is timer clock(ms).
+ */
+typedef struct
+{
+    uint32_t jobCount;          //!< Number of jobs released.
+    uint32_t missCount;         //!< Number of jobs not done before the deadline.
+    uint32_t skipCount;         //!< Number of releases skipped or merged into a job not done.
+    uint32_t lastLateness;      //!< Time after the deadline of the last missed job.
+    uint32_t maxLateness;       //!< Maximum time after the deadline.
+}zmos_taskDeadlineStats_t;
+#endif
 /**
  * ZMOS task struct.
  */
@@ -69,12 +171,73 @@ typedef struct zmos_task
 {
     uTaskEvent_t event;
     taskFunction_t taskFunc;
+    const taskEventHandler_t *eventTable;
+    uint8_t eventTableNum;
+    taskPriority_t priority;
+#if ZMOS_TASK_CONTEXT
+    taskContextFunction_t contextFunc;
+    void *context;
+#endif
+    struct zmos_task *readyNext;
+    struct zmos_task *readyPrev;
+#if ZMOS_USE_MSG
+    void *msgHead;
+    void *msgTail;
+#endif
+#if ZMOS_USE_ISR
+    uTaskEvent_t isrEvent;
+    struct zmos_task *isrNext;
+#endif
+#if ZMOS_TASK_EVENT_COUNT
+    uTaskEvent_t countEvents;
+    uint8_t *eventCounters;
+    uint32_t mergedEvents;
+#endif
+#if ZMOS_TASK_STATS
+    zmos_taskStats_t stats;
+#endif
+#if ZMOS_TASK_LATENCY
+    zmos_taskLatency_t *latency;
+#endif
+#if ZMOS_TASK_BUDGET
+    uint32_t budget;
+    zmos_taskBudgetStats_t budgetStats;
+#endif
+#if ZMOS_TASK_PERIODIC
+    uint32_t period;
+    uint32_t relDeadline;
+    /* Timer clock of the next release */
+    uint32_t release;
+    /* Absolute deadline of the current job */
+    uint32_t deadline;
+    uTaskEvent_t jobEvent;
+    uint8_t jobState;
+    struct zmos_task *periodicNext;
+    zmos_taskDeadlineStats_t deadlineStats;
+#endif
+#if ZMOS_TASK_AGING_TIME > 0
+    uint32_t readyTime;
+#endif
+#if ZMOS_TIMER_STORE != ZMOS_TIMER_STORE_LIST
+    /* Timers of the task */
+    struct zmos_timer *timerList;
+#endif
 }zmos_task_t;
 
 /**
  * ZMOS idle task function.
  */
 typedef void (* idleTaskFunc)(void);
+#if ZMOS_TASK_BUDGET
+/**
+ * ZMOS task budget hook.
+ *
+ * @param pTask : The task over the budget.
+ * @param events : The events handled by the dispatch.
+ * @param overrun : Time over the budget.
+ */
+typedef void (* zmosBudgetHook_t)(zmos_taskHandle_t pTask, uTaskEvent_t events, uint32_t overrun);
+#endif
 /*************************************************************************************************************************
  *                                                   PUBLIC FUNCTIONS                                                    *
  *************************************************************************************************************************/
@@ -95,6 +258,79 @@ typedef void (* idleTaskFunc)(void);
 *****************************************************************/
 taskReslt_t zmos_taskThreadRegister(zmos_taskHandle_t * const pTaskHandle, taskFunction_t taskFunc);
 /*****************************************************************
+* FUNCTION: zmos_taskThreadRegisterPriority
+*
+* DESCRIPTION:
+*     Register task thread to ZMOS with priority.
+* INPUTS:
+*     pTaskHandle : The handle of the task.
+*     taskFunc : Task function.
+*     priority : Task priority(0 ~ ZMOS_TASK_PRIORITY_HIGHEST).
+* RETURNS:
+*     0 : Success (ZMOS_TASK_SUCCESS).
+*     other : ref ZMOS task return cordes.
+* NOTE:
+*     If the task is registered, the priority will not be changed.
+*****************************************************************/
+taskReslt_t zmos_taskThreadRegisterPriority(zmos_taskHandle_t * const pTaskHandle, taskFunction_t taskFunc, taskPriority_t priority);
+/*****************************************************************
+* FUNCTION: zmos_taskThreadRegisterTable
+*
+* DESCRIPTION:
+*     Register task thread to ZMOS with an event handler table.
+* INPUTS:
+*     pTaskHandle : The handle of the task.
+*     eventTable : Event handlers indexed by event bit.
+*     tableNum : Number of the event handlers.
+*     priority : Task priority(0 ~ ZMOS_TASK_PRIORITY_HIGHEST).
+* RETURNS:
+*     0 : Success (ZMOS_TASK_SUCCESS).
+*     other : ref ZMOS task return cordes.
+* NOTE:
+*     All pending events are handled within one dispatch, the 
+*     order is set by ZMOS_TASK_EVENT_TABLE_MSB_FIRST. Events 
+*     without handler are discarded.
+*****************************************************************/
+taskReslt_t zmos_taskThreadRegisterTable(zmos_taskHandle_t * const pTaskHandle, const taskEventHandler_t *eventTable, 
+                                         uint8_t tableNum, taskPriority_t priority);
+#if ZMOS_TASK_CONTEXT
+/*****************************************************************
+* FUNCTION: zmos_taskThreadRegisterContext
+*
+* DESCRIPTION:
+*     Register task thread to ZMOS with a user context.
+* INPUTS:
+*     pTaskHandle : The handle of the task(can't be NULL).
+*     taskFunc : Task function with context.
+*     context : The context passed to the task function.
+*     priority : Task priority(0 ~ ZMOS_TASK_PRIORITY_HIGHEST).
+* RETURNS:
+*     0 : Success (ZMOS_TASK_SUCCESS).
+*     other : ref ZMOS task return cordes.
+* NOTE:
+*     The task is identified by the handle, one task function can 
+*     be registered many times with different handles. If the 
+*     handle is a registered task, it's not registered again.
+*****************************************************************/
+taskReslt_t zmos_taskThreadRegisterContext(zmos_taskHandle_t * const pTaskHandle, taskContextFunction_t taskFunc, 
+                                           void *context, taskPriority_t priority);
+#endif
+/*****************************************************************
+* FUNCTION: zmos_setTaskPriority
+*
+* DESCRIPTION:
+*     This function to change the task priority.
+* INPUTS:
+*     pTaskHandle : The handle of the task.
+*     priority : New priority(0 ~ ZMOS_TASK_PRIORITY_HIGHEST).
+* RETURNS:
+*     0 : Success (ZMOS_TASK_SUCCESS).
+*     other : ref ZMOS task return cordes.
+* NOTE:
+*     null
+*****************************************************************/
+taskReslt_t zmos_setTaskPriority(zmos_taskHandle_t pTaskHandle, taskPriority_t priority);
+/*****************************************************************
 * FUNCTION: zmos_setTaskEvent
 *
 * DESCRIPTION:
@@ -125,6 +361,261 @@ taskReslt_t zmos_setTaskEvent(zmos_taskHandle_t pTaskHandle, uTaskEvent_t events
 *****************************************************************/
 taskReslt_t zmos_clearTaskEvent(zmos_taskHandle_t pTaskHandle, uTaskEvent_t events);
 /*****************************************************************
+* FUNCTION: zmos_setTaskEventCounter
+*
+* DESCRIPTION:
+*     This function to enable counting of task events.
+* INPUTS:
+*     pTaskHandle : The handle of the task.
+*     events : The events to count.
+*     counters : Counter array of ZMOS_TASK_EVENT_NUM_MAX, indexed
+*                  by event bit. NULL to disable counting.
+* RETURNS:
+*     0 : Success (ZMOS_TASK_SUCCESS).
+*     other : ref ZMOS task return cordes.
+* NOTE:
+*     Each zmos_setTaskEvent of a counted event increases its
+*     counter, the counter saturates at 255.
+*****************************************************************/
+taskReslt_t zmos_setTaskEventCounter(zmos_taskHandle_t pTaskHandle, uTaskEvent_t events, uint8_t *counters);
+/*****************************************************************
+* FUNCTION: zmos_takeTaskEventCount
+*
+* DESCRIPTION:
+*     This function to read and clear the count of a task event.
+* INPUTS:
+*     pTaskHandle : The handle of the task, NULL is the current task.
+*     event : The event to read(only one bit).
+* RETURNS:
+*     The number of times the event was set since last taken.
+* NOTE:
+*     null
+*****************************************************************/
+uint8_t zmos_takeTaskEventCount(zmos_taskHandle_t pTaskHandle, uTaskEvent_t event);
+/*****************************************************************
+* FUNCTION: zmos_getTaskMergedEvents
+*
+* DESCRIPTION:
+*     This function to get the number of merged event signals.
+* INPUTS:
+*     pTaskHandle : The handle of the task.
+* RETURNS:
+*     The number of times an event was set while it was still pending.
+* NOTE:
+*     null
+*****************************************************************/
+uint32_t zmos_getTaskMergedEvents(zmos_taskHandle_t pTaskHandle);
+#if ZMOS_TASK_STATS
+/*****************************************************************
+* FUNCTION: zmos_getTaskStats
+*
+* DESCRIPTION:
+*     This function to get a snapshot of the task statistics.
+* INPUTS:
+*     pTaskHandle : The handle of the task.
+*     pStats : Return the statistics.
+* RETURNS:
+*     0 : Success (ZMOS_TASK_SUCCESS).
+*     other : ref ZMOS task return cordes.
+* NOTE:
+*     Only valid when ZMOS_TASK_STATS is enabled.
+*****************************************************************/
+taskReslt_t zmos_getTaskStats(zmos_taskHandle_t pTaskHandle, zmos_taskStats_t *pStats);
+/*****************************************************************
+* FUNCTION: zmos_getIdleStats
+*
+* DESCRIPTION:
+*     This function to get a snapshot of the idle function statistics.
+* INPUTS:
+*     pStats : Return the statistics.
+* RETURNS:
+*     0 : Success (ZMOS_TASK_SUCCESS).
+*     other : ref ZMOS task return cordes.
+* NOTE:
+*     dispatchCount is the number of times the idle function was run.
+*****************************************************************/
+taskReslt_t zmos_getIdleStats(zmos_taskStats_t *pStats);
+/*****************************************************************
+* FUNCTION: zmos_resetTaskStats
+*
+* DESCRIPTION:
+*     This function to reset the task statistics.
+* INPUTS:
+*     pTaskHandle : The handle of the task, NULL to reset all tasks and idle.
+* RETURNS:
+*     0 : Success (ZMOS_TASK_SUCCESS).
+*     other : ref ZMOS task return cordes.
+* NOTE:
+*     null
+*****************************************************************/
+taskReslt_t zmos_resetTaskStats(zmos_taskHandle_t pTaskHandle);
+#endif
+#if ZMOS_TASK_LATENCY
+/*****************************************************************
+* FUNCTION: zmos_setTaskLatencyRecord
+*
+* DESCRIPTION:
+*     This function to attach the latency record to the task.
+* INPUTS:
+*     pTaskHandle : The handle of the task.
+*     pLatency : The latency record, NULL to stop recording.
+* RETURNS:
+*     0 : Success (ZMOS_TASK_SUCCESS).
+*     other : ref ZMOS task return cordes.
+* NOTE:
+*     The latency from the first set of a pending event to the
+*     dispatch of the event is recorded.
+*****************************************************************/
+taskReslt_t zmos_setTaskLatencyRecord(zmos_taskHandle_t pTaskHandle, zmos_taskLatency_t *pLatency);
+/*****************************************************************
+* FUNCTION: zmos_resetTaskLatency
+*
+* DESCRIPTION:
+*     This function to reset the latency record of the task.
+* INPUTS:
+*     pTaskHandle : The handle of the task.
+* RETURNS:
+*     0 : Success (ZMOS_TASK_SUCCESS).
+*     other : ref ZMOS task return cordes.
+* NOTE:
+*     null
+*****************************************************************/
+taskReslt_t zmos_resetTaskLatency(zmos_taskHandle_t pTaskHandle);
+/*****************************************************************
+* FUNCTION: zmos_getTaskLatencyPercentile
+*
+* DESCRIPTION:
+*     This function to get the latency percentile of the task.
+* INPUTS:
+*     pTaskHandle : The handle of the task.
+*     percent : The percentile(1 ~ 100).
+* RETURNS:
+*     The upper bound of the histogram bucket of the percentile.
+* NOTE:
+*     Minimum and maximum are read from the latency record.
+*****************************************************************/
+uint32_t zmos_getTaskLatencyPercentile(zmos_taskHandle_t pTaskHandle, uint8_t percent);
+#endif
+#if ZMOS_TASK_BUDGET
+/*****************************************************************
+* FUNCTION: zmos_setTaskBudget
+*
+* DESCRIPTION:
+*     This function to set the execution budget of the task.
+* INPUTS:
+*     pTaskHandle : The handle of the task, NULL to set the default
+*                   budget of all tasks.
+*     budget : The budget in bsp_getCycleCount unit, 0 of the task
+*              uses the default budget, 0 of the default is no budget.
+* RETURNS:
+*     0 : Success (ZMOS_TASK_SUCCESS).
+*     other : ref ZMOS task return cordes.
+* NOTE:
+*     The default budget is ZMOS_TASK_BUDGET_DEFAULT.
+*****************************************************************/
+taskReslt_t zmos_setTaskBudget(zmos_taskHandle_t pTaskHandle, uint32_t budget);
+/*****************************************************************
+* FUNCTION: zmos_setTaskBudgetHook
+*
+* DESCRIPTION:
+*     This function to set the hooks called when a task is over
+*     the budget.
+* INPUTS:
+*     overrunHook : Called on each overrun, NULL is none.
+*     escalateHook : Called when a task is over the budget
+*                    ZMOS_TASK_BUDGET_ESCALATE times in a row, NULL is none.
+* RETURNS:
+*     null
+* NOTE:
+*     The hooks are called by the scheduler after the dispatch,
+*     the escalate hook may log the fault and reset the system
+*     or stop feeding the watchdog.
+*****************************************************************/
+void zmos_setTaskBudgetHook(zmosBudgetHook_t overrunHook, zmosBudgetHook_t escalateHook);
+/*****************************************************************
+* FUNCTION: zmos_getTaskBudgetStats
+*
+* DESCRIPTION:
+*     This function to get a snapshot of the task budget statistics.
+* INPUTS:
+*     pTaskHandle : The handle of the task.
+*     pStats : Return the statistics.
+* RETURNS:
+*     0 : Success (ZMOS_TASK_SUCCESS).
+*     other : ref ZMOS task return cordes.
+* NOTE:
+*     null
+*****************************************************************/
+taskReslt_t zmos_getTaskBudgetStats(zmos_taskHandle_t pTaskHandle, zmos_taskBudgetStats_t *pStats);
+/*****************************************************************
+* FUNCTION: zmos_resetTaskBudgetStats
+*
+* DESCRIPTION:
+*     This function to reset the task budget statistics.
+* INPUTS:
+*     pTaskHandle : The handle of the task, NULL to reset all tasks.
+* RETURNS:
+*     0 : Success (ZMOS_TASK_SUCCESS).
+*     other : ref ZMOS task return cordes.
+* NOTE:
+*     null
+*****************************************************************/
+taskReslt_t zmos_resetTaskBudgetStats(zmos_taskHandle_t pTaskHandle);
+#endif
+#if ZMOS_TASK_PERIODIC
+/*****************************************************************
+* FUNCTION: zmos_setTaskPeriodic
+*
+* DESCRIPTION:
+*     This function to make the task periodic, the event is set to
+*     the task as a job each period.
+* INPUTS:
+*     pTaskHandle : The handle of the task, NULL is the current task.
+*     period : The period in timer clock(ms), 0 to stop.
+*     deadline : The deadline from the release, 0 is the period.
+*     offset : The first release from now.
+*     event : The event of the job.
+* RETURNS:
+*     0 : Success (ZMOS_TASK_SUCCESS).
+*     other : ref ZMOS task return cordes.
+* NOTE:
+*     The releases are at fixed times of the period, the job is
+*     done when the task returns with the event cleared. Setting
+*     again restarts the releases and resets the statistics.
+*****************************************************************/
+taskReslt_t zmos_setTaskPeriodic(zmos_taskHandle_t pTaskHandle, uint32_t period, uint32_t deadline, 
+                                 uint32_t offset, uTaskEvent_t event);
+/*****************************************************************
+* FUNCTION: zmos_getTaskDeadlineStats
+*
+* DESCRIPTION:
+*     This function to get a snapshot of the task deadline statistics.
+* INPUTS:
+*     pTaskHandle : The handle of the task.
+*     pStats : Return the statistics.
+* RETURNS:
+*     0 : Success (ZMOS_TASK_SUCCESS).
+*     other : ref ZMOS task return cordes.
+* NOTE:
+*     null
+*****************************************************************/
+taskReslt_t zmos_getTaskDeadlineStats(zmos_taskHandle_t pTaskHandle, zmos_taskDeadlineStats_t *pStats);
+/*****************************************************************
+* FUNCTION: zmos_resetTaskDeadlineStats
+*
+* DESCRIPTION:
+*     This function to reset the task deadline statistics.
+* INPUTS:
+*     pTaskHandle : The handle of the task, NULL to reset all tasks.
+* RETURNS:
+*     0 : Success (ZMOS_TASK_SUCCESS).
+*     other : ref ZMOS task return cordes.
+* NOTE:
+*     null
+*****************************************************************/
+taskReslt_t zmos_resetTaskDeadlineStats(zmos_taskHandle_t pTaskHandle);
+#endif
+/*****************************************************************
 * FUNCTION: zmos_setIdleTaskFunction
 *
 * DESCRIPTION:
@@ -151,6 +642,22 @@ void zmos_setIdleTaskFunction(idleTaskFunc func);
 *     null
 *****************************************************************/
 zmos_taskHandle_t zmos_getCurrentTaskHandle(void);
+#if ZMOS_TASK_CONTEXT
+/*****************************************************************
+* FUNCTION: zmos_getCurrentTaskContext
+*
+* DESCRIPTION:
+*     This function to get the context of the current task.
+* INPUTS:
+*     null
+* RETURNS:
+*     The context of the current task.
+*     NULL : No tasks are currently running or no context.
+* NOTE:
+*     null
+*****************************************************************/
+void *zmos_getCurrentTaskContext(void);
+#endif
 /*****************************************************************
 * FUNCTION: zmos_checkTaskIsIdle
 *
@@ -165,6 +672,47 @@ zmos_taskHandle_t zmos_getCurrentTaskHandle(void);
 *     null
 *****************************************************************/
 uint8_t zmos_checkTaskIsIdle(void);
+/*****************************************************************
+* FUNCTION: zmos_getStaticTaskNum
+*
+* DESCRIPTION:
+*     This function to get the number of static tasks.
+* INPUTS:
+*     null
+* RETURNS:
+*     Number of tasks defined by ZMOS_TASK_DEFINE.
+* NOTE:
+*     null
+*****************************************************************/
+uint16_t zmos_getStaticTaskNum(void);
+/*****************************************************************
+* FUNCTION: zmos_getTaskIndex
+*
+* DESCRIPTION:
+*     This function to get the index of a static task.
+* INPUTS:
+*     pTaskHandle : The handle of the task.
+* RETURNS:
+*     The index of the task in the task section.
+*     ZMOS_TASK_INVALID_INDEX : Not a static task.
+* NOTE:
+*     null
+*****************************************************************/
+uint16_t zmos_getTaskIndex(zmos_taskHandle_t pTaskHandle);
+/*****************************************************************
+* FUNCTION: zmos_getTaskHandleByIndex
+*
+* DESCRIPTION:
+*     This function to get the handle of a static task by index.
+* INPUTS:
+*     index : The index of the task in the task section.
+* RETURNS:
+*     Task handle.
+*     NULL : Index out of range.
+* NOTE:
+*     null
+*****************************************************************/
+zmos_taskHandle_t zmos_getTaskHandleByIndex(uint16_t index);
 
 
 #ifdef __cplusplus
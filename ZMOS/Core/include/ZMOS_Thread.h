@@ -0,0 +1,157 @@
+/*****************************************************************
+* Copyright (C) 2026 zm. All rights reserved.                    *
+******************************************************************
+* ZMOS_Thread.h
+*
+* DESCRIPTION:
+*     ZMOS preemptive fixed priority threads.
+* AUTHOR:
+*     zm
+* CREATED DATE:
+*     2026/10/17
+* REVISION:
+*     v0.1
+*
+* MODIFICATION HISTORY
+* --------------------
+* $Log:$
+*
+*****************************************************************/
+#ifndef __ZMOS_THREAD_H__
+#define __ZMOS_THREAD_H__
+ 
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+/*************************************************************************************************************************
+ *                                                       INCLUDES                                                        *
+ *************************************************************************************************************************/
+#include "ZMOS_Tasks.h"
+/*************************************************************************************************************************
+ *                                                        MACROS                                                         *
+ *************************************************************************************************************************/
+ 
+/*************************************************************************************************************************
+ *                                                      CONSTANTS                                                        *
+ *************************************************************************************************************************/
+/**
+ * ZMOS thread states.
+ */
+#define ZMOS_THREAD_READY           0
+#define ZMOS_THREAD_WAIT            1
+#define ZMOS_THREAD_EXIT            2
+/*************************************************************************************************************************
+ *                                                       TYPEDEFS                                                        *
+ *************************************************************************************************************************/
+/**
+ * ZMOS thread function, the thread exits when it returns.
+ *
+ * @param arg : The param passed to zmos_threadCreate.
+ */
+typedef void (*zmosThreadFunc_t)(void *arg);
+/**
+ * ZMOS thread.
+ */
+typedef struct zmos_thread
+{
+    /* Context of the bsp(stack pointer), must be the first */
+    void *sp;
+    zmosThreadFunc_t func;
+    void *arg;
+    /* Pending events */
+    uTaskEvent_t event;
+    /* Events waited by the thread */
+    uTaskEvent_t waitEvents;
+    uint8_t priority;
+    uint8_t state;
+}zmos_thread_t;
+/*************************************************************************************************************************
+ *                                                   PUBLIC FUNCTIONS                                                    *
+ *************************************************************************************************************************/
+/*****************************************************************
+* FUNCTION: zmos_threadCreate
+*
+* DESCRIPTION:
+*     This function to create a preemptive thread.
+* INPUTS:
+*     pThread : The thread.
+*     func : The thread function.
+*     arg : The param of the thread function.
+*     stack : The stack of the thread.
+*     stackSize : The stack size in bytes.
+*     priority : Thread priority(0 ~ ZMOS_THREAD_PRIORITY_NUM - 1).
+* RETURNS:
+*     0 : Success (ZMOS_TASK_SUCCESS).
+*     other : ref ZMOS task return cordes.
+* NOTE:
+*     Call it after zmos_system_init. All threads preempt the
+*     tasks, one thread of each priority, return ZMOS_TASK_FAILD
+*     when the priority is used.
+*****************************************************************/
+taskReslt_t zmos_threadCreate(zmos_thread_t *pThread, zmosThreadFunc_t func, void *arg,
+                              void *stack, zm_size_t stackSize, uint8_t priority);
+/*****************************************************************
+* FUNCTION: zmos_threadSetEvent
+*
+* DESCRIPTION:
+*     This function to set the events of the thread.
+* INPUTS:
+*     pThread : The thread.
+*     events : What events to set.
+* RETURNS:
+*     0 : Success (ZMOS_TASK_SUCCESS).
+*     other : ref ZMOS task return cordes.
+* NOTE:
+*     It can be called by the tasks, threads and interrupts, the
+*     waiting thread preempts at once if it's the highest.
+*****************************************************************/
+taskReslt_t zmos_threadSetEvent(zmos_thread_t *pThread, uTaskEvent_t events);
+/*****************************************************************
+* FUNCTION: zmos_threadWaitEvent
+*
+* DESCRIPTION:
+*     This function to wait any of the events by the current thread.
+* INPUTS:
+*     events : What events to wait.
+* RETURNS:
+*     The events received, they are cleared.
+* NOTE:
+*     Only the thread can wait, it returns 0 at once in the tasks.
+*     The thread signals the tasks by zmos_setTaskEvent.
+*****************************************************************/
+uTaskEvent_t zmos_threadWaitEvent(uTaskEvent_t events);
+/*****************************************************************
+* FUNCTION: zmos_threadSelf
+*
+* DESCRIPTION:
+*     This function to get the current thread.
+* INPUTS:
+*     null
+* RETURNS:
+*     The current thread.
+*     NULL : Run in the tasks.
+* NOTE:
+*     null
+*****************************************************************/
+zmos_thread_t *zmos_threadSelf(void);
+/*****************************************************************
+* FUNCTION: zmos_threadSwitchContext
+*
+* DESCRIPTION:
+*     This function to save the context of the current thread
+*     and select the highest ready thread.
+* INPUTS:
+*     sp : The context of the current thread.
+* RETURNS:
+*     The context of the thread to run.
+* NOTE:
+*     Only called by the bsp context switch with the interrupts
+*     disabled.
+*****************************************************************/
+void *zmos_threadSwitchContext(void *sp);
+
+#ifdef __cplusplus
+}
+#endif
+#endif /* ZMOS_Thread.h */
@@ -36,6 +36,20 @@ extern "C"
 /* ZMOS task return cordes */
 #define ZMOS_TIMER_SUCCESS          0
 #define ZMOS_TIMER_FAILD            1
+#if ZMOS_TIMER_PERIODIC
+/* Overrun policies of the periodic timer */
+#define ZMOS_TIMER_OVERRUN_SKIP     0   //!< Skip the periods missed, fire once.
+#define ZMOS_TIMER_OVERRUN_ONCE     1   //!< Fire once of each period, the late periods fire tick by tick.
+#define ZMOS_TIMER_OVERRUN_COUNT    2   //!< Skip the periods missed and count them.
+#endif
+#if ZMOS_TIMER_STORE == ZMOS_TIMER_STORE_WHEEL
+/* Timing wheel, 32 slots of each level and 7 levels cover 32 bits */
+#define ZMOS_TIMER_WHEEL_BITS       5
+#define ZMOS_TIMER_WHEEL_SLOTS      32
+#define ZMOS_TIMER_WHEEL_LEVELS     7
+#elif ZMOS_TIMER_STORE != ZMOS_TIMER_STORE_LIST
+#error "ZMOS_TIMER_STORE is unknown!"
+#endif
 /*************************************************************************************************************************
  *                                                      CONSTANTS                                                        *
  *************************************************************************************************************************/
@@ -48,6 +62,39 @@ extern "C"
  * @ref ZMOS timer return cordes.
  */
 typedef uint8_t timerReslt_t;
+/**
+ * ZMOS timer.
+ */
+typedef struct zmos_timer
+{
+    uint32_t timeout;
+    uint32_t reloadTime;
+    zmos_taskHandle_t taskHandle;
+    uTaskEvent_t event;
+    /* Handle and running flags */
+    uint8_t flags;
+    struct zmos_timer *next;
+#if ZMOS_TIMER_STORE != ZMOS_TIMER_STORE_LIST
+    struct zmos_timer *prev;
+    /* Next timer of the task */
+    struct zmos_timer *taskNext;
+#endif
+#if ZMOS_TIMER_STORE == ZMOS_TIMER_STORE_WHEEL
+    /* Index of the wheel slot */
+    uint8_t slot;
+#endif
+#if ZMOS_TIMER_PERIODIC
+    /* Absolute deadline of the next period */
+    uint32_t deadline;
+    /* Periods missed since the last read */
+    uint32_t missed;
+    uint8_t policy;
+#endif
+}zmos_timer_t;
+/**
+ * ZMOS timer handle.
+ */
+typedef zmos_timer_t* zmos_timerHandle_t;
 /*************************************************************************************************************************
  *                                                   PUBLIC FUNCTIONS                                                    *
  *************************************************************************************************************************/
@@ -95,6 +142,27 @@ timerReslt_t zmos_startSingleTimer(zmos_taskHandle_t pTaskHandle, uTaskEvent_t e
 *     null
 *****************************************************************/
 timerReslt_t zmos_startReloadTimer(zmos_taskHandle_t pTaskHandle, uTaskEvent_t event, uint32_t timeout);
+#if ZMOS_TIMER_PERIODIC
+/*****************************************************************
+* FUNCTION: zmos_startPeriodicTimer
+*
+* DESCRIPTION:
+*     This function is called to start a periodic timer, it fires
+*     at the absolute deadlines of the period.
+* INPUTS:
+*     pTaskHandle : Which task to set event.
+*     event : What event to set.
+*     period : Timer period.
+*     policy : The overrun policy(ZMOS_TIMER_OVERRUN_xxx).
+* RETURNS:
+*     0 : success (ZMOS_TIMER_SUCCESS).
+* NOTE:
+*     The lateness of the update does not drift the deadlines, a
+*     deadline passed by the update is an overrun handled by the
+*     policy.
+*****************************************************************/
+timerReslt_t zmos_startPeriodicTimer(zmos_taskHandle_t pTaskHandle, uTaskEvent_t event, uint32_t period, uint8_t policy);
+#endif
 /*****************************************************************
 * FUNCTION: zmos_stopTimer
 *
@@ -137,6 +205,140 @@ uint32_t zmos_getCurrentTimeout(zmos_taskHandle_t pTaskHandle, uTaskEvent_t even
 *     null
 *****************************************************************/
 uint32_t zmos_getReloadTimeout(zmos_taskHandle_t pTaskHandle, uTaskEvent_t event);
+#if ZMOS_TIMER_PERIODIC
+/*****************************************************************
+* FUNCTION: zmos_getTimerMissedCount
+*
+* DESCRIPTION:
+*     Get the number of the periods missed of a periodic timer.
+* INPUTS:
+*     pTaskHandle : task handle of timer to check.
+*     event : task event of timer to check.
+* RETURNS:
+*     The periods missed since the last read.
+* NOTE:
+*     The count is cleared by the read, only the timer of
+*     ZMOS_TIMER_OVERRUN_COUNT counts.
+*****************************************************************/
+uint32_t zmos_getTimerMissedCount(zmos_taskHandle_t pTaskHandle, uTaskEvent_t event);
+#endif
+/*****************************************************************
+* FUNCTION: zmos_timerCreate
+*
+* DESCRIPTION:
+*     This function is called to create a timer handle of the
+*     task event, the timer is stopped.
+* INPUTS:
+*     pTaskHandle : Which task to set event.
+*     event : What event to set.
+* RETURNS:
+*     The timer handle.
+*     NULL : No memory or the timer already has a handle.
+* NOTE:
+*     The running timer of the event is taken by the handle. The
+*     timer is kept until zmos_timerDelete.
+*****************************************************************/
+zmos_timerHandle_t zmos_timerCreate(zmos_taskHandle_t pTaskHandle, uTaskEvent_t event);
+/*****************************************************************
+* FUNCTION: zmos_timerDelete
+*
+* DESCRIPTION:
+*     This function is called to stop and delete a timer handle.
+* INPUTS:
+*     hTimer : The timer handle.
+* RETURNS:
+*     0 : success (ZMOS_TIMER_SUCCESS).
+* NOTE:
+*     The handle is invalid after the delete.
+*****************************************************************/
+timerReslt_t zmos_timerDelete(zmos_timerHandle_t hTimer);
+/*****************************************************************
+* FUNCTION: zmos_timerStart
+*
+* DESCRIPTION:
+*     This function is called to start or restart a timer.
+* INPUTS:
+*     hTimer : The timer handle.
+*     timeout : Timer timeout.
+*     reloadTime : Timer reload time, 0 : single timer.
+* RETURNS:
+*     0 : success (ZMOS_TIMER_SUCCESS).
+* NOTE:
+*     The timer of a task unregistered can't be started, the list
+*     store doesn't remove the timers of the task.
+*****************************************************************/
+timerReslt_t zmos_timerStart(zmos_timerHandle_t hTimer, uint32_t timeout, uint32_t reloadTime);
+#if ZMOS_TIMER_PERIODIC
+/*****************************************************************
+* FUNCTION: zmos_timerStartPeriodic
+*
+* DESCRIPTION:
+*     This function is called to start a timer as periodic timer.
+* INPUTS:
+*     hTimer : The timer handle.
+*     period : Timer period.
+*     policy : The overrun policy(ZMOS_TIMER_OVERRUN_xxx).
+* RETURNS:
+*     0 : success (ZMOS_TIMER_SUCCESS).
+* NOTE:
+*     Same as zmos_startPeriodicTimer.
+*****************************************************************/
+timerReslt_t zmos_timerStartPeriodic(zmos_timerHandle_t hTimer, uint32_t period, uint8_t policy);
+/*****************************************************************
+* FUNCTION: zmos_timerGetMissedCount
+*
+* DESCRIPTION:
+*     Get the number of the periods missed of a periodic timer.
+* INPUTS:
+*     hTimer : The timer handle.
+* RETURNS:
+*     The periods missed since the last read.
+* NOTE:
+*     Same as zmos_getTimerMissedCount.
+*****************************************************************/
+uint32_t zmos_timerGetMissedCount(zmos_timerHandle_t hTimer);
+#endif
+/*****************************************************************
+* FUNCTION: zmos_timerStop
+*
+* DESCRIPTION:
+*     This function to stop a timer, the handle can be started
+*     again.
+* INPUTS:
+*     hTimer : The timer handle.
+* RETURNS:
+*     0 : success (ZMOS_TIMER_SUCCESS).
+*     other : The timer isn't running.
+* NOTE:
+*     null
+*****************************************************************/
+timerReslt_t zmos_timerStop(zmos_timerHandle_t hTimer);
+/*****************************************************************
+* FUNCTION: zmos_timerGetTimeout
+*
+* DESCRIPTION:
+*     Get the current timeout of a timer.
+* INPUTS:
+*     hTimer : The timer handle.
+* RETURNS:
+*     Return the timer's tick count if running, zero otherwise.
+* NOTE:
+*     null
+*****************************************************************/
+uint32_t zmos_timerGetTimeout(zmos_timerHandle_t hTimer);
+/*****************************************************************
+* FUNCTION: zmos_timerGetReloadTime
+*
+* DESCRIPTION:
+*     Get the reload time of a timer.
+* INPUTS:
+*     hTimer : The timer handle.
+* RETURNS:
+*     Timer reload time, 0 : single timer.
+* NOTE:
+*     null
+*****************************************************************/
+uint32_t zmos_timerGetReloadTime(zmos_timerHandle_t hTimer);
 /*****************************************************************
 * FUNCTION: zmos_getNextLowestTimeout
 *
@@ -177,6 +379,64 @@ void zmos_timeTickUpdate(uint32_t upTime);
 *     null
 *****************************************************************/
 uint32_t zmos_getTimerClock(void);
+#if ZMOS_USE_TIME_US
+/*****************************************************************
+* FUNCTION: zmos_timeNowUs
+*
+* DESCRIPTION:
+*     Get the monotonic time in microseconds.
+* INPUTS:
+*     null
+* RETURNS:
+*     The time in microseconds.
+* NOTE:
+*     The 32-bit count of bsp_getUsCount is extended to 64 bits,
+*     it must be read once in 35 minutes, the main loop reads it
+*     at each run. A count earlier than the last is taken as the
+*     last.
+*****************************************************************/
+uint64_t zmos_timeNowUs(void);
+#endif
+/*****************************************************************
+* FUNCTION: zmos_getTimerPoolUsed
+*
+* DESCRIPTION:
+*     Get the number of the timers used in the timer pool.
+* INPUTS:
+*     null
+* RETURNS:
+*     The timers used.
+* NOTE:
+*     If ZMOS_TIMER_POOL_SIZE is 0, It always returns 0.
+*****************************************************************/
+uint32_t zmos_getTimerPoolUsed(void);
+/*****************************************************************
+* FUNCTION: zmos_getTimerPoolMaxUsed
+*
+* DESCRIPTION:
+*     Get the max number of the timers used in the timer pool.
+* INPUTS:
+*     null
+* RETURNS:
+*     The high water of the pool.
+* NOTE:
+*     If ZMOS_TIMER_POOL_SIZE is 0, It always returns 0.
+*****************************************************************/
+uint32_t zmos_getTimerPoolMaxUsed(void);
+/*****************************************************************
+* FUNCTION: zmos_getTimerPoolMissCount
+*
+* DESCRIPTION:
+*     Get the number of the timers allocated from the heap when the
+*     timer pool is full.
+* INPUTS:
+*     null
+* RETURNS:
+*     The number of the heap timers.
+* NOTE:
+*     If ZMOS_TIMER_POOL_SIZE is 0, It always returns 0.
+*****************************************************************/
+uint32_t zmos_getTimerPoolMissCount(void);
 
 
 #ifdef __cplusplus
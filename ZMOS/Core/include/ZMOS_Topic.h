@@ -0,0 +1,111 @@
+/*****************************************************************
+* Copyright (C) 2026 zm. All rights reserved.                    *
+******************************************************************
+* ZMOS_Topic.h
+*
+* DESCRIPTION:
+*     ZMOS topic publish/subscribe.
+* AUTHOR:
+*     zm
+* CREATED DATE:
+*     2026/10/17
+* REVISION:
+*     v0.1
+*
+* MODIFICATION HISTORY
+* --------------------
+* $Log:$
+*
+*****************************************************************/
+#ifndef __ZMOS_TOPIC_H__
+#define __ZMOS_TOPIC_H__
+ 
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+/*************************************************************************************************************************
+ *                                                       INCLUDES                                                        *
+ *************************************************************************************************************************/
+#include "ZMOS_Tasks.h"
+/*************************************************************************************************************************
+ *                                                        MACROS                                                         *
+ *************************************************************************************************************************/
+ 
+/*************************************************************************************************************************
+ *                                                      CONSTANTS                                                        *
+ *************************************************************************************************************************/
+ 
+/*************************************************************************************************************************
+ *                                                       TYPEDEFS                                                        *
+ *************************************************************************************************************************/
+/**
+ * ZMOS topic id.
+ */
+typedef uint8_t topicId_t;
+/**
+ * ZMOS topic subscriber, the event set to the task when the
+ * subscribed topics are published.
+ */
+typedef struct
+{
+    zmos_taskHandle_t taskHandle;
+    uTaskEvent_t event;
+}zmos_topicSubscriber_t;
+/*************************************************************************************************************************
+ *                                                   PUBLIC FUNCTIONS                                                    *
+ *************************************************************************************************************************/
+/*****************************************************************
+* FUNCTION: zmos_subscribe
+*
+* DESCRIPTION:
+*     This function to subscribe the task event to the topic.
+* INPUTS:
+*     pTaskHandle : The handle of the task, NULL is the current task.
+*     topic : The topic id(0 ~ ZMOS_TOPIC_NUM - 1).
+*     event : The event set to the task when the topic is published.
+* RETURNS:
+*     0 : Success (ZMOS_TASK_SUCCESS).
+*     other : ref ZMOS task return cordes.
+* NOTE:
+*     The same task and event subscribed to many topics takes one
+*     subscriber. Return ZMOS_TASK_FAILD when the subscribers are
+*     more than ZMOS_TOPIC_SUBSCRIBER_MAX.
+*****************************************************************/
+taskReslt_t zmos_subscribe(zmos_taskHandle_t pTaskHandle, topicId_t topic, uTaskEvent_t event);
+/*****************************************************************
+* FUNCTION: zmos_unsubscribe
+*
+* DESCRIPTION:
+*     This function to unsubscribe the task from the topic.
+* INPUTS:
+*     pTaskHandle : The handle of the task, NULL is the current task.
+*     topic : The topic id(0 ~ ZMOS_TOPIC_NUM - 1).
+* RETURNS:
+*     0 : Success (ZMOS_TASK_SUCCESS).
+*     other : ref ZMOS task return cordes.
+* NOTE:
+*     The unregistered task is unsubscribed from all topics.
+*****************************************************************/
+taskReslt_t zmos_unsubscribe(zmos_taskHandle_t pTaskHandle, topicId_t topic);
+/*****************************************************************
+* FUNCTION: zmos_publish
+*
+* DESCRIPTION:
+*     This function to publish the topic, the subscribed event
+*     is set to all subscribers.
+* INPUTS:
+*     topic : The topic id(0 ~ ZMOS_TOPIC_NUM - 1).
+* RETURNS:
+*     0 : Success (ZMOS_TASK_SUCCESS).
+*     other : ref ZMOS task return cordes.
+* NOTE:
+*     All subscribers are set in one critical section, it can be
+*     called in the interrupt.
+*****************************************************************/
+taskReslt_t zmos_publish(topicId_t topic);
+
+#ifdef __cplusplus
+}
+#endif
+#endif /* ZMOS_Topic.h */
@@ -0,0 +1,172 @@
+/*****************************************************************
+* Copyright (C) 2026 zm. All rights reserved.                    *
+******************************************************************
+* ZMOS_Trace.h
+*
+* DESCRIPTION:
+*     ZMOS binary trace recorder.
+* AUTHOR:
+*     zm
+* CREATED DATE:
+*     2026/10/17
+* REVISION:
+*     v0.1
+*
+* MODIFICATION HISTORY
+* --------------------
+* $Log:$
+*
+*****************************************************************/
+#ifndef __ZMOS_TRACE_H__
+#define __ZMOS_TRACE_H__
+ 
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+/*************************************************************************************************************************
+ *                                                       INCLUDES                                                        *
+ *************************************************************************************************************************/
+#include "ZMOS_Types.h"
+/*************************************************************************************************************************
+ *                                                        MACROS                                                         *
+ *************************************************************************************************************************/
+/**
+ * ZMOS trace point, compiled out when the trace is disabled.
+ *
+ * @param type : ref ZMOS trace record types.
+ * @param id : Task handle, memory address or user id.
+ * @param value : Events, size or user value.
+ * @param param : Timeout or other param.
+ */
+#if ZMOS_TRACE
+#define ZMOS_TRACE_POINT(type, id, value, param)    \
+    zmos_traceRecord((type), (uint32_t)(zm_uintptr_t)(id), (uint32_t)(value), (uint32_t)(zm_uintptr_t)(param))
+#else
+#define ZMOS_TRACE_POINT(type, id, value, param)    ((void)0)
+#endif
+/**
+ * ZMOS user trace mark.
+ */
+#define ZMOS_TRACE_USER(id, value)                  ZMOS_TRACE_POINT(ZMOS_TRACE_USER_MARK, (id), (value), 0)
+/*************************************************************************************************************************
+ *                                                      CONSTANTS                                                        *
+ *************************************************************************************************************************/
+/**
+ * The magic of the trace buffer("ZMTR").
+ */
+#define ZMOS_TRACE_MAGIC                0x52544D5AUL
+/**
+ * ZMOS trace record types.
+ *
+ *                                  id          value       param
+ */
+#define ZMOS_TRACE_DISPATCH_BEGIN       0x01    /* task        events      null        */
+#define ZMOS_TRACE_DISPATCH_END         0x02    /* task        returned    null        */
+#define ZMOS_TRACE_EVENT_SET            0x03    /* task        events      null        */
+#define ZMOS_TRACE_EVENT_CLEAR          0x04    /* task        events      null        */
+#define ZMOS_TRACE_TIMER_START          0x10    /* task        event       timeout     */
+#define ZMOS_TRACE_TIMER_STOP           0x11    /* task        event       null        */
+#define ZMOS_TRACE_TIMER_EXPIRE         0x12    /* task        event       reload      */
+#define ZMOS_TRACE_MALLOC               0x20    /* address     size        null        */
+#define ZMOS_TRACE_FREE                 0x21    /* address     size        null        */
+#define ZMOS_TRACE_REALLOC              0x22    /* address     size        old address */
+#define ZMOS_TRACE_LPM_ENTER            0x30    /* null        timeout     null        */
+#define ZMOS_TRACE_LPM_EXIT             0x31    /* null        null        null        */
+#define ZMOS_TRACE_USER_MARK            0x80    /* user        user        null        */
+/*************************************************************************************************************************
+ *                                                       TYPEDEFS                                                        *
+ *************************************************************************************************************************/
+/**
+ * ZMOS trace record, little-endian as the MCU.
+ */
+typedef struct
+{
+    uint8_t type;
+    uint8_t reserved[3];
+    /* Time of bsp_getCycleCount */
+    uint32_t time;
+    /* Low 32 bits of the pointer on the 64-bit host */
+    uint32_t id;
+    uint32_t value;
+    uint32_t param;
+}zmos_traceRecord_t;
+/**
+ * ZMOS trace buffer, dumped as a whole for the converter.
+ */
+typedef struct
+{
+    uint32_t magic;
+    uint16_t recordSize;
+    uint16_t recordNum;
+    /* Number of records written, the next record is at (index % recordNum) */
+    uint32_t index;
+    /* Frequency of the time in Hz, 0 is unknown */
+    uint32_t cycleFreq;
+    zmos_traceRecord_t records[ZMOS_TRACE_BUFFER_SIZE];
+}zmos_traceBuffer_t;
+/*************************************************************************************************************************
+ *                                                   PUBLIC FUNCTIONS                                                    *
+ *************************************************************************************************************************/
+/*****************************************************************
+* FUNCTION: zmos_traceRecord
+*
+* DESCRIPTION:
+*     This function to write a record to the trace buffer.
+* INPUTS:
+*     type : ref ZMOS trace record types.
+*     id : Task handle, memory address or user id.
+*     value : Events, size or user value.
+*     param : Timeout or other param.
+* RETURNS:
+*     null
+* NOTE:
+*     Use ZMOS_TRACE_POINT or ZMOS_TRACE_USER instead.
+*****************************************************************/
+void zmos_traceRecord(uint8_t type, uint32_t id, uint32_t value, uint32_t param);
+/*****************************************************************
+* FUNCTION: zmos_traceEnable
+*
+* DESCRIPTION:
+*     This function to start or stop the trace recording.
+* INPUTS:
+*     enable : 1 is start, 0 is stop.
+* RETURNS:
+*     null
+* NOTE:
+*     The trace starts after zmos_system_init, stop it to keep
+*     the records of a fault.
+*****************************************************************/
+void zmos_traceEnable(uint8_t enable);
+/*****************************************************************
+* FUNCTION: zmos_traceReset
+*
+* DESCRIPTION:
+*     This function to discard all records of the trace buffer.
+* INPUTS:
+*     null
+* RETURNS:
+*     null
+* NOTE:
+*     null
+*****************************************************************/
+void zmos_traceReset(void);
+/*****************************************************************
+* FUNCTION: zmos_traceGetBuffer
+*
+* DESCRIPTION:
+*     This function to get the trace buffer to dump.
+* INPUTS:
+*     pSize : Return the size of the buffer in bytes.
+* RETURNS:
+*     The trace buffer, NULL if the trace is disabled.
+* NOTE:
+*     Stop the trace before dumping, the converter reads the
+*     buffer(zmos_traceBuffer_t) as a binary file.
+*****************************************************************/
+const void *zmos_traceGetBuffer(zm_size_t *pSize);
+
+#ifdef __cplusplus
+}
+#endif
+#endif /* ZMOS_Trace.h */
@@ -55,6 +55,9 @@ typedef unsigned short uint16_t;    //!< Unsigned 16 bit integer
 typedef signed int int32_t;         //!< Signed 32 bit integer
 typedef unsigned int uint32_t;      //!< Unsigned 32 bit integer
 
+typedef signed long long int64_t;   //!< Signed 64 bit integer
+typedef unsigned long long uint64_t;//!< Unsigned 64 bit integer
+
 typedef unsigned char bool;         //!< Boolean data type
 
 #endif
@@ -70,6 +73,12 @@ typedef uint32_t    zm_uint32_t;
 
 typedef zm_uint32_t zm_size_t;
 
+#if ZMOS_TYPES_USE_CLIB
+typedef uintptr_t   zm_uintptr_t;
+#else
+typedef unsigned long zm_uintptr_t;
+#endif
+
 /**
  * Task event types.
  */
@@ -0,0 +1,226 @@
+/*****************************************************************
+* Copyright (C) 2026 zm. All rights reserved.                    *
+******************************************************************
+* zmos_timer_bench.c
+*
+* DESCRIPTION:
+*     Host benchmark of the ZMOS timer store, it times the start,
+*     the update, the next timeout and the stop with 10, 100 and
+*     10000 reload timers of random periods.
+* AUTHOR:
+*     zm
+* CREATED DATE:
+*     2026/10/17
+* REVISION:
+*     v0.1
+*
+* USAGE:
+*     Build with a timer store from ZMOS/:
+*         gcc -O2 -std=gnu11 -D'__weak=__attribute__((weak))' \
+*             -DZMOS_USE_MEM_MGR=0 -DZMOS_INIT_SECTION=0 -DZMOS_TASK_CONTEXT=1 \
+*             -DZMOS_TIMER_STORE=ZMOS_TIMER_STORE_WHEEL \
+*             -ICore/include -IBsp/include \
+*             Core/Src/ZMOS*.c Bsp/posix/bsp*.c Tools/zmos_timer_bench.c \
+*             -lpthread -o timer_bench_wheel
+*     Build ZMOS_TIMER_STORE_LIST the same, then run them.
+*****************************************************************/
+ 
+/*************************************************************************************************************************
+ *                                                       INCLUDES                                                        *
+ *************************************************************************************************************************/
+#include <stdio.h>
+#include <time.h>
+#include "ZMOS.h"
+/*************************************************************************************************************************
+ *                                                        MACROS                                                         *
+ *************************************************************************************************************************/
+#if !ZMOS_TASK_CONTEXT
+#error "The bench needs ZMOS_TASK_CONTEXT!"
+#endif
+#define BENCH_EVENT_NUM             (sizeof(uTaskEvent_t) * 8)
+#define BENCH_TIMER_MAX             10000
+#define BENCH_TASK_MAX              ((BENCH_TIMER_MAX + BENCH_EVENT_NUM - 1) / BENCH_EVENT_NUM)
+/* Updates of 1ms timed of each test */
+#define BENCH_TICK_NUM              2000
+/* Periods of the timers are 1 ~ BENCH_PERIOD_MAX ms */
+#define BENCH_PERIOD_MAX            1000
+#if ZMOS_TIMER_STORE == ZMOS_TIMER_STORE_WHEEL
+#define BENCH_STORE_NAME            "timing wheel"
+#else
+#define BENCH_STORE_NAME            "unsorted list"
+#endif
+/*************************************************************************************************************************
+ *                                                      CONSTANTS                                                        *
+ *************************************************************************************************************************/
+static const uint32_t benchTimerNum[] = {10, 100, 10000};
+/*************************************************************************************************************************
+ *                                                       TYPEDEFS                                                        *
+ *************************************************************************************************************************/
+ 
+/*************************************************************************************************************************
+ *                                                   GLOBAL VARIABLES                                                    *
+ *************************************************************************************************************************/
+ 
+/*************************************************************************************************************************
+ *                                                  EXTERNAL VARIABLES                                                   *
+ *************************************************************************************************************************/
+ 
+/*************************************************************************************************************************
+ *                                                    LOCAL VARIABLES                                                    *
+ *************************************************************************************************************************/
+static zmos_taskHandle_t benchTasks[BENCH_TASK_MAX];
+static uint32_t benchSeed = 1;
+/*************************************************************************************************************************
+ *                                                 FUNCTION DECLARATIONS                                                 *
+ *************************************************************************************************************************/
+static uTaskEvent_t bench_task(void *context, uTaskEvent_t events);
+static uint32_t bench_random(void);
+static uint64_t bench_nowNs(void);
+static void bench_run(uint32_t timerNum);
+/*************************************************************************************************************************
+ *                                                   PUBLIC FUNCTIONS                                                    *
+ *************************************************************************************************************************/
+/*****************************************************************
+* FUNCTION: main
+*
+* DESCRIPTION:
+*     Run the benchmark of each number of timers.
+* INPUTS:
+*     null
+* RETURNS:
+*     0
+* NOTE:
+*     null
+*****************************************************************/
+int main(void)
+{
+    zmos_system_init();
+    for(uint32_t i = 0; i < BENCH_TASK_MAX; i++)
+    {
+        zmos_taskThreadRegisterContext(&benchTasks[i], bench_task, NULL, ZMOS_TASK_PRIORITY_DEFAULT);
+    }
+    printf("ZMOS timer store: %s\n", BENCH_STORE_NAME);
+    printf("%8s %12s %12s %12s %12s\n", "timers", "start(ns)", "update(ns)", "next(ns)", "stop(ns)");
+    for(uint32_t i = 0; i < sizeof(benchTimerNum) / sizeof(benchTimerNum[0]); i++)
+    {
+        bench_run(benchTimerNum[i]);
+    }
+    return 0;
+}
+/*************************************************************************************************************************
+ *                                                    LOCAL FUNCTIONS                                                    *
+ *************************************************************************************************************************/
+/*****************************************************************
+* FUNCTION: bench_task
+*
+* DESCRIPTION:
+*     The tasks of the timers, never run.
+* INPUTS:
+*     context : null.
+*     events : Task events.
+* RETURNS:
+*     0
+* NOTE:
+*     null
+*****************************************************************/
+static uTaskEvent_t bench_task(void *context, uTaskEvent_t events)
+{
+    (void)context;
+    (void)events;
+    return 0;
+}
+/*****************************************************************
+* FUNCTION: bench_random
+*
+* DESCRIPTION:
+*     Linear congruential random number, the same sequence of each build.
+* INPUTS:
+*     null
+* RETURNS:
+*     Random number.
+* NOTE:
+*     null
+*****************************************************************/
+static uint32_t bench_random(void)
+{
+    benchSeed = benchSeed * 1103515245 + 12345;
+    return benchSeed >> 8;
+}
+/*****************************************************************
+* FUNCTION: bench_nowNs
+*
+* DESCRIPTION:
+*     Get the monotonic time.
+* INPUTS:
+*     null
+* RETURNS:
+*     Time in ns.
+* NOTE:
+*     null
+*****************************************************************/
+static uint64_t bench_nowNs(void)
+{
+    struct timespec ts;
+    
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+/*****************************************************************
+* FUNCTION: bench_run
+*
+* DESCRIPTION:
+*     Time the timer operations with a number of timers.
+* INPUTS:
+*     timerNum : Number of reload timers.
+* RETURNS:
+*     null
+* NOTE:
+*     The update advances 1ms, the ns of the update is the average
+*     of BENCH_TICK_NUM updates with the expiries.
+*****************************************************************/
+static void bench_run(uint32_t timerNum)
+{
+    uint64_t start;
+    uint64_t startNs;
+    uint64_t updateNs;
+    uint64_t nextNs;
+    uint64_t stopNs;
+    volatile uint32_t next = 0;
+    
+    benchSeed = 1;
+    start = bench_nowNs();
+    for(uint32_t i = 0; i < timerNum; i++)
+    {
+        zmos_startReloadTimer(benchTasks[i / BENCH_EVENT_NUM], (uTaskEvent_t)1 << (i % BENCH_EVENT_NUM),
+                              bench_random() % BENCH_PERIOD_MAX + 1);
+    }
+    startNs = bench_nowNs() - start;
+    
+    start = bench_nowNs();
+    for(uint32_t i = 0; i < BENCH_TICK_NUM; i++)
+    {
+        zmos_timeTickUpdate(1);
+    }
+    updateNs = bench_nowNs() - start;
+    
+    start = bench_nowNs();
+    for(uint32_t i = 0; i < BENCH_TICK_NUM; i++)
+    {
+        next += zmos_getNextLowestTimeout();
+    }
+    nextNs = bench_nowNs() - start;
+    
+    start = bench_nowNs();
+    for(uint32_t i = 0; i < timerNum; i++)
+    {
+        zmos_stopTimer(benchTasks[i / BENCH_EVENT_NUM], (uTaskEvent_t)1 << (i % BENCH_EVENT_NUM));
+    }
+    stopNs = bench_nowNs() - start;
+    //Free the stopped timers.
+    zmos_timeTickUpdate(0);
+    
+    printf("%8u %12.1f %12.1f %12.1f %12.1f\n", timerNum,
+           (double)startNs / timerNum, (double)updateNs / BENCH_TICK_NUM,
+           (double)nextNs / BENCH_TICK_NUM, (double)stopNs / timerNum);
+}
+/****************************************************** END OF FILE ******************************************************/
@@ -0,0 +1,251 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+#****************************************************************
+# Copyright (C) 2026 zm. All rights reserved.                   *
+#****************************************************************
+# zmos_trace.py
+#
+# DESCRIPTION:
+#     Convert the ZMOS trace buffer(zmos_traceBuffer_t) dumped as a
+#     binary file to the Chrome trace JSON, which is opened by
+#     chrome://tracing or https://ui.perfetto.dev.
+# AUTHOR:
+#     zm
+# CREATED DATE:
+#     2026/10/17
+# REVISION:
+#     v0.1
+#
+# USAGE:
+#     Dump the buffer returned by zmos_traceGetBuffer, such as by gdb:
+#         dump binary value trace.bin zmosDefaultKernel.traceBuffer
+#     Then convert it:
+#         python3 zmos_trace.py trace.bin -o trace.json --freq 72000000 \
+#                 --name 0x20000130=sensor --name 0x20000158=radio
+#     Print the records as text:
+#         python3 zmos_trace.py trace.bin --text
+#****************************************************************
+import argparse
+import json
+import struct
+import sys
+
+ZMOS_TRACE_MAGIC = 0x52544D5A
+
+HEADER = struct.Struct('<IHHII')
+RECORD = struct.Struct('<B3xIIII')
+
+DISPATCH_BEGIN = 0x01
+DISPATCH_END = 0x02
+EVENT_SET = 0x03
+EVENT_CLEAR = 0x04
+TIMER_START = 0x10
+TIMER_STOP = 0x11
+TIMER_EXPIRE = 0x12
+MALLOC = 0x20
+FREE = 0x21
+REALLOC = 0x22
+LPM_ENTER = 0x30
+LPM_EXIT = 0x31
+USER_MARK = 0x80
+
+TYPE_NAMES = {
+    DISPATCH_BEGIN: 'dispatch begin',
+    DISPATCH_END: 'dispatch end',
+    EVENT_SET: 'event set',
+    EVENT_CLEAR: 'event clear',
+    TIMER_START: 'timer start',
+    TIMER_STOP: 'timer stop',
+    TIMER_EXPIRE: 'timer expire',
+    MALLOC: 'malloc',
+    FREE: 'free',
+    REALLOC: 'realloc',
+    LPM_ENTER: 'lpm enter',
+    LPM_EXIT: 'lpm exit',
+    USER_MARK: 'user',
+}
+
+# Process and thread ids of the trace viewer
+PID_TASKS = 1
+PID_SYSTEM = 2
+TID_TIMERS = 1
+TID_MEMORY = 2
+TID_LOW_POWER = 3
+TID_USER = 4
+
+
+def read_records(data):
+    """Return (cycle frequency, records in time order) of the buffer."""
+    if len(data) < HEADER.size:
+        raise ValueError('file too short')
+    magic, record_size, record_num, index, freq = HEADER.unpack_from(data, 0)
+    if magic != ZMOS_TRACE_MAGIC:
+        raise ValueError('bad magic 0x%08X, not a ZMOS trace buffer' % magic)
+    if record_size != RECORD.size:
+        raise ValueError('record size %d is not supported' % record_size)
+    if len(data) < HEADER.size + record_size * record_num:
+        raise ValueError('file too short for %d records' % record_num)
+
+    if index <= record_num:
+        order = range(index)
+    else:
+        start = index % record_num
+        order = [(start + i) % record_num for i in range(record_num)]
+
+    records = []
+    for i in order:
+        records.append(RECORD.unpack_from(data, HEADER.size + i * record_size))
+    return freq, records
+
+
+def unwrap_time(records, freq):
+    """Return the microseconds of the records, the 32-bit cycles may wrap.
+
+    A small step back is a record reordered, not a wrap.
+    """
+    times = []
+    total = 0
+    prev = None
+    for rec in records:
+        if prev is not None:
+            delta = (rec[1] - prev) & 0xFFFFFFFF
+            if delta & 0x80000000:
+                delta -= 0x100000000
+            total += delta
+        prev = rec[1]
+        times.append(total * 1000000.0 / freq)
+    low = min(times) if times else 0
+    return [t - low for t in times]
+
+
+def to_chrome(records, times, names):
+    def task_name(task):
+        return names.get(task, 'task 0x%08X' % task)
+
+    events = []
+    tasks = set()
+    running = set()
+    sleeping = False
+    heap_used = 0
+    blocks = {}
+
+    for rec, ts in zip(records, times):
+        rtype, _, rid, value, param = rec
+        if rtype in (DISPATCH_BEGIN, DISPATCH_END, EVENT_SET, EVENT_CLEAR):
+            tasks.add(rid)
+
+        if rtype == DISPATCH_BEGIN:
+            running.add(rid)
+            events.append({'name': task_name(rid), 'ph': 'B', 'pid': PID_TASKS, 'tid': rid, 'ts': ts,
+                           'args': {'events': '0x%X' % value}})
+        elif rtype == DISPATCH_END:
+            # The begin may have been overwritten
+            if rid in running:
+                running.discard(rid)
+                events.append({'ph': 'E', 'pid': PID_TASKS, 'tid': rid, 'ts': ts,
+                               'args': {'unprocessed': '0x%X' % value}})
+        elif rtype in (EVENT_SET, EVENT_CLEAR):
+            events.append({'name': '%s 0x%X' % (TYPE_NAMES[rtype], value), 'ph': 'i', 's': 't',
+                           'pid': PID_TASKS, 'tid': rid, 'ts': ts})
+        elif rtype in (TIMER_START, TIMER_STOP, TIMER_EXPIRE):
+            args = {'task': task_name(rid), 'event': '0x%X' % value}
+            if rtype == TIMER_START:
+                args['timeout'] = param
+            elif rtype == TIMER_EXPIRE:
+                args['reload'] = param
+            events.append({'name': TYPE_NAMES[rtype], 'ph': 'i', 's': 't', 'pid': PID_SYSTEM,
+                           'tid': TID_TIMERS, 'ts': ts, 'args': args})
+        elif rtype in (MALLOC, FREE, REALLOC):
+            args = {'address': '0x%08X' % rid, 'size': value}
+            if rtype == MALLOC:
+                if rid:
+                    blocks[rid] = value
+                    heap_used += value
+            elif rtype == FREE:
+                heap_used -= blocks.pop(rid, 0)
+            else:
+                args['old address'] = '0x%08X' % param
+                heap_used -= blocks.pop(param, 0)
+                if rid:
+                    blocks[rid] = value
+                    heap_used += value
+            events.append({'name': TYPE_NAMES[rtype], 'ph': 'i', 's': 't', 'pid': PID_SYSTEM,
+                           'tid': TID_MEMORY, 'ts': ts, 'args': args})
+            events.append({'name': 'heap used', 'ph': 'C', 'pid': PID_SYSTEM, 'ts': ts,
+                           'args': {'bytes': heap_used}})
+        elif rtype == LPM_ENTER:
+            sleeping = True
+            events.append({'name': 'sleep', 'ph': 'B', 'pid': PID_SYSTEM, 'tid': TID_LOW_POWER, 'ts': ts,
+                           'args': {'timeout': value}})
+        elif rtype == LPM_EXIT:
+            if sleeping:
+                sleeping = False
+                events.append({'ph': 'E', 'pid': PID_SYSTEM, 'tid': TID_LOW_POWER, 'ts': ts})
+        else:
+            events.append({'name': 'user 0x%X' % rid, 'ph': 'i', 's': 't', 'pid': PID_SYSTEM,
+                           'tid': TID_USER, 'ts': ts, 'args': {'type': rtype, 'value': value}})
+
+    meta = [
+        {'name': 'process_name', 'ph': 'M', 'pid': PID_TASKS, 'args': {'name': 'ZMOS tasks'}},
+        {'name': 'process_name', 'ph': 'M', 'pid': PID_SYSTEM, 'args': {'name': 'ZMOS system'}},
+        {'name': 'thread_name', 'ph': 'M', 'pid': PID_SYSTEM, 'tid': TID_TIMERS, 'args': {'name': 'timers'}},
+        {'name': 'thread_name', 'ph': 'M', 'pid': PID_SYSTEM, 'tid': TID_MEMORY, 'args': {'name': 'memory'}},
+        {'name': 'thread_name', 'ph': 'M', 'pid': PID_SYSTEM, 'tid': TID_LOW_POWER, 'args': {'name': 'low power'}},
+        {'name': 'thread_name', 'ph': 'M', 'pid': PID_SYSTEM, 'tid': TID_USER, 'args': {'name': 'user'}},
+    ]
+    for task in sorted(tasks):
+        meta.append({'name': 'thread_name', 'ph': 'M', 'pid': PID_TASKS, 'tid': task,
+                     'args': {'name': task_name(task)}})
+    return {'traceEvents': meta + events, 'displayTimeUnit': 'ns'}
+
+
+def to_text(records, times, out):
+    for rec, ts in zip(records, times):
+        rtype, cycle, rid, value, param = rec
+        out.write('%14.3f us  %10u  %-14s id=0x%08X value=0x%08X param=0x%08X\n' %
+                  (ts, cycle, TYPE_NAMES.get(rtype, 'type 0x%02X' % rtype), rid, value, param))
+
+
+def parse_name(text):
+    addr, _, name = text.partition('=')
+    if not name:
+        raise argparse.ArgumentTypeError('use ADDRESS=NAME')
+    return int(addr, 0) & 0xFFFFFFFF, name
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Convert a ZMOS trace buffer to Chrome trace JSON.')
+    parser.add_argument('input', help='binary dump of zmos_traceBuffer_t')
+    parser.add_argument('-o', '--output', help='output file, default is stdout')
+    parser.add_argument('--freq', type=float, default=0,
+                        help='frequency of bsp_getCycleCount in Hz, override the buffer(default 1MHz)')
+    parser.add_argument('--name', type=parse_name, action='append', default=[],
+                        help='task name, ADDRESS=NAME')
+    parser.add_argument('--text', action='store_true', help='print the records as text')
+    args = parser.parse_args()
+
+    with open(args.input, 'rb') as f:
+        data = f.read()
+    try:
+        freq, records = read_records(data)
+    except ValueError as e:
+        sys.stderr.write('%s: %s\n' % (args.input, e))
+        return 1
+
+    freq = args.freq or freq or 1000000
+    times = unwrap_time(records, freq)
+    out = open(args.output, 'w') if args.output else sys.stdout
+    try:
+        if args.text:
+            to_text(records, times, out)
+        else:
+            json.dump(to_chrome(records, times, dict(args.name)), out)
+            out.write('\n')
+    finally:
+        if out is not sys.stdout:
+            out.close()
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
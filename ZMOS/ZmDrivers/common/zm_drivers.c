@@ -59,7 +59,14 @@ static zmos_taskHandle_t driverTaskHandle;
 /*************************************************************************************************************************
  *                                                 FUNCTION DECLARATIONS                                                 *
  *************************************************************************************************************************/
-static uTaskEvent_t zmDriverPorcessEvent(uTaskEvent_t events);
+static uTaskEvent_t zmDriverLedBlinkEvent(uTaskEvent_t event);
+static uTaskEvent_t zmDriverKeyPollEvent(uTaskEvent_t event);
+/* Driver event handler table, indexed by event bit */
+static const taskEventHandler_t zmDriverEventTable[] =
+{
+    zmDriverLedBlinkEvent,      /* ZM_DRIVER_LED_BLINK_EVENT */
+    zmDriverKeyPollEvent,       /* ZM_DRIVER_KEY_POLL_EVENT */
+};
 /*************************************************************************************************************************
  *                                                   PUBLIC FUNCTIONS                                                    *
  *************************************************************************************************************************/
@@ -93,7 +100,8 @@ extern void zm_keyPollProcess(void);
 void zmDriverInit(void)
 {
     //Register task in ZMOS
-    zmos_taskThreadRegister(&driverTaskHandle, zmDriverPorcessEvent);
+    zmos_taskThreadRegisterTable(&driverTaskHandle, zmDriverEventTable, 
+                                 ARRAY_SIZE(zmDriverEventTable), ZMOS_TASK_PRIORITY_DEFAULT);
     /* ZM led */
 #if ZM_LED_MAX_NUM > 0
     zm_ledInit();
@@ -104,35 +112,41 @@ void zmDriverInit(void)
 #endif
 }
 /*****************************************************************
-* FUNCTION: zmDriverPorcessEvent
+* FUNCTION: zmDriverLedBlinkEvent
 *
 * DESCRIPTION:
-*     
+*     Handle ZM_DRIVER_LED_BLINK_EVENT.
 * INPUTS:
-*     
+*     event : ZM_DRIVER_LED_BLINK_EVENT.
 * RETURNS:
-*     null
+*     0
 * NOTE:
 *     null
 *****************************************************************/
-static uTaskEvent_t zmDriverPorcessEvent(uTaskEvent_t events)
+static uTaskEvent_t zmDriverLedBlinkEvent(uTaskEvent_t event)
 {
-    
-    if(events & ZM_DRIVER_LED_BLINK_EVENT)
-    {
 #ifdef ZM_LED_BLINK
-        zm_updateLedBlink();
+    zm_updateLedBlink();
 #endif
-        return events ^ ZM_DRIVER_LED_BLINK_EVENT;
-    }
-    
-    if(events & ZM_DRIVER_KEY_POLL_EVENT)
-    {
+    return 0;
+}
+/*****************************************************************
+* FUNCTION: zmDriverKeyPollEvent
+*
+* DESCRIPTION:
+*     Handle ZM_DRIVER_KEY_POLL_EVENT.
+* INPUTS:
+*     event : ZM_DRIVER_KEY_POLL_EVENT.
+* RETURNS:
+*     0
+* NOTE:
+*     null
+*****************************************************************/
+static uTaskEvent_t zmDriverKeyPollEvent(uTaskEvent_t event)
+{
 #if ZM_KEY_MAX_NUM > 0
-        zm_keyPollProcess();
+    zm_keyPollProcess();
 #endif
-        return events ^ ZM_DRIVER_KEY_POLL_EVENT;
-    }
     return 0;
 }
 /*****************************************************************